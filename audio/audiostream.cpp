@@ -24,6 +24,9 @@
 #include "common/mutex.h"
 #include "common/textconsole.h"
 #include "common/queue.h"
+#include "common/singleton.h"
+#include "common/system.h"
+#include "common/timer.h"
 #include "common/util.h"
 
 #include "audio/audiostream.h"
@@ -468,6 +471,297 @@ AudioStream *makeLimitingAudioStream(AudioStream *parentStream, const Timestamp
 	return new LimitingAudioStream(parentStream, length, disposeAfterUse);
 }
 
+#pragma mark -
+#pragma mark --- Decode ahead audio stream ---
+#pragma mark -
+
+class DecodeAheadAudioStreamImpl;
+
+/**
+ * Decodes all DecodeAheadAudioStreams from a single timer callback, since
+ * TimerManager::removeTimerProc() removes every instance of a callback.
+ */
+class DecodeAheadScheduler : public Common::Singleton<DecodeAheadScheduler> {
+public:
+	void addStream(DecodeAheadAudioStreamImpl *stream);
+	void removeStream(DecodeAheadAudioStreamImpl *stream);
+
+private:
+	friend class Common::Singleton<SingletonBaseType>;
+	DecodeAheadScheduler() : _timerInstalled(false), _nextStream(0) {}
+
+	static void timerProc(void *refCon);
+
+	/** Interval of the timer callback, in microseconds. */
+	static const int32 kTimerInterval = 10000;
+
+	/**
+	 * Maximum number of samples decoded per timer callback, for all streams
+	 * together. Other timer callbacks, e.g. MIDI players, cannot run while
+	 * this one is decoding.
+	 */
+	static const uint32 kMaxSamplesPerTick = 16384;
+
+	/** Held while the timer callback is installed or removed. */
+	Common::Mutex _timerMutex;
+
+	/** Held while the stream list is changed, and by the timer callback. */
+	Common::Mutex _streamsMutex;
+
+	Common::Array<DecodeAheadAudioStreamImpl *> _streams;
+	bool _timerInstalled;
+
+	/** Stream which is decoded first in the next timer callback. */
+	uint _nextStream;
+};
+
+} // End of namespace Audio
+
+namespace Common {
+DECLARE_SINGLETON(Audio::DecodeAheadScheduler);
+} // End of namespace Common
+
+namespace Audio {
+
+class DecodeAheadAudioStreamImpl : public DecodeAheadAudioStream {
+public:
+	DecodeAheadAudioStreamImpl(SeekableAudioStream *parentStream, uint32 bufferMs, DisposeAfterUse::Flag disposeAfterUse);
+	~DecodeAheadAudioStreamImpl();
+
+	// Implement the AudioStream API
+	int readBuffer(int16 *buffer, const int numSamples) override;
+	bool isStereo() const override { return _parentStream->isStereo(); }
+	int getRate() const override { return _parentStream->getRate(); }
+	bool endOfData() const override;
+
+	// Implement the SeekableAudioStream API
+	bool seek(const Timestamp &where) override;
+	Timestamp getLength() const override { return _parentStream->getLength(); }
+
+	// Implement the DecodeAheadAudioStream API
+	uint32 getBufferedSamples() const override;
+	uint32 getBufferSize() const override { return _bufferSize; }
+	uint32 getUnderrunCount() const override { return _underruns; }
+
+	/**
+	 * Decode from the parent stream until the buffer is full, but at most
+	 * maxSamples samples. Returns the number of samples decoded.
+	 */
+	uint32 fillBuffer(uint32 maxSamples);
+
+	/**
+	 * Maximum number of samples decoded at once. The decode mutex is released
+	 * in between, so an underrun in readBuffer() never waits for more.
+	 */
+	static const uint32 kDecodeChunkSize = 4096;
+
+private:
+	/** Copy up to numSamples decoded samples out of the buffer. */
+	uint32 readDecoded(int16 *buffer, uint32 numSamples);
+
+	Common::DisposablePtr<SeekableAudioStream> _parentStream;
+
+	Common::Array<int16> _buffer;
+	uint32 _bufferSize;
+	uint32 _bufferRead;
+	uint32 _bufferFill;
+	bool _parentEnded;
+	uint32 _underruns;
+
+	/** Held while the parent stream is used. Always taken before _bufferMutex. */
+	Common::Mutex _decodeMutex;
+
+	/** Guards the read position and fill level of the buffer. */
+	mutable Common::Mutex _bufferMutex;
+};
+
+const uint32 DecodeAheadAudioStreamImpl::kDecodeChunkSize;
+
+void DecodeAheadScheduler::addStream(DecodeAheadAudioStreamImpl *stream) {
+	Common::StackLock timerLock(_timerMutex);
+
+	_streamsMutex.lock();
+	_streams.push_back(stream);
+	_streamsMutex.unlock();
+
+	// Without a timer manager the streams simply decode from readBuffer()
+	Common::TimerManager *timerManager = g_system->getTimerManager();
+	if (!_timerInstalled && timerManager)
+		_timerInstalled = timerManager->installTimerProc(timerProc, kTimerInterval, this, "DecodeAheadScheduler");
+}
+
+void DecodeAheadScheduler::removeStream(DecodeAheadAudioStreamImpl *stream) {
+	Common::StackLock timerLock(_timerMutex);
+
+	// Once it is out of the list, the timer callback does not use the stream anymore
+	_streamsMutex.lock();
+	for (uint i = 0; i < _streams.size(); i++) {
+		if (_streams[i] == stream) {
+			_streams.remove_at(i);
+			break;
+		}
+	}
+	bool empty = _streams.empty();
+	_streamsMutex.unlock();
+
+	// The timer callback takes _streamsMutex, so it must not be held here
+	if (empty && _timerInstalled) {
+		g_system->getTimerManager()->removeTimerProc(timerProc);
+		_timerInstalled = false;
+	}
+}
+
+void DecodeAheadScheduler::timerProc(void *refCon) {
+	DecodeAheadScheduler *scheduler = (DecodeAheadScheduler *)refCon;
+
+	Common::StackLock lock(scheduler->_streamsMutex);
+	const uint numStreams = scheduler->_streams.size();
+	if (!numStreams)
+		return;
+
+	// The streams take turns decoding a chunk, starting with a different one
+	// each time, until they are full or the budget for this tick is used up
+	uint32 budget = kMaxSamplesPerTick;
+	bool decodedAny = true;
+	while (budget && decodedAny) {
+		decodedAny = false;
+		for (uint i = 0; i < numStreams && budget; i++) {
+			DecodeAheadAudioStreamImpl *stream = scheduler->_streams[(scheduler->_nextStream + i) % numStreams];
+			uint32 decoded = stream->fillBuffer(MIN(budget, DecodeAheadAudioStreamImpl::kDecodeChunkSize));
+			budget -= MIN(budget, decoded);
+			decodedAny |= decoded != 0;
+		}
+	}
+	scheduler->_nextStream = (scheduler->_nextStream + 1) % numStreams;
+}
+
+DecodeAheadAudioStreamImpl::DecodeAheadAudioStreamImpl(SeekableAudioStream *parentStream, uint32 bufferMs, DisposeAfterUse::Flag disposeAfterUse) :
+		_parentStream(parentStream, disposeAfterUse), _bufferRead(0), _bufferFill(0), _parentEnded(false), _underruns(0) {
+	const uint32 channels = isStereo() ? 2 : 1;
+	_bufferSize = MAX<uint32>(getRate() * bufferMs / 1000, 256) * channels;
+	_buffer.resize(_bufferSize);
+
+	// Start with a full buffer, nothing is playing yet
+	fillBuffer(_bufferSize);
+
+	DecodeAheadScheduler::instance().addStream(this);
+}
+
+DecodeAheadAudioStreamImpl::~DecodeAheadAudioStreamImpl() {
+	DecodeAheadScheduler::instance().removeStream(this);
+}
+
+uint32 DecodeAheadAudioStreamImpl::fillBuffer(uint32 maxSamples) {
+	const uint32 channels = isStereo() ? 2 : 1;
+	uint32 total = 0;
+
+	while (total < maxSamples) {
+		Common::StackLock decodeLock(_decodeMutex);
+		if (_parentEnded)
+			break;
+
+		_bufferMutex.lock();
+		uint32 space = _bufferSize - _bufferFill;
+		uint32 write = (_bufferRead + _bufferFill) % _bufferSize;
+		_bufferMutex.unlock();
+
+		// Only this function writes to the buffer, and only to its free part,
+		// so decoding does not block readDecoded()
+		uint32 count = MIN(MIN(space, _bufferSize - write), MIN(maxSamples - total, kDecodeChunkSize));
+		count -= count % channels;
+		if (!count)
+			break;
+
+		int decoded = _parentStream->readBuffer(&_buffer[write], count);
+		if (decoded < 0)
+			decoded = 0;
+
+		_bufferMutex.lock();
+		_bufferFill += decoded;
+		_parentEnded = (uint32)decoded < count || _parentStream->endOfData();
+		_bufferMutex.unlock();
+
+		total += decoded;
+	}
+
+	return total;
+}
+
+uint32 DecodeAheadAudioStreamImpl::readDecoded(int16 *buffer, uint32 numSamples) {
+	_bufferMutex.lock();
+	uint32 read = _bufferRead;
+	uint32 count = MIN(numSamples, _bufferFill);
+	_bufferMutex.unlock();
+
+	uint32 first = MIN(count, _bufferSize - read);
+	if (first)
+		memcpy(buffer, &_buffer[read], first * sizeof(int16));
+	if (count > first)
+		memcpy(buffer + first, &_buffer[0], (count - first) * sizeof(int16));
+
+	_bufferMutex.lock();
+	_bufferRead = (read + count) % _bufferSize;
+	_bufferFill -= count;
+	_bufferMutex.unlock();
+
+	return count;
+}
+
+int DecodeAheadAudioStreamImpl::readBuffer(int16 *buffer, const int numSamples) {
+	uint32 samples = readDecoded(buffer, numSamples);
+	if (samples == (uint32)numSamples)
+		return numSamples;
+
+	// If the timer callback is decoding, this waits for at most one chunk
+	Common::StackLock decodeLock(_decodeMutex);
+
+	// The timer callback may have decoded more while we were waiting
+	samples += readDecoded(buffer + samples, numSamples - samples);
+
+	// Decoding fell behind playback, decode the rest right here
+	if (samples < (uint32)numSamples && !_parentEnded) {
+		++_underruns;
+
+		uint32 count = numSamples - samples;
+		int decoded = _parentStream->readBuffer(buffer + samples, count);
+		if (decoded < 0)
+			decoded = 0;
+		samples += decoded;
+
+		Common::StackLock bufferLock(_bufferMutex);
+		_parentEnded = (uint32)decoded < count || _parentStream->endOfData();
+	}
+
+	return samples;
+}
+
+bool DecodeAheadAudioStreamImpl::endOfData() const {
+	Common::StackLock lock(_bufferMutex);
+	return _bufferFill == 0 && _parentEnded;
+}
+
+bool DecodeAheadAudioStreamImpl::seek(const Timestamp &where) {
+	Common::StackLock decodeLock(_decodeMutex);
+
+	_bufferMutex.lock();
+	_bufferRead = 0;
+	_bufferFill = 0;
+	bool result = _parentStream->seek(where);
+	_parentEnded = _parentStream->endOfData();
+	_bufferMutex.unlock();
+
+	return result;
+}
+
+uint32 DecodeAheadAudioStreamImpl::getBufferedSamples() const {
+	Common::StackLock lock(_bufferMutex);
+	return _bufferFill;
+}
+
+DecodeAheadAudioStream *makeDecodeAheadStream(SeekableAudioStream *parentStream, uint32 bufferMs, DisposeAfterUse::Flag disposeAfterUse) {
+	return new DecodeAheadAudioStreamImpl(parentStream, bufferMs, disposeAfterUse);
+}
+
 /**
  * An AudioStream that plays nothing and immediately returns that
  * the endOfStream() has been reached
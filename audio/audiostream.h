@@ -436,6 +436,44 @@ Timestamp convertTimeToStreamPos(const Timestamp &where, int rate, bool isStereo
  */
 AudioStream *makeLimitingAudioStream(AudioStream *parentStream, const Timestamp &length, DisposeAfterUse::Flag disposeAfterUse = DisposeAfterUse::YES);
 
+/**
+ * A SeekableAudioStream wrapper that decodes its parent stream ahead of
+ * playback into a bounded buffer, from a timer callback.
+ *
+ * Decoding compressed formats then mostly happens outside of the mixer
+ * callback, which only has to copy the decoded samples. If playback
+ * catches up with decoding, the missing samples are decoded right away in
+ * readBuffer(), so the output is always identical to the parent stream's.
+ *
+ * @see makeDecodeAheadStream
+ */
+class DecodeAheadAudioStream : public SeekableAudioStream {
+public:
+	/** Return the number of decoded samples waiting to be played. */
+	virtual uint32 getBufferedSamples() const = 0;
+
+	/** Return the capacity of the decode buffer, in samples. */
+	virtual uint32 getBufferSize() const = 0;
+
+	/**
+	 * Return how many times readBuffer() ran out of decoded samples and had
+	 * to decode from the parent stream itself.
+	 */
+	virtual uint32 getUnderrunCount() const = 0;
+};
+
+/**
+ * Factory function for a DecodeAheadAudioStream.
+ *
+ * Seeking, and thus looping, are passed on to the parent stream and drop the
+ * samples decoded so far.
+ *
+ * @param parentStream     The stream to decode ahead.
+ * @param bufferMs         How far ahead of playback to decode, in milliseconds.
+ * @param disposeAfterUse  Whether the parent stream object should be destroyed on destruction of the returned stream.
+ */
+DecodeAheadAudioStream *makeDecodeAheadStream(SeekableAudioStream *parentStream, uint32 bufferMs = 250, DisposeAfterUse::Flag disposeAfterUse = DisposeAfterUse::YES);
+
 /**
  * An AudioStream designed to work in terms of packets.
  *
@@ -23,6 +23,7 @@
 
 #ifdef USE_MAD
 
+#include "common/array.h"
 #include "common/debug.h"
 #include "common/mutex.h"
 #include "common/ptr.h"
@@ -60,7 +61,7 @@ protected:
 	void decodeMP3Data(Common::ReadStream &stream);
 	void readMP3Data(Common::ReadStream &stream);
 
-	void initStream(Common::ReadStream &stream);
+	void initStream(Common::ReadStream &stream, uint32 streamPos = 0);
 	void readHeader(Common::ReadStream &stream);
 	void deinitStream();
 
@@ -75,6 +76,13 @@ protected:
 	uint _posInFrame;
 	State _state;
 
+	// Position in the input stream of the data read so far, and of the start of _buf
+	uint32 _inputPos;
+	uint32 _bufPos;
+
+	/** Position in the input stream of the frame whose header was decoded last */
+	uint32 getFramePos() const { return _bufPos + (uint32)(_stream.this_frame - _buf); }
+
 	mad_timer_t _curTime;
 
 	mad_stream _stream;
@@ -106,6 +114,20 @@ protected:
 
 	Timestamp _length;
 
+	// Position and start time of every kFrameIndexInterval-th frame, recorded
+	// while computing the length so that seeking only has to walk the frame
+	// headers from the closest indexed frame
+	struct FrameIndexEntry {
+		uint32 pos;
+		mad_timer_t time;
+	};
+	enum {
+		kFrameIndexInterval = 32
+	};
+	Common::Array<FrameIndexEntry> _frameIndex;
+
+	void addFrameIndexEntry(const mad_timer_t &time);
+
 private:
 	static Common::SeekableReadStream *skipID3(Common::SeekableReadStream *stream, DisposeAfterUse::Flag dispose);
 };
@@ -135,6 +157,8 @@ private:
 BaseMP3Stream::BaseMP3Stream() :
 	_posInFrame(0),
 	_state(MP3_STATE_INIT),
+	_inputPos(0),
+	_bufPos(0),
 	_curTime(mad_timer_zero) {
 
 	// The MAD_BUFFER_GUARD must always contain zeros (the reason
@@ -208,6 +232,7 @@ void BaseMP3Stream::readMP3Data(Common::ReadStream &stream) {
 		assert(remaining < BUFFER_SIZE);	// Paranoia check
 		memmove(_buf, _stream.next_frame, remaining);
 	}
+	_bufPos = _inputPos - remaining;
 
 	// Try to read the next block
 	uint32 size = stream.read(_buf + remaining, BUFFER_SIZE - remaining);
@@ -215,13 +240,14 @@ void BaseMP3Stream::readMP3Data(Common::ReadStream &stream) {
 		_state = MP3_STATE_EOS;
 		return;
 	}
+	_inputPos += size;
 
 	// Feed the data we just read into the stream decoder
 	_stream.error = MAD_ERROR_NONE;
 	mad_stream_buffer(&_stream, _buf, size + remaining);
 }
 
-void BaseMP3Stream::initStream(Common::ReadStream &stream) {
+void BaseMP3Stream::initStream(Common::ReadStream &stream, uint32 streamPos) {
 	if (_state != MP3_STATE_INIT)
 		deinitStream();
 
@@ -233,6 +259,8 @@ void BaseMP3Stream::initStream(Common::ReadStream &stream) {
 	// Reset the stream data
 	_curTime = mad_timer_zero;
 	_posInFrame = 0;
+	_inputPos = streamPos;
+	_bufPos = streamPos;
 
 	// Update state
 	_state = MP3_STATE_READY;
@@ -336,9 +364,17 @@ MP3Stream::MP3Stream(Common::SeekableReadStream *inStream, DisposeAfterUse::Flag
 	_channels = MAD_NCHANNELS(&_frame.header);
 	_rate = _frame.header.samplerate;
 
-	// Calculate the length of the stream
-	while (_state != MP3_STATE_EOS)
+	// Calculate the length of the stream, and index the frames on the way
+	if (_state != MP3_STATE_EOS)
+		addFrameIndexEntry(mad_timer_zero);
+	uint frame = 1;
+	while (_state != MP3_STATE_EOS) {
+		mad_timer_t frameTime = _curTime;
 		readHeader(*_inStream);
+		if (_state != MP3_STATE_EOS && frame % kFrameIndexInterval == 0)
+			addFrameIndexEntry(frameTime);
+		frame++;
+	}
 
 	// To rule out any invalid sample rate to be encountered here, say in case the
 	// MP3 stream is invalid, we just check the MAD error code here.
@@ -359,6 +395,13 @@ MP3Stream::MP3Stream(Common::SeekableReadStream *inStream, DisposeAfterUse::Flag
 	decodeMP3Data(*_inStream);
 }
 
+void MP3Stream::addFrameIndexEntry(const mad_timer_t &time) {
+	FrameIndexEntry entry;
+	entry.pos = getFramePos();
+	entry.time = time;
+	_frameIndex.push_back(entry);
+}
+
 int MP3Stream::readBuffer(int16 *buffer, const int numSamples) {
 	return fillBuffer(*_inStream, buffer, numSamples);
 }
@@ -376,7 +419,24 @@ bool MP3Stream::seek(const Timestamp &where) {
 	mad_timer_t destination;
 	mad_timer_set(&destination, time / 1000, time % 1000, 1000);
 
-	if (_state != MP3_STATE_READY || mad_timer_compare(destination, _curTime) < 0) {
+	// Find the last indexed frame starting before the destination
+	uint lo = 0, hi = _frameIndex.size();
+	while (lo < hi) {
+		uint mid = (lo + hi) / 2;
+		if (mad_timer_compare(_frameIndex[mid].time, destination) <= 0)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	if (lo > 0 && (_state != MP3_STATE_READY || mad_timer_compare(destination, _curTime) < 0 ||
+	               mad_timer_compare(_frameIndex[lo - 1].time, _curTime) > 0)) {
+		// Jump to that frame if it is closer than the current position
+		const FrameIndexEntry &entry = _frameIndex[lo - 1];
+		_inStream->seek(entry.pos);
+		initStream(*_inStream, entry.pos);
+		_curTime = entry.time;
+	} else if (_state != MP3_STATE_READY || mad_timer_compare(destination, _curTime) < 0) {
 		_inStream->seek(0);
 		initStream(*_inStream);
 	}
@@ -62,6 +62,7 @@ MODULE_OBJS := \
 	mods/tfmx.o \
 	mods/desktoptracker.o \
 	softsynth/cms.o \
+	softsynth/emumidi.o \
 	softsynth/opl/dbopl.o \
 	softsynth/opl/dosbox.o \
 	softsynth/opl/mame.o \
@@ -0,0 +1,183 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "audio/softsynth/emumidi.h"
+
+#include "common/debug.h"
+#include "common/system.h"
+#include "common/timer.h"
+
+MidiDriver_Emulated *MidiDriver_Emulated::_renderAheadDriver = nullptr;
+
+MidiDriver_Emulated::MidiDriver_Emulated(Audio::Mixer *mixer) :
+	_mixer(mixer),
+	_isOpen(false),
+	_timerProc(0),
+	_timerParam(0),
+	_nextTick(0),
+	_samplesPerTick(0),
+	_renderAheadMs(0),
+	_ring(nullptr),
+	_ringSize(0),
+	_ringRead(0),
+	_ringFill(0),
+	_underruns(0),
+	_baseFreq(250) {
+}
+
+MidiDriver_Emulated::~MidiDriver_Emulated() {
+	stopRenderAhead();
+}
+
+int MidiDriver_Emulated::open() {
+	_isOpen = true;
+
+	int d = getRate() / _baseFreq;
+	int r = getRate() % _baseFreq;
+
+	// This is equivalent to (getRate() << FIXP_SHIFT) / BASE_FREQ
+	// but less prone to arithmetic overflow.
+
+	_samplesPerTick = (d << FIXP_SHIFT) + (r << FIXP_SHIFT) / _baseFreq;
+
+	if (_renderAheadMs && !_ring && _renderAheadDriver) {
+		debug(1, "MidiDriver_Emulated: another driver already renders ahead, rendering from the mixer");
+	} else if (_renderAheadMs && !_ring) {
+		const int stereoFactor = isStereo() ? 2 : 1;
+
+		_ringSize = MAX<uint32>((uint64)getRate() * _renderAheadMs / 1000, 256);
+		_ring = new int16[_ringSize * stereoFactor];
+		_ringRead = 0;
+		_ringFill = 0;
+		_underruns = 0;
+
+		// Start with a full ring, nobody else is rendering yet
+		fillRing();
+
+		_renderAheadDriver = this;
+		uint32 interval = MAX<uint32>(_renderAheadMs / 4, 1) * 1000;
+		g_system->getTimerManager()->installTimerProc(renderAheadTimer, interval, this, "MidiDriver_Emulated");
+	}
+
+	return 0;
+}
+
+void MidiDriver_Emulated::stopRenderAhead() {
+	if (!_ring)
+		return;
+
+	// Once removed, the timer callback is guaranteed not to be running
+	g_system->getTimerManager()->removeTimerProc(renderAheadTimer);
+	_renderAheadDriver = nullptr;
+
+	Common::StackLock lock(_ringMutex);
+	delete[] _ring;
+	_ring = nullptr;
+	_ringSize = 0;
+	_ringRead = 0;
+	_ringFill = 0;
+}
+
+void MidiDriver_Emulated::renderAheadTimer(void *refCon) {
+	((MidiDriver_Emulated *)refCon)->fillRing();
+}
+
+void MidiDriver_Emulated::fillRing() {
+	const int stereoFactor = isStereo() ? 2 : 1;
+
+	_ringMutex.lock();
+	uint32 space = _ringSize - _ringFill;
+	uint32 write = (_ringRead + _ringFill) % _ringSize;
+	_ringMutex.unlock();
+
+	while (space) {
+		uint32 count = MIN(space, _ringSize - write);
+
+		renderSamples(_ring + write * stereoFactor, count * stereoFactor);
+
+		_ringMutex.lock();
+		_ringFill += count;
+		_ringMutex.unlock();
+
+		write = (write + count) % _ringSize;
+		space -= count;
+	}
+}
+
+void MidiDriver_Emulated::renderSamples(int16 *data, const int numSamples) {
+	const int stereoFactor = isStereo() ? 2 : 1;
+	int len = numSamples / stereoFactor;
+	int step;
+
+	do {
+		step = len;
+		if (step > (_nextTick >> FIXP_SHIFT))
+			step = (_nextTick >> FIXP_SHIFT);
+
+		generateSamples(data, step);
+
+		_nextTick -= step << FIXP_SHIFT;
+		if (!(_nextTick >> FIXP_SHIFT)) {
+			if (_timerProc)
+				(*_timerProc)(_timerParam);
+
+			onTimer();
+
+			_nextTick += _samplesPerTick;
+		}
+
+		data += step * stereoFactor;
+		len -= step;
+	} while (len);
+}
+
+int MidiDriver_Emulated::readBuffer(int16 *data, const int numSamples) {
+	if (!_ring) {
+		renderSamples(data, numSamples);
+		return numSamples;
+	}
+
+	const int stereoFactor = isStereo() ? 2 : 1;
+	uint32 len = numSamples / stereoFactor;
+
+	_ringMutex.lock();
+	uint32 read = _ringRead;
+	uint32 count = MIN(len, _ringFill);
+	_ringMutex.unlock();
+
+	uint32 first = MIN(count, _ringSize - read);
+	memcpy(data, _ring + read * stereoFactor, first * stereoFactor * sizeof(int16));
+	memcpy(data + first * stereoFactor, _ring, (count - first) * stereoFactor * sizeof(int16));
+
+	_ringMutex.lock();
+	_ringRead = (read + count) % _ringSize;
+	_ringFill -= count;
+	_ringMutex.unlock();
+
+	// Rendering fell behind, play silence rather than waiting for it
+	if (count < len) {
+		memset(data + count * stereoFactor, 0, (len - count) * stereoFactor * sizeof(int16));
+		++_underruns;
+		debug(5, "MidiDriver_Emulated: render-ahead underrun, %u frames missing", len - count);
+	}
+
+	return numSamples;
+}
@@ -26,6 +26,8 @@
 #include "audio/mididrv.h"
 #include "audio/mixer.h"
 
+#include "common/mutex.h"
+
 class MidiDriver_Emulated : public Audio::AudioStream, public MidiDriver {
 protected:
 	bool _isOpen;
@@ -37,43 +39,59 @@ private:
 	void *_timerParam;
 
 	enum {
-		FIXP_SHIFT = 16
+		FIXP_SHIFT = 16,
+		kMaxRenderAheadMs = 1000
 	};
 
 	int _nextTick;
 	int _samplesPerTick;
 
+	// Render-ahead ring, filled from a timer callback and drained by readBuffer().
+	// The mutex only guards the read position and fill level, the samples are
+	// copied outside of it as the producer and the consumer never touch the
+	// same part of the ring.
+	uint32 _renderAheadMs;
+	int16 *_ring;
+	uint32 _ringSize;    // in sample frames
+	uint32 _ringRead;    // first frame to play
+	uint32 _ringFill;    // frames rendered and not played yet
+	uint32 _underruns;
+	Common::Mutex _ringMutex;
+
+	// The timer manager cannot install the same callback twice, so only one
+	// driver at a time renders ahead, the others render from readBuffer()
+	static MidiDriver_Emulated *_renderAheadDriver;
+
+	void renderSamples(int16 *data, const int numSamples);
+	void fillRing();
+	static void renderAheadTimer(void *refCon);
+
 protected:
 	int _baseFreq;
 
 	virtual void generateSamples(int16 *buf, int len) = 0;
 	virtual void onTimer() {}
 
-public:
-	MidiDriver_Emulated(Audio::Mixer *mixer) :
-		_mixer(mixer),
-		_isOpen(false),
-		_timerProc(0),
-		_timerParam(0),
-		_nextTick(0),
-		_samplesPerTick(0),
-		_baseFreq(250) {
-	}
-
-	// MidiDriver API
-	virtual int open() {
-		_isOpen = true;
-
-		int d = getRate() / _baseFreq;
-		int r = getRate() % _baseFreq;
+	/**
+	 * Render the synth output up to ms milliseconds ahead of playback, from a
+	 * timer callback rather than from the mixer callback. Events sent by the
+	 * timer callback set with setTimerCallback() are still applied at the
+	 * exact sample they were before, events sent from elsewhere are heard once
+	 * the ring has been played. Must be called before open(), 0 disables it.
+	 * Values are clamped to kMaxRenderAheadMs. Only one driver at a time can
+	 * render ahead, open() ignores the setting while another one does.
+	 */
+	void setRenderAhead(int ms) { _renderAheadMs = CLIP<int>(ms, 0, kMaxRenderAheadMs); }
 
-		// This is equivalent to (getRate() << FIXP_SHIFT) / BASE_FREQ
-		// but less prone to arithmetic overflow.
+	/** Stop rendering ahead. Must be called by close() before the synth is destroyed. */
+	void stopRenderAhead();
 
-		_samplesPerTick = (d << FIXP_SHIFT) + (r << FIXP_SHIFT) / _baseFreq;
+public:
+	MidiDriver_Emulated(Audio::Mixer *mixer);
+	~MidiDriver_Emulated() override;
 
-		return 0;
-	}
+	// MidiDriver API
+	virtual int open();
 
 	bool isOpen() const { return _isOpen; }
 
@@ -86,35 +104,11 @@ public:
 		return 1000000 / _baseFreq;
 	}
 
-	// AudioStream API
-	virtual int readBuffer(int16 *data, const int numSamples) {
-		const int stereoFactor = isStereo() ? 2 : 1;
-		int len = numSamples / stereoFactor;
-		int step;
-
-		do {
-			step = len;
-			if (step > (_nextTick >> FIXP_SHIFT))
-				step = (_nextTick >> FIXP_SHIFT);
-
-			generateSamples(data, step);
-
-			_nextTick -= step << FIXP_SHIFT;
-			if (!(_nextTick >> FIXP_SHIFT)) {
-				if (_timerProc)
-					(*_timerProc)(_timerParam);
-
-				onTimer();
+	/** Number of times the mixer played silence because the render-ahead ring was empty */
+	uint32 getUnderrunCount() const { return _underruns; }
 
-				_nextTick += _samplesPerTick;
-			}
-
-			data += step * stereoFactor;
-			len -= step;
-		} while (len);
-
-		return numSamples;
-	}
+	// AudioStream API
+	virtual int readBuffer(int16 *data, const int numSamples);
 
 	virtual bool endOfData() const {
 		return false;
@@ -1111,27 +1111,14 @@ static void OPL3_ProcessSlot(opl3_slot *slot)
     OPL3_SlotGenerate(slot);
 }
 
-inline void OPL3_Generate4Ch(opl3_chip *chip, int16_t *buf4)
+/* Mix the left (side 0) or right (side 1) outputs of both chip halves */
+static void OPL3_MixChannels(opl3_chip *chip, uint8_t side)
 {
     opl3_channel *channel;
-    opl3_writebuf *writebuf;
     int16_t **out;
     int32_t mix[2];
     uint8_t ii;
     int16_t accm;
-    uint8_t shift = 0;
-
-    buf4[1] = OPL3_ClipSample(chip->mixbuff[1]);
-    buf4[3] = OPL3_ClipSample(chip->mixbuff[3]);
-
-#if OPL_QUIRK_CHANNELSAMPLEDELAY
-    for (ii = 0; ii < 15; ii++)
-#else
-    for (ii = 0; ii < 36; ii++)
-#endif
-    {
-        OPL3_ProcessSlot(&chip->slot[ii]);
-    }
 
     mix[0] = mix[1] = 0;
     for (ii = 0; ii < 18; ii++)
@@ -1140,54 +1127,21 @@ inline void OPL3_Generate4Ch(opl3_chip *chip, int16_t *buf4)
         out = channel->out;
         accm = *out[0] + *out[1] + *out[2] + *out[3];
 #if OPL_ENABLE_STEREOEXT
-        mix[0] += (int16_t)((accm * channel->leftpan) >> 16);
+        mix[0] += (int16_t)((accm * (side ? channel->rightpan : channel->leftpan)) >> 16);
 #else
-        mix[0] += (int16_t)(accm & channel->cha);
-#endif
-        mix[1] += (int16_t)(accm & channel->chc);
-    }
-    chip->mixbuff[0] = mix[0];
-    chip->mixbuff[2] = mix[1];
-
-#if OPL_QUIRK_CHANNELSAMPLEDELAY
-    for (ii = 15; ii < 18; ii++)
-    {
-        OPL3_ProcessSlot(&chip->slot[ii]);
-    }
-#endif
-
-    buf4[0] = OPL3_ClipSample(chip->mixbuff[0]);
-    buf4[2] = OPL3_ClipSample(chip->mixbuff[2]);
-
-#if OPL_QUIRK_CHANNELSAMPLEDELAY
-    for (ii = 18; ii < 33; ii++)
-    {
-        OPL3_ProcessSlot(&chip->slot[ii]);
-    }
+        mix[0] += (int16_t)(accm & (side ? channel->chb : channel->cha));
 #endif
-
-    mix[0] = mix[1] = 0;
-    for (ii = 0; ii < 18; ii++)
-    {
-        channel = &chip->channel[ii];
-        out = channel->out;
-        accm = *out[0] + *out[1] + *out[2] + *out[3];
-#if OPL_ENABLE_STEREOEXT
-        mix[0] += (int16_t)((accm * channel->rightpan) >> 16);
-#else
-        mix[0] += (int16_t)(accm & channel->chb);
- #endif
-        mix[1] += (int16_t)(accm & channel->chd);
+        mix[1] += (int16_t)(accm & (side ? channel->chd : channel->chc));
     }
-    chip->mixbuff[1] = mix[0];
-    chip->mixbuff[3] = mix[1];
+    chip->mixbuff[side] = mix[0];
+    chip->mixbuff[side + 2] = mix[1];
+}
 
-#if OPL_QUIRK_CHANNELSAMPLEDELAY
-    for (ii = 33; ii < 36; ii++)
-    {
-        OPL3_ProcessSlot(&chip->slot[ii]);
-    }
-#endif
+/* Advance the LFOs and envelope timer, and apply the buffered writes that are due */
+static void OPL3_ChipTick(opl3_chip *chip)
+{
+    opl3_writebuf *writebuf;
+    uint8_t shift = 0;
 
     if ((chip->timer & 0x3f) == 0x3f)
     {
@@ -1255,6 +1209,231 @@ inline void OPL3_Generate4Ch(opl3_chip *chip, int16_t *buf4)
     chip->writebuf_samplecnt++;
 }
 
+void OPL3_Generate4Ch(opl3_chip *chip, int16_t *buf4)
+{
+    uint8_t ii;
+
+    buf4[1] = OPL3_ClipSample(chip->mixbuff[1]);
+    buf4[3] = OPL3_ClipSample(chip->mixbuff[3]);
+
+#if OPL_QUIRK_CHANNELSAMPLEDELAY
+    for (ii = 0; ii < 15; ii++)
+#else
+    for (ii = 0; ii < 36; ii++)
+#endif
+    {
+        OPL3_ProcessSlot(&chip->slot[ii]);
+    }
+
+    OPL3_MixChannels(chip, 0);
+
+#if OPL_QUIRK_CHANNELSAMPLEDELAY
+    for (ii = 15; ii < 18; ii++)
+    {
+        OPL3_ProcessSlot(&chip->slot[ii]);
+    }
+#endif
+
+    buf4[0] = OPL3_ClipSample(chip->mixbuff[0]);
+    buf4[2] = OPL3_ClipSample(chip->mixbuff[2]);
+
+#if OPL_QUIRK_CHANNELSAMPLEDELAY
+    for (ii = 18; ii < 33; ii++)
+    {
+        OPL3_ProcessSlot(&chip->slot[ii]);
+    }
+#endif
+
+    OPL3_MixChannels(chip, 1);
+
+#if OPL_QUIRK_CHANNELSAMPLEDELAY
+    for (ii = 33; ii < 36; ii++)
+    {
+        OPL3_ProcessSlot(&chip->slot[ii]);
+    }
+#endif
+
+    OPL3_ChipTick(chip);
+}
+
+/*
+    Block generation
+
+    Produces the same output as OPL3_Generate4Ch, but splits each sample in
+    two passes. The first one runs the feedback, envelope and phase
+    generators of all the slots, which don't depend on the other slots'
+    outputs of the same sample. The second one computes the slot outputs in
+    the order required by the modulation and the channel sample delay.
+    Both passes take shortcuts for the slots which are silent.
+*/
+
+static void OPL3_EnvelopeCalcBlock(opl3_slot *slot)
+{
+    /*
+        Two states leave the envelope as it is: a released slot that reached
+        the maximum attenuation, and a sustaining slot of the sustained
+        envelope type (which has a rate of 0) while it is audible.
+    */
+    if ((!slot->key && slot->eg_gen == envelope_gen_num_release && slot->eg_rout == 0x1ff)
+     || (slot->key && slot->eg_gen == envelope_gen_num_sustain && slot->reg_type
+         && (slot->eg_rout & 0x1f8) != 0x1f8))
+    {
+        slot->eg_out = slot->eg_rout + (slot->reg_tl << 2)
+                     + (slot->eg_ksl >> kslshift[slot->reg_ksl]) + *slot->trem;
+        slot->pg_reset = 0;
+        return;
+    }
+    OPL3_EnvelopeCalc(slot);
+}
+
+/*
+    Phase generator of the slots not involved in rhythm mode, the noise
+    generator is advanced separately by OPL3_NoiseAdvance
+*/
+static void OPL3_PhaseGenerateBlock(opl3_slot *slot)
+{
+    uint16_t f_num;
+    uint32_t basefreq;
+
+    f_num = slot->channel->f_num;
+    if (slot->reg_vib)
+    {
+        int8_t range;
+        uint8_t vibpos;
+
+        range = (f_num >> 7) & 7;
+        vibpos = slot->chip->vibpos;
+
+        if (!(vibpos & 3))
+        {
+            range = 0;
+        }
+        else if (vibpos & 1)
+        {
+            range >>= 1;
+        }
+        range >>= slot->chip->vibshift;
+
+        if (vibpos & 4)
+        {
+            range = -range;
+        }
+        f_num += range;
+    }
+    basefreq = (f_num << slot->channel->block) >> 1;
+    slot->pg_phase_out = (uint16_t)(slot->pg_phase >> 9);
+    if (slot->pg_reset)
+    {
+        slot->pg_phase = 0;
+    }
+    slot->pg_phase += (basefreq * mt[slot->reg_mult]) >> 1;
+}
+
+/* Same as count calls to OPL3_PhaseGenerate would do to the noise generator */
+static uint32_t OPL3_NoiseAdvance(uint32_t noise, uint8_t count)
+{
+    uint8_t n_bit;
+
+    while (count--)
+    {
+        n_bit = ((noise >> 14) ^ noise) & 0x01;
+        noise = (noise >> 1) | (n_bit << 22);
+    }
+    return noise;
+}
+
+static void OPL3_SlotGenerateBlock(opl3_slot *slot)
+{
+    uint16_t phase;
+
+    /*
+        From an attenuation of 0x180 on, the exponent table output is shifted
+        out entirely whatever the phase, leaving only the sign of the wave.
+    */
+    if (slot->eg_out >= 0x180)
+    {
+        phase = (uint16_t)(slot->pg_phase_out + *slot->mod) & 0x3ff;
+        switch (slot->reg_wf)
+        {
+        case 0:
+        case 6:
+        case 7:
+            slot->out = (phase & 0x200) ? -1 : 0;
+            break;
+        case 4:
+            slot->out = ((phase & 0x300) == 0x100) ? -1 : 0;
+            break;
+        default:
+            slot->out = 0;
+            break;
+        }
+        return;
+    }
+    OPL3_SlotGenerate(slot);
+}
+
+static void OPL3_GenerateSlots(opl3_chip *chip, uint8_t first, uint8_t last)
+{
+    uint8_t ii;
+
+    for (ii = first; ii < last; ii++)
+    {
+        OPL3_SlotGenerateBlock(&chip->slot[ii]);
+    }
+}
+
+void OPL3_Generate4ChBlock(opl3_chip *chip, int16_t *buf4, uint32_t numsamples)
+{
+    opl3_slot *slot;
+    uint32_t i;
+    uint8_t ii, lastnoise;
+
+    for (i = 0; i < numsamples; i++, buf4 += 4)
+    {
+        buf4[1] = OPL3_ClipSample(chip->mixbuff[1]);
+        buf4[3] = OPL3_ClipSample(chip->mixbuff[3]);
+
+        /* Only the hi-hat, snare drum and top cymbal slots use the noise */
+        lastnoise = 0;
+        for (ii = 0; ii < 36; ii++)
+        {
+            slot = &chip->slot[ii];
+            OPL3_SlotCalcFB(slot);
+            OPL3_EnvelopeCalcBlock(slot);
+            if (ii == 13 || ii == 16 || ii == 17)
+            {
+                chip->noise = OPL3_NoiseAdvance(chip->noise, ii - lastnoise);
+                OPL3_PhaseGenerate(slot);
+                lastnoise = ii + 1;
+            }
+            else
+            {
+                OPL3_PhaseGenerateBlock(slot);
+            }
+        }
+        chip->noise = OPL3_NoiseAdvance(chip->noise, 36 - lastnoise);
+
+#if OPL_QUIRK_CHANNELSAMPLEDELAY
+        OPL3_GenerateSlots(chip, 0, 15);
+        OPL3_MixChannels(chip, 0);
+        OPL3_GenerateSlots(chip, 15, 18);
+        buf4[0] = OPL3_ClipSample(chip->mixbuff[0]);
+        buf4[2] = OPL3_ClipSample(chip->mixbuff[2]);
+        OPL3_GenerateSlots(chip, 18, 33);
+        OPL3_MixChannels(chip, 1);
+        OPL3_GenerateSlots(chip, 33, 36);
+#else
+        OPL3_GenerateSlots(chip, 0, 36);
+        OPL3_MixChannels(chip, 0);
+        buf4[0] = OPL3_ClipSample(chip->mixbuff[0]);
+        buf4[2] = OPL3_ClipSample(chip->mixbuff[2]);
+        OPL3_MixChannels(chip, 1);
+#endif
+
+        OPL3_ChipTick(chip);
+    }
+}
+
 void OPL3_Generate(opl3_chip *chip, int16_t *buf)
 {
     int16_t samples[4];
@@ -1523,12 +1702,64 @@ void OPL3_Generate4ChStream(opl3_chip *chip, int16_t *sndptr1, int16_t *sndptr2,
 
 void OPL3_GenerateStream(opl3_chip *chip, int16_t *sndptr, uint32_t numsamples)
 {
-    uint_fast32_t i;
+    int16_t block[OPL_BLOCK_SIZE * 4];
+    const int16_t *frame;
+    uint32_t count, needed, blocksamples;
+    int32_t samplecnt;
+
+    while (numsamples)
+    {
+        /*
+            Find how many output samples the next block of chip samples
+            covers. Exactly as many chip samples as the resampler consumes
+            are generated, so that buffered writes keep their timing.
+        */
+        count = 0;
+        blocksamples = 0;
+        samplecnt = chip->samplecnt;
+        while (count < numsamples)
+        {
+            needed = 0;
+            while (samplecnt >= chip->rateratio)
+            {
+                samplecnt -= chip->rateratio;
+                needed++;
+            }
+            if (count && blocksamples + needed > OPL_BLOCK_SIZE)
+            {
+                break;
+            }
+            blocksamples += needed;
+            samplecnt += 1 << RSM_FRAC;
+            count++;
+        }
 
-    for(i = 0; i < numsamples; i++)
-    {
-        OPL3_GenerateResampled(chip, sndptr);
-        sndptr += 2;
+        OPL3_Generate4ChBlock(chip, block, blocksamples);
+
+        frame = block;
+        numsamples -= count;
+        while (count--)
+        {
+            while (chip->samplecnt >= chip->rateratio)
+            {
+                chip->oldsamples[0] = chip->samples[0];
+                chip->oldsamples[1] = chip->samples[1];
+                chip->oldsamples[2] = chip->samples[2];
+                chip->oldsamples[3] = chip->samples[3];
+                chip->samples[0] = frame[0];
+                chip->samples[1] = frame[1];
+                chip->samples[2] = frame[2];
+                chip->samples[3] = frame[3];
+                frame += 4;
+                chip->samplecnt -= chip->rateratio;
+            }
+            sndptr[0] = (int16_t)((chip->oldsamples[0] * (chip->rateratio - chip->samplecnt)
+                                  + chip->samples[0] * chip->samplecnt) / chip->rateratio);
+            sndptr[1] = (int16_t)((chip->oldsamples[1] * (chip->rateratio - chip->samplecnt)
+                                  + chip->samples[1] * chip->samplecnt) / chip->rateratio);
+            chip->samplecnt += 1 << RSM_FRAC;
+            sndptr += 2;
+        }
     }
 }
 
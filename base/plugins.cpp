@@ -678,6 +678,9 @@ DetectionResults EngineManager::detectGames(const Common::FSList &fslist, uint32
 
 	// Clear md5 cache before each detection starts, just in case.
 	ADCacheMan.clear();
+	// All engines look at the same directory, so only list its
+	// subdirectories once.
+	ADCacheMan.setCacheDirectories(true);
 
 	// Iterate over all known games and for each check if it might be
 	// the game in the presented directory.
@@ -696,6 +699,7 @@ DetectionResults EngineManager::detectGames(const Common::FSList &fslist, uint32
 
 	// Close all archives that were opened during detection
 	ADCacheMan.clearArchives();
+	ADCacheMan.setCacheDirectories(false);
 
 	return DetectionResults(candidates);
 }
@@ -0,0 +1,659 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+// The open addressing scheme in this file follows the "Swiss table" design
+// of Abseil: a byte of metadata per slot, probed a group of slots at a time.
+
+#ifndef COMMON_FLATHASHMAP_H
+#define COMMON_FLATHASHMAP_H
+
+#include "common/endian.h"
+#include "common/hashmap.h"
+#include "common/textconsole.h"
+#include "common/util.h"
+
+namespace Common {
+
+/**
+ * @defgroup common_flathashmap Flat hash table (FlatHashMap)
+ * @ingroup common
+ *
+ * @brief API for operations on a flat hash table.
+ *
+ * @{
+ */
+
+/**
+ * FlatHashMap<Key,Val> maps objects of type Key to objects of type Val, with
+ * the same interface and requirements as HashMap.
+ *
+ * Unlike HashMap, the key/value pairs are stored inline in the table, next to
+ * an array holding one byte of metadata per slot: whether the slot is empty,
+ * deleted, or 7 bits of the hash of its key. Lookups compare the
+ * metadata of 8 slots at once and only touch the slots whose metadata
+ * matches, so a lookup usually costs a single key comparison and no pointer
+ * chasing.
+ *
+ * As the pairs are moved around when the table grows, references and
+ * iterators to them are invalidated by any insertion.
+ *
+ * If both the hash and the equality functors declare an is_transparent type,
+ * the lookup functions also accept any key type these functors accept, for
+ * instance a C string in a map with String keys, without building a Key.
+ */
+template<class Key, class Val, class HashFunc = Hash<Key>, class EqualFunc = EqualTo<Key> >
+class FlatHashMap {
+public:
+	typedef uint size_type;
+
+	struct Node {
+		Val _value;
+		const Key _key;
+		explicit Node(const Key &key) : _value(), _key(key) {}
+	};
+
+private:
+	typedef FlatHashMap<Key, Val, HashFunc, EqualFunc> FHM_t;
+
+	enum {
+		FLATHASHMAP_GROUP_SIZE = 8,
+		FLATHASHMAP_MIN_CAPACITY = 16
+	};
+
+	// Metadata of the slots without a key. Slots holding a key have 7 bits
+	// of its hash as metadata, so the top bit is clear.
+	enum {
+		FLATHASHMAP_EMPTY = 0x80,
+		FLATHASHMAP_DELETED = 0xFE
+	};
+
+	/** Default value, returned by the const getVal. */
+	Val _defaultVal;
+
+	byte *_ctrl;	///< Metadata of each slot
+	Node *_slots;	///< Storage for the key/value pairs, constructed in place
+	size_type _mask;	///< Capacity of the FlatHashMap minus one; the capacity is a power of two
+	size_type _size;
+	size_type _deleted;	///< Number of deleted slots
+
+	HashFunc _hash;
+	EqualFunc _equal;
+
+	// Group operations: each byte of a group word holds the metadata of a
+	// slot, and the results have the top bit set in the bytes of the
+	// matching slots.
+	static uint64 loadGroup(const byte *ctrl) {
+		return READ_LE_UINT64(ctrl);
+	}
+
+	static uint64 matchHash(uint64 group, byte h2) {
+		const uint64 lsbs = 0x0101010101010101ULL;
+		const uint64 x = group ^ (lsbs * h2);
+		// This can give false positives next to a true match, but only on
+		// slots holding a key, which then simply fail the key comparison
+		return (x - lsbs) & ~x & (lsbs << 7);
+	}
+
+	static uint64 matchEmpty(uint64 group) {
+		// Empty is the only metadata with the top bit set and bit 1 clear
+		return group & (~group << 6) & 0x8080808080808080ULL;
+	}
+
+	static uint64 matchEmptyOrDeleted(uint64 group) {
+		return group & 0x8080808080808080ULL;
+	}
+
+	static size_type firstMatch(uint64 match) {
+#if defined(__GNUC__)
+		return __builtin_ctzll(match) >> 3;
+#else
+		size_type slot = 0;
+		while (!(match & 0x80)) {
+			match >>= 8;
+			slot++;
+		}
+		return slot;
+#endif
+	}
+
+	// Spread the bits of the hash, as the hash functions for integers
+	// return the integers themselves
+	static uint32 mixHash(uint hash) {
+		return (uint32)hash * 0x9E3779B1U;
+	}
+
+	static byte hashMetadata(uint32 hash) {
+		return hash >> 25;
+	}
+
+	size_type firstGroup(uint32 hash) const {
+		return ((hash ^ (hash >> 16)) * FLATHASHMAP_GROUP_SIZE) & _mask;
+	}
+
+	size_type maxLoad() const {
+		return (_mask + 1) - ((_mask + 1) >> 3);
+	}
+
+	bool isFull(size_type idx) const {
+		return !(_ctrl[idx] & 0x80);
+	}
+
+	void allocStorage(size_type capacity);
+	void freeStorage();
+	void assign(const FHM_t &map);
+	void rehash(size_type newCapacity);
+	size_type findFreeSlot(uint32 hash) const;
+	size_type lookupAndCreateIfMissing(const Key &key);
+	void eraseSlot(size_type idx);
+
+	template<class K>
+	size_type lookup(const K &key) const {
+		const uint32 hash = mixHash(_hash(key));
+		const byte h2 = hashMetadata(hash);
+		size_type group = firstGroup(hash);
+		for (size_type probe = FLATHASHMAP_GROUP_SIZE; ; probe += FLATHASHMAP_GROUP_SIZE) {
+			const uint64 ctrl = loadGroup(_ctrl + group);
+			for (uint64 match = matchHash(ctrl, h2); match; match &= match - 1) {
+				const size_type idx = group + firstMatch(match);
+				if (_equal(_slots[idx]._key, key))
+					return idx;
+			}
+			if (matchEmpty(ctrl))
+				return NONE_FOUND;
+			group = (group + probe) & _mask;
+		}
+	}
+
+	static const size_type NONE_FOUND = (size_type)-1;
+
+	template<class T> friend class IteratorImpl;
+
+	/**
+	 * Simple FlatHashMap iterator implementation.
+	 */
+	template<class NodeType>
+	class IteratorImpl {
+		friend class FlatHashMap;
+		template<class T> friend class IteratorImpl;
+	protected:
+		typedef const FlatHashMap hashmap_t;
+
+		size_type _idx;
+		hashmap_t *_hashmap;
+
+	protected:
+		IteratorImpl(size_type idx, hashmap_t *hashmap) : _idx(idx), _hashmap(hashmap) {}
+
+		NodeType *deref() const {
+			assert(_hashmap != nullptr);
+			assert(_idx <= _hashmap->_mask);
+			assert(_hashmap->isFull(_idx));
+			return &_hashmap->_slots[_idx];
+		}
+
+	public:
+		IteratorImpl() : _idx(0), _hashmap(nullptr) {}
+		template<class T>
+		IteratorImpl(const IteratorImpl<T> &c) : _idx(c._idx), _hashmap(c._hashmap) {}
+
+		NodeType &operator*() const { return *deref(); }
+		NodeType *operator->() const { return deref(); }
+
+		bool operator==(const IteratorImpl &iter) const { return _idx == iter._idx && _hashmap == iter._hashmap; }
+		bool operator!=(const IteratorImpl &iter) const { return !(*this == iter); }
+
+		IteratorImpl &operator++() {
+			assert(_hashmap);
+			_idx = _hashmap->nextFull(_idx + 1);
+			return *this;
+		}
+
+		IteratorImpl operator++(int) {
+			IteratorImpl old = *this;
+			operator ++();
+			return old;
+		}
+	};
+
+	size_type nextFull(size_type idx) const {
+		for (; idx <= _mask; idx++) {
+			if (isFull(idx))
+				return idx;
+		}
+		return NONE_FOUND;
+	}
+
+public:
+	typedef IteratorImpl<Node> iterator;
+	typedef IteratorImpl<const Node> const_iterator;
+
+	FlatHashMap();
+	FlatHashMap(const FHM_t &map);
+	~FlatHashMap();
+
+	FHM_t &operator=(const FHM_t &map) {
+		if (this == &map)
+			return *this;
+
+		// Remove the previous content and ...
+		freeStorage();
+		// ... copy the new stuff.
+		assign(map);
+		return *this;
+	}
+
+	bool contains(const Key &key) const {
+		return lookup(key) != NONE_FOUND;
+	}
+
+	template<class K, class H = HashFunc, class E = EqualFunc, class = typename H::is_transparent, class = typename E::is_transparent>
+	bool contains(const K &key) const {
+		return lookup(key) != NONE_FOUND;
+	}
+
+	Val &operator[](const Key &key);
+	const Val &operator[](const Key &key) const;
+
+	Val &getOrCreateVal(const Key &key);
+	Val &getVal(const Key &key);
+	const Val &getVal(const Key &key) const;
+	const Val &getValOrDefault(const Key &key) const;
+	const Val &getValOrDefault(const Key &key, const Val &defaultVal) const;
+	bool tryGetVal(const Key &key, Val &out) const;
+	void setVal(const Key &key, const Val &val);
+
+	template<class K, class H = HashFunc, class E = EqualFunc, class = typename H::is_transparent, class = typename E::is_transparent>
+	const Val &getValOrDefault(const K &key, const Val &defaultVal) const {
+		size_type ctr = lookup(key);
+		return ctr != NONE_FOUND ? _slots[ctr]._value : defaultVal;
+	}
+
+	template<class K, class H = HashFunc, class E = EqualFunc, class = typename H::is_transparent, class = typename E::is_transparent>
+	bool tryGetVal(const K &key, Val &out) const {
+		size_type ctr = lookup(key);
+		if (ctr == NONE_FOUND)
+			return false;
+		out = _slots[ctr]._value;
+		return true;
+	}
+
+	void clear(bool shrinkArray = 0);
+
+	void erase(iterator entry);
+	void erase(const Key &key);
+
+	size_type size() const { return _size; }
+
+	iterator	begin() {
+		return iterator(nextFull(0), this);
+	}
+	iterator	end() {
+		return iterator(NONE_FOUND, this);
+	}
+
+	const_iterator	begin() const {
+		return const_iterator(nextFull(0), this);
+	}
+	const_iterator	end() const {
+		return const_iterator(NONE_FOUND, this);
+	}
+
+	iterator	find(const Key &key) {
+		return iterator(lookup(key), this);
+	}
+
+	const_iterator	find(const Key &key) const {
+		return const_iterator(lookup(key), this);
+	}
+
+	template<class K, class H = HashFunc, class E = EqualFunc, class = typename H::is_transparent, class = typename E::is_transparent>
+	iterator	find(const K &key) {
+		return iterator(lookup(key), this);
+	}
+
+	template<class K, class H = HashFunc, class E = EqualFunc, class = typename H::is_transparent, class = typename E::is_transparent>
+	const_iterator	find(const K &key) const {
+		return const_iterator(lookup(key), this);
+	}
+
+	/** Return true if hashmap is empty. */
+	bool empty() const {
+		return (_size == 0);
+	}
+};
+
+//-------------------------------------------------------
+// FlatHashMap functions
+
+/**
+ * Base constructor, creates an empty hashmap.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+FlatHashMap<Key, Val, HashFunc, EqualFunc>::FlatHashMap() : _defaultVal() {
+	allocStorage(FLATHASHMAP_MIN_CAPACITY);
+}
+
+/**
+ * Copy constructor, creates a full copy of the given hashmap.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+FlatHashMap<Key, Val, HashFunc, EqualFunc>::FlatHashMap(const FHM_t &map) : _defaultVal() {
+	assign(map);
+}
+
+/**
+ * Destructor, frees all used memory.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+FlatHashMap<Key, Val, HashFunc, EqualFunc>::~FlatHashMap() {
+	freeStorage();
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::allocStorage(size_type capacity) {
+	assert(capacity >= FLATHASHMAP_MIN_CAPACITY && !(capacity & (capacity - 1)));
+
+	_mask = capacity - 1;
+	_ctrl = new byte[capacity];
+	memset(_ctrl, FLATHASHMAP_EMPTY, capacity);
+	_slots = (Node *)malloc(capacity * sizeof(Node));
+	if (!_slots)
+		error("FlatHashMap: Failure to allocate %u bytes", capacity * (uint)sizeof(Node));
+
+	_size = 0;
+	_deleted = 0;
+}
+
+/**
+ * Internal method for destroying all the elements and freeing the storage.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::freeStorage() {
+	for (size_type ctr = 0; ctr <= _mask; ++ctr) {
+		if (isFull(ctr))
+			_slots[ctr].~Node();
+	}
+
+	delete[] _ctrl;
+	free(_slots);
+}
+
+/**
+ * Internal method for assigning the content of another FlatHashMap
+ * to this one.
+ *
+ * @note The previous storage here is *not* deallocated here -- the caller is
+ *       responsible for doing that!
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::assign(const FHM_t &map) {
+	allocStorage(map._mask + 1);
+
+	// The slots are kept at the same place, so the deleted markers are
+	// still valid.
+	memcpy(_ctrl, map._ctrl, _mask + 1);
+	for (size_type ctr = 0; ctr <= _mask; ++ctr) {
+		if (map.isFull(ctr)) {
+			new ((void *)&_slots[ctr]) Node(map._slots[ctr]._key);
+			_slots[ctr]._value = map._slots[ctr]._value;
+		}
+	}
+	_size = map._size;
+	_deleted = map._deleted;
+}
+
+/**
+ * Clear all values in the hashmap.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::clear(bool shrinkArray) {
+	if (shrinkArray && _mask >= FLATHASHMAP_MIN_CAPACITY) {
+		freeStorage();
+		allocStorage(FLATHASHMAP_MIN_CAPACITY);
+		return;
+	}
+
+	for (size_type ctr = 0; ctr <= _mask; ++ctr) {
+		if (isFull(ctr))
+			_slots[ctr].~Node();
+	}
+	memset(_ctrl, FLATHASHMAP_EMPTY, _mask + 1);
+
+	_size = 0;
+	_deleted = 0;
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+typename FlatHashMap<Key, Val, HashFunc, EqualFunc>::size_type FlatHashMap<Key, Val, HashFunc, EqualFunc>::findFreeSlot(uint32 hash) const {
+	// The load factor guarantees that there is always a free slot
+	size_type group = firstGroup(hash);
+	for (size_type probe = FLATHASHMAP_GROUP_SIZE; ; probe += FLATHASHMAP_GROUP_SIZE) {
+		const uint64 match = matchEmptyOrDeleted(loadGroup(_ctrl + group));
+		if (match)
+			return group + firstMatch(match);
+		group = (group + probe) & _mask;
+	}
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::rehash(size_type newCapacity) {
+#ifndef RELEASE_BUILD
+	const size_type old_size = _size;
+#endif
+	const size_type old_mask = _mask;
+	byte *old_ctrl = _ctrl;
+	Node *old_slots = _slots;
+
+	allocStorage(newCapacity);
+
+	// Move all the elements to the new table. Since we know that no key
+	// exists twice in the old table, we don't have to call _equal().
+	for (size_type ctr = 0; ctr <= old_mask; ++ctr) {
+		if (old_ctrl[ctr] & 0x80)
+			continue;
+
+		Node &node = old_slots[ctr];
+		const uint32 hash = mixHash(_hash(node._key));
+		const size_type idx = findFreeSlot(hash);
+		_ctrl[idx] = hashMetadata(hash);
+		new ((void *)&_slots[idx]) Node(node._key);
+		_slots[idx]._value = Common::move(node._value);
+		node.~Node();
+		_size++;
+	}
+
+#ifndef RELEASE_BUILD
+	// Perform a sanity check: Old number of elements should match the new one!
+	// This check will fail if some previous operation corrupted this hashmap.
+	assert(_size == old_size);
+#endif
+
+	delete[] old_ctrl;
+	free(old_slots);
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+typename FlatHashMap<Key, Val, HashFunc, EqualFunc>::size_type FlatHashMap<Key, Val, HashFunc, EqualFunc>::lookupAndCreateIfMissing(const Key &key) {
+	size_type ctr = lookup(key);
+	if (ctr != NONE_FOUND)
+		return ctr;
+
+	// Keep the load factor below 7/8. Deleted slots are also counted, so
+	// if they make up for much of the load, the table is only rebuilt.
+	if (_size + _deleted + 1 > maxLoad()) {
+		size_type capacity = _mask + 1;
+		if ((_size + 1) * 2 > maxLoad())
+			capacity *= 2;
+		rehash(capacity);
+	}
+
+	const uint32 hash = mixHash(_hash(key));
+	ctr = findFreeSlot(hash);
+	if (_ctrl[ctr] == FLATHASHMAP_DELETED)
+		_deleted--;
+	_ctrl[ctr] = hashMetadata(hash);
+	new ((void *)&_slots[ctr]) Node(key);
+	_size++;
+
+	return ctr;
+}
+
+/**
+ * Get a value from the hashmap.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::operator[](const Key &key) {
+	return getOrCreateVal(key);
+}
+
+/**
+ * @overload
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+const Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::operator[](const Key &key) const {
+	return getVal(key);
+}
+
+/**
+ * Get a value from the hashmap.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::getOrCreateVal(const Key &key) {
+	// The storage may be reallocated when adding the key
+	size_type ctr = lookupAndCreateIfMissing(key);
+	return _slots[ctr]._value;
+}
+
+/**
+ * @overload
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::getVal(const Key &key) {
+	size_type ctr = lookup(key);
+	if (ctr != NONE_FOUND)
+		return _slots[ctr]._value;
+	else
+		// See the comment in HashMap::getVal()
+#ifdef RELEASE_BUILD
+		return _defaultVal;
+#else
+		unknownKeyError(key);
+#endif
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+const Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::getVal(const Key &key) const {
+	size_type ctr = lookup(key);
+	if (ctr != NONE_FOUND)
+		return _slots[ctr]._value;
+	else
+		// See the comment in HashMap::getVal()
+#ifdef RELEASE_BUILD
+		return _defaultVal;
+#else
+		unknownKeyError(key);
+#endif
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+const Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::getValOrDefault(const Key &key) const {
+	return getValOrDefault(key, _defaultVal);
+}
+
+/**
+ * Get a value from the hashmap. If the key is not present, then return @p defaultVal.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+const Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::getValOrDefault(const Key &key, const Val &defaultVal) const {
+	size_type ctr = lookup(key);
+	if (ctr != NONE_FOUND)
+		return _slots[ctr]._value;
+	else
+		return defaultVal;
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+bool FlatHashMap<Key, Val, HashFunc, EqualFunc>::tryGetVal(const Key &key, Val &out) const {
+	size_type ctr = lookup(key);
+	if (ctr != NONE_FOUND) {
+		out = _slots[ctr]._value;
+		return true;
+	} else {
+		return false;
+	}
+}
+
+/**
+ * Assign an element specified by @p key to a value @p val.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::setVal(const Key &key, const Val &val) {
+	size_type ctr = lookupAndCreateIfMissing(key);
+	_slots[ctr]._value = val;
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::eraseSlot(size_type idx) {
+	_slots[idx].~Node();
+	_size--;
+
+	// Lookups stop at the first group with an empty slot, and keys are only
+	// put past a group when it has no empty or deleted slot. So if this group
+	// still has an empty slot, no key was ever put past it and the slot can
+	// be made empty again. Otherwise it must be marked as deleted so that
+	// lookups go on probing.
+	const size_type group = idx & ~(size_type)(FLATHASHMAP_GROUP_SIZE - 1);
+	if (matchEmpty(loadGroup(_ctrl + group))) {
+		_ctrl[idx] = FLATHASHMAP_EMPTY;
+	} else {
+		_ctrl[idx] = FLATHASHMAP_DELETED;
+		_deleted++;
+	}
+}
+
+/**
+ * Erase an element referred to by an iterator.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::erase(iterator entry) {
+	// Check whether we have a valid iterator
+	assert(entry._hashmap == this);
+	assert(entry._idx <= _mask);
+	assert(isFull(entry._idx));
+
+	eraseSlot(entry._idx);
+}
+
+/**
+ * Erase an element specified by a key.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::erase(const Key &key) {
+	size_type ctr = lookup(key);
+	if (ctr != NONE_FOUND)
+		eraseSlot(ctr);
+}
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
@@ -42,12 +42,18 @@ struct CaseSensitiveString_Hash {
 };
 
 
+// These also accept C strings, which lets FlatHashMap look them up without
+// building a String
 struct IgnoreCase_EqualTo {
+	typedef void is_transparent;
 	bool operator()(const String& x, const String& y) const { return x.equalsIgnoreCase(y); }
+	bool operator()(const String& x, const char *y) const { return x.equalsIgnoreCase(y); }
 };
 
 struct IgnoreCase_Hash {
+	typedef void is_transparent;
 	uint operator()(const String& x) const { return hashit_lower(x.c_str()); }
+	uint operator()(const char *x) const { return hashit_lower(x); }
 };
 
 // Specalization of the Hash functor for String objects.
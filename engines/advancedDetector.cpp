@@ -450,7 +450,7 @@ void AdvancedMetaEngineDetectionBase::composeFileHashMap(FileMap &allFiles, cons
 				continue;
 
 			Common::FSList files;
-			if (!file.getChildren(files, Common::FSNode::kListAll))
+			if (!ADCacheMan.getChildren(file, files))
 				continue;
 
 			composeFileHashMap(allFiles, files, depth - 1, tstr);
@@ -718,9 +718,26 @@ ADDetectedGames AdvancedMetaEngineDetectionBase::detectGame(const Common::FSNode
 
 	preprocessDescriptions();
 
+	// Only look at the entries which can possibly match
+	Common::Array<bool> candidates(_numEntries, false);
+	for (uint i = 0; i < _unindexedEntries.size(); i++)
+		candidates[_unindexedEntries[i]] = true;
+
+	for (FileMap::const_iterator file = allFiles.begin(); file != allFiles.end(); ++file) {
+		EntryIndexMap::const_iterator entries = _entriesByFile.find(file->_key);
+		if (entries == _entriesByFile.end())
+			continue;
+		for (uint i = 0; i < entries->_value.size(); i++)
+			candidates[entries->_value[i]] = true;
+	}
+
 	// Check which files are included in some ADGameDescription *and* whether
 	// they are present. Compute MD5s and file sizes for the available files.
-	for (descPtr = _gameDescriptors; ((const ADGameDescription *)descPtr)->gameId != nullptr; descPtr += _descItemSize) {
+	uint i;
+	for (i = 0, descPtr = _gameDescriptors; ((const ADGameDescription *)descPtr)->gameId != nullptr; descPtr += _descItemSize, ++i) {
+		if (!candidates[i])
+			continue;
+
 		g = (const ADGameDescription *)descPtr;
 
 		for (fileDesc = g->filesDescriptions; fileDesc->fileName; fileDesc++) {
@@ -748,8 +765,10 @@ ADDetectedGames AdvancedMetaEngineDetectionBase::detectGame(const Common::FSNode
 	bool gotAnyMatchesWithAllFiles = false;
 
 	// MD5 based matching
-	uint i;
 	for (i = 0, descPtr = _gameDescriptors; ((const ADGameDescription *)descPtr)->gameId != nullptr; descPtr += _descItemSize, ++i) {
+		if (!candidates[i])
+			continue;
+
 		g = (const ADGameDescription *)descPtr;
 
 		// Do not even bother to look at entries which do not have matching
@@ -965,6 +984,7 @@ AdvancedMetaEngineDetectionBase::AdvancedMetaEngineDetectionBase(const void *des
 	_maxAutogenLength = 15;
 	_fullPathGlobsDepth = 5;
 
+	_numEntries = 0;
 	_hashMapsInited = false;
 
 	for (auto f = grayList; *f; f++)
@@ -984,9 +1004,34 @@ void AdvancedMetaEngineDetectionBase::preprocessDescriptions() {
 	}
 
 	// Now scan all detection entries
-	for (const byte *descPtr = _gameDescriptors; ((const ADGameDescription *)descPtr)->gameId != nullptr; descPtr += _descItemSize) {
+	for (const byte *descPtr = _gameDescriptors; ((const ADGameDescription *)descPtr)->gameId != nullptr; descPtr += _descItemSize, _numEntries++) {
 		const ADGameDescription *g = (const ADGameDescription *)descPtr;
 
+		// An entry only matches when all of its files are present, so index
+		// it by the first file which is looked up by name in the file map.
+		// Files in Mac forks may be found under other names, so they can't
+		// be used for this.
+		bool indexed = false;
+		for (const ADGameFileDescription *fileDesc = g->filesDescriptions; fileDesc->fileName && !indexed; fileDesc++) {
+			MD5Properties md5prop = gameFileToMD5Props(fileDesc, g->flags);
+			if (md5prop & (kMD5MacResFork | kMD5MacDataFork))
+				continue;
+
+			Common::Path fname(fileDesc->fileName);
+			if (md5prop & kMD5Archive) {
+				// Archive members are looked up in the archive itself
+				Common::StringTokenizer tok(fileDesc->fileName, ":");
+				tok.nextToken();
+				fname = Common::Path(tok.nextToken());
+			}
+
+			_entriesByFile.getOrCreateVal(fname).push_back(_numEntries);
+			indexed = true;
+		}
+
+		if (!indexed)
+			_unindexedEntries.push_back(_numEntries);
+
 		// Scan for potential directory globs
 		for (const ADGameFileDescription *fileDesc = g->filesDescriptions; fileDesc->fileName; fileDesc++) {
 			if (strchr(fileDesc->fileName, '/')) {
@@ -554,6 +554,15 @@ private:
 private:
 	Common::HashMap<Common::String, bool, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> _grayListMap;
 	Common::HashMap<Common::String, bool, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> _globsMap;
+	/**
+	 * Detection entries indexed by the name of one of their files, which
+	 * must be present for the entry to match. Entries which can't be
+	 * indexed this way are kept in _unindexedEntries.
+	 */
+	typedef Common::HashMap<Common::Path, Common::Array<uint>, Common::Path::IgnoreCase_Hash, Common::Path::IgnoreCase_EqualTo> EntryIndexMap;
+	EntryIndexMap _entriesByFile;
+	Common::Array<uint> _unindexedEntries;
+	uint _numEntries;
 	bool _hashMapsInited;
 
 protected:
@@ -778,7 +787,35 @@ public:
 		return archiveHashMap.getValOrDefault(node.getPath(), nullptr);
 	}
 
-	AdvancedDetectorCacheManager() {
+	/**
+	 * Enable or disable the caching of directory listings, so that engines
+	 * scanning the same subdirectories during a detection run only list
+	 * them once. Disabling it drops all the cached listings.
+	 */
+	void setCacheDirectories(bool enable) {
+		cacheDirectories = enable;
+		if (!enable)
+			directoryHashMap.clear(true);
+	}
+
+	bool getChildren(const Common::FSNode &node, Common::FSList &children) {
+		if (!cacheDirectories)
+			return node.getChildren(children, Common::FSNode::kListAll);
+
+		DirectoryHashMap::const_iterator it = directoryHashMap.find(node.getPath());
+		if (it != directoryHashMap.end()) {
+			children = it->_value;
+			return true;
+		}
+
+		if (!node.getChildren(children, Common::FSNode::kListAll))
+			return false;
+
+		directoryHashMap.setVal(node.getPath(), children);
+		return true;
+	}
+
+	AdvancedDetectorCacheManager() : cacheDirectories(false) {
 		clear();
 	}
 
@@ -792,6 +829,7 @@ public:
 	void clear() {
 		md5HashMap.clear(true);
 		sizeHashMap.clear(true);
+		directoryHashMap.clear(true);
 		clearArchives();
 	}
 
@@ -801,9 +839,12 @@ private:
 	typedef Common::HashMap<Common::String, Common::String, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> FileHashMap;
 	typedef Common::HashMap<Common::String, int64, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> SizeHashMap;
 	typedef Common::HashMap<Common::Path, Common::Archive *, Common::Path::IgnoreCase_Hash, Common::Path::IgnoreCase_EqualTo> ArchiveHashMap;
+	typedef Common::HashMap<Common::Path, Common::FSList, Common::Path::Hash, Common::Path::EqualTo> DirectoryHashMap;
 	FileHashMap md5HashMap;
 	SizeHashMap sizeHashMap;
 	ArchiveHashMap archiveHashMap;
+	DirectoryHashMap directoryHashMap;
+	bool cacheDirectories;
 };
 
 /** Convenience shortcut for accessing the MD5CacheManager. */
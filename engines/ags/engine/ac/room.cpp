@@ -52,6 +52,7 @@
 #include "ags/engine/ac/dynobj/script_object.h"
 #include "ags/engine/ac/dynobj/script_hotspot.h"
 #include "ags/engine/ac/dynobj/dynobj_manager.h"
+#include "ags/shared/gui/gui_button.h"
 #include "ags/shared/gui/gui_main.h"
 #include "ags/engine/script/cc_instance.h"
 #include "ags/engine/debugging/debug_log.h"
@@ -234,6 +235,12 @@ void unload_old_room() {
 	if (_G(displayed_room) < 0)
 		return;
 
+	_GP(spriteset).ClearPrefetch();
+	const SpriteCache::Stats &spr_stats = _GP(spriteset).GetStats();
+	Debug::Printf(kDbgGroup_SprCache, kDbgMsg_Info, "Sprites in room %d: prefetched %u (used %u), loaded on demand %u, decoding took %u ms",
+		_G(displayed_room), spr_stats.PrefetchLoads, spr_stats.PrefetchHits, spr_stats.SyncLoads, spr_stats.DecodeMs);
+	_GP(spriteset).ResetStats();
+
 	current_fade_out_effect();
 
 	// room unloaded callback
@@ -414,6 +421,48 @@ static void reset_temp_room() {
 	_GP(troom) = RoomStatus();
 }
 
+// Queues all frames of the given view loop for prefetch
+static void prefetch_view_loop(int view, int loop) {
+	if (view < 0 || view >= _GP(game).numviews)
+		return;
+	const ViewStruct &vs = _GP(views)[view];
+	if (loop < 0 || loop >= vs.numLoops)
+		return;
+	for (const auto &frame : vs.loops[loop].frames)
+		_GP(spriteset).PrefetchSprite(frame.pic);
+}
+
+// Queues the sprites which are likely to be displayed soon in the new room:
+// animations of the room objects and characters, and images of the GUI;
+// these are loaded in the background, during the idle frame time
+static void prefetch_room_sprites() {
+	for (uint32_t i = 0; i < _G(croom)->numobj; ++i) {
+		const RoomObject &obj = _G(objs)[i];
+		if (!obj.on)
+			continue;
+		_GP(spriteset).PrefetchSprite(obj.num);
+		if (obj.view != RoomObject::NoView)
+			prefetch_view_loop(obj.view, obj.loop);
+	}
+	for (int i = 0; i < _GP(game).numcharacters; ++i) {
+		const CharacterInfo &chi = _GP(game).chars[i];
+		if (chi.room != _G(displayed_room) || !chi.on)
+			continue;
+		prefetch_view_loop(chi.view, chi.loop);
+	}
+	for (const auto &gui : _GP(guis)) {
+		if (gui.IsDisplayed() && gui.BgImage > 0)
+			_GP(spriteset).PrefetchSprite(gui.BgImage);
+	}
+	for (const auto &but : _GP(guibuts)) {
+		if (but.ParentId < 0 || (size_t)but.ParentId >= _GP(guis).size() || !_GP(guis)[but.ParentId].IsDisplayed())
+			continue;
+		_GP(spriteset).PrefetchSprite(but.GetNormalImage());
+		_GP(spriteset).PrefetchSprite(but.GetMouseOverImage());
+		_GP(spriteset).PrefetchSprite(but.GetPushedImage());
+	}
+}
+
 // forchar = playerchar on NewRoom, or NULL if restore saved game
 void load_new_room(int newnum, CharacterInfo *forchar) {
 
@@ -865,6 +914,7 @@ void load_new_room(int newnum, CharacterInfo *forchar) {
 	update_polled_stuff();
 	debug_script_log("Now in room %d", _G(displayed_room));
 	GUI::MarkAllGUIForUpdate(true, true);
+	prefetch_room_sprites();
 	pl_run_plugin_hooks(AGSE_ENTERROOM, _G(displayed_room));
 }
 
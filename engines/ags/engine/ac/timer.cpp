@@ -23,6 +23,7 @@
 #include "ags/engine/ac/timer.h"
 #include "ags/shared/core/platform.h"
 #include "ags/engine/ac/sys_events.h"
+#include "ags/shared/ac/sprite_cache.h"
 #include "ags/engine/platform/base/ags_platform_driver.h"
 #include "ags/ags.h"
 #include "ags/globals.h"
@@ -81,6 +82,13 @@ void WaitForNextFrame() {
 
 	if (_G(next_frame_timestamp) > now) {
 		auto frame_time_remaining = _G(next_frame_timestamp) - now;
+		// Spend up to a half of the idle time on loading the sprites
+		// which are expected to be needed soon
+		if (_GP(spriteset).ProcessPrefetch(frame_time_remaining / 2) > 0) {
+			const auto after_prefetch = AGS_Clock::now();
+			frame_time_remaining = (_G(next_frame_timestamp) > after_prefetch) ?
+				_G(next_frame_timestamp) - after_prefetch : 0;
+		}
 		std::this_thread::sleep_for(frame_time_remaining);
 	}
 
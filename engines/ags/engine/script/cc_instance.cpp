@@ -542,6 +542,18 @@ inline bool FixupArgument(RuntimeScriptValue &arg, const int fixup, const uintpt
 	}
 }
 
+// Returns arg2 of the decoded operation with the fixup applied;
+// only fixups which depend on the execution state are applied here,
+// the rest were applied when the code was decoded.
+inline const RuntimeScriptValue *GetLiteralArg2(const ScriptCodeOp &op, const ScriptDecodedCode &dcode, RuntimeScriptValue *stack, RuntimeScriptValue &temp) {
+	if (op.ValueIndex >= 0)
+		return &dcode.Values[op.ValueIndex];
+	temp.SetInt32(op.Arg2i());
+	if (op.Fixup != FIXUP_NOFIXUP)
+		FixupArgument(temp, op.Fixup, static_cast<uintptr>(op.Arg2i()), stack, nullptr);
+	return &temp;
+}
+
 #define MAXNEST 50  // number of recursive function calls allowed
 int ccInstance::Run(int32_t curpc) {
 	pc = curpc;
@@ -560,7 +572,12 @@ int ccInstance::Run(int32_t curpc) {
 	thisbase[0] = 0;
 	funcstart[0] = pc;
 	ccInstance *codeInst = runningInst;
-	ScriptOperation codeOp;
+	if (!codeInst->decoded_code && !codeInst->CreateDecodedCode())
+		return -1;
+	// hold a reference, in case the instance gets freed by a nested call
+	const std::shared_ptr<ScriptDecodedCode> decodedCodeRef = codeInst->decoded_code;
+	const ScriptDecodedCode &decodedCode = *decodedCodeRef;
+	RuntimeScriptValue argTemp; // storage for the arguments fixed up at runtime
 	FunctionCallStack func_callstack;
 #if DEBUG_CC_EXEC
 	const bool dump_opcodes = (ccGetOption(SCOPT_DEBUGRUN) != 0) ||
@@ -583,47 +600,29 @@ int ccInstance::Run(int32_t curpc) {
 		//
 		/* Read operation */
 		//=====================================================================
-		codeOp.Instruction.Code         = codeInst->code[pc];
-		codeOp.Instruction.InstanceId   = (codeOp.Instruction.Code >> INSTANCE_ID_SHIFT) & INSTANCE_ID_MASK;
-		codeOp.Instruction.Code        &= INSTANCE_ID_REMOVEMASK; // now this is pure instruction code
-
-		CC_ERROR_IF_RETCODE((codeOp.Instruction.Code < 0 || codeOp.Instruction.Code >= CC_NUM_SCCMDS),
-							"invalid instruction %d found in code stream", codeOp.Instruction.Code);
-
-		codeOp.ArgCount = (*g_commands)[codeOp.Instruction.Code].ArgCount;
-
-		CC_ERROR_IF_RETCODE(pc + codeOp.ArgCount >= codeInst->codesize,
-							"unexpected end of code data (%d; %d)", pc + codeOp.ArgCount, codeInst->codesize);
-
-
-		// Read arguments; use switch as it proved to be faster than the loop
-
-		switch (codeOp.ArgCount) {
-		case 3:
-			codeOp.Args[2].SetInt32(static_cast<int32_t>(codeInst->code[pc + 3]));
-			/* fall-through */
-		case 2:
-			codeOp.Args[1].SetInt32(static_cast<int32_t>(codeInst->code[pc + 2]));
-			/* fall-through */
-		case 1:
-			codeOp.Args[0].SetInt32(static_cast<int32_t>(codeInst->code[pc + 1]));
-			break;
-		default:
-			break;
-		}
+		// The operation was decoded and validated when the instance was
+		// created; an invalid position gives the invalid code marker
+		const ScriptCodeOp &codeOp = decodedCode.GetOp(pc);
 		//---------------------------------------------------------------------
 		/* End read operation */
 		//=====================================================================
 
 #if (DEBUG_CC_EXEC)
 		if (dump_opcodes) {
-			DumpInstruction(codeOp);
+			ScriptOperation dumpOp;
+			dumpOp.Instruction = ScriptInstruction(codeOp.Code, codeOp.InstanceId);
+			dumpOp.ArgCount = codeOp.ArgCount;
+			for (int i = 0; i < codeOp.ArgCount; ++i)
+				dumpOp.Args[i].SetInt32(codeOp.Args[i]);
+			if (codeOp.ArgCount >= 2)
+				dumpOp.Args[1] = *GetLiteralArg2(codeOp, decodedCode, this->stack, argTemp);
+			DumpInstruction(dumpOp);
 		}
 #endif
 
 		/* Perform operation */
 		//=====================================================================
-		switch (codeOp.Instruction.Code) {
+		switch (codeOp.Code) {
 		case SCMD_LINENUM:
 			line_number = codeOp.Arg1i();
 			_G(currentline) = line_number;
@@ -692,9 +691,8 @@ int ccInstance::Run(int32_t curpc) {
 			// be only up to 4 bytes large;
 			// I guess that's an obsolete way to do WRITE, WRITEW and WRITEB
 			const auto arg_size = codeOp.Arg1i();
-			FixupArgument(codeOp.Args[1], codeInst->code_fixups[pc + 2], codeInst->code[pc + 2], this->stack, codeInst->strings);
+			const auto &arg_value = *GetLiteralArg2(codeOp, decodedCode, this->stack, argTemp);
 			ASSERT_CC_ERROR();
-			const auto &arg_value = codeOp.Arg2();
 			switch (arg_size) {
 			case sizeof(char):
 				registers[SREG_MAR].WriteByte(arg_value.IValue);
@@ -729,10 +727,8 @@ int ccInstance::Run(int32_t curpc) {
 		}
 		case SCMD_LITTOREG: {
 			auto &reg1 = registers[codeOp.Arg1i()];
-			FixupArgument(codeOp.Args[1], codeInst->code_fixups[pc + 2], codeInst->code[pc + 2], this->stack, codeInst->strings);
+			reg1 = *GetLiteralArg2(codeOp, decodedCode, this->stack, argTemp);
 			ASSERT_CC_ERROR();
-			const auto &arg_value = codeOp.Arg2();
-			reg1 = arg_value;
 			break;
 		}
 		case SCMD_MEMREAD: {
@@ -1158,7 +1154,7 @@ int ccInstance::Run(int32_t curpc) {
 			ccInstance *wasRunning = runningInst;
 
 			// extract the instance ID
-			int32_t instId = codeOp.Instruction.InstanceId;
+			int32_t instId = codeOp.InstanceId;
 			// determine the offset into the code of the instance we want
 			runningInst = _G(loadedInstances)[instId];
 			uintptr_t callAddr = reg1.PtrU8 - reinterpret_cast<uint8_t *>(&runningInst->code[0]);
@@ -1318,7 +1314,7 @@ int ccInstance::Run(int32_t curpc) {
 		case SCMD_NEWARRAY: {
 			auto &reg1 = registers[codeOp.Arg1i()];
 			const auto arg_elsize = codeOp.Arg2i();
-			const auto arg_managed = codeOp.Arg3().GetAsBool();
+			const auto arg_managed = (codeOp.Arg3i() != 0);
 			int numElements = reg1.IValue;
 			if (numElements < 1) {
 				cc_error("invalid size for dynamic array; requested: %d, range: 1..%d", numElements, INT32_MAX);
@@ -1458,7 +1454,11 @@ int ccInstance::Run(int32_t curpc) {
 				loopIterationCheckDisabled++;
 			break;
 		default:
-			cc_error("instruction %d is not implemented", codeOp.Instruction.Code);
+			// Only the invalid code marker is expected here
+			if ((pc >= 0) && (pc < codeInst->codesize))
+				cc_error("invalid instruction %d found in code stream at %d", static_cast<int32_t>(codeInst->code[pc] & INSTANCE_ID_REMOVEMASK), pc);
+			else
+				cc_error("code position %d is out of range (0; %d)", pc, codeInst->codesize);
 			return -1;
 		}
 		/* End perform operation */
@@ -1651,6 +1651,7 @@ bool ccInstance::_Create(PScript scri, const ccInstance *joined) {
 	if (joined) {
 		resolved_imports = joined->resolved_imports;
 		code_fixups = joined->code_fixups;
+		decoded_code = joined->decoded_code;
 	} else {
 		if (!CreateGlobalVars(scri.get())) {
 			return false;
@@ -1740,6 +1741,7 @@ void ccInstance::Free() {
 	}
 	resolved_imports = nullptr;
 	code_fixups = nullptr;
+	decoded_code.reset();
 }
 
 bool ccInstance::ResolveScriptImports(const ccScript *scri) {
@@ -1932,6 +1934,77 @@ bool ccInstance::CreateRuntimeCodeFixups(const ccScript *scri) {
 	return true;
 }
 
+bool ccInstance::CreateDecodedCode() {
+	std::shared_ptr<ScriptDecodedCode> dcode(new ScriptDecodedCode());
+	dcode->OpIndex.resize(codesize, -1);
+	for (int32_t ip = 0; ip < codesize;) {
+		// Stop at the first invalid instruction; the executor will
+		// report an error if it ever gets there
+		const int32_t code_op = static_cast<int32_t>(code[ip] & INSTANCE_ID_REMOVEMASK);
+		if (code_op <= 0 || code_op >= CC_NUM_SCCMDS)
+			break;
+		const int arg_count = (*g_commands)[code_op].ArgCount;
+		if (ip + arg_count >= codesize)
+			break;
+
+		ScriptCodeOp op;
+		op.Code = static_cast<uint8_t>(code_op);
+		op.InstanceId = static_cast<uint8_t>((code[ip] >> INSTANCE_ID_SHIFT) & INSTANCE_ID_MASK);
+		op.ArgCount = static_cast<uint8_t>(arg_count);
+		for (int i = 0; i < arg_count; ++i)
+			op.Args[i] = static_cast<int32_t>(code[ip + 1 + i]);
+
+		// Only arg2 of these operations may have a fixup, see Run()
+		if (code_op == SCMD_LITTOREG || code_op == SCMD_WRITELIT) {
+			const intptr_t arg = code[ip + 2];
+			RuntimeScriptValue value;
+			switch (code_fixups[ip + 2]) {
+			case FIXUP_NOFIXUP:
+			case FIXUP_FUNCTION:
+				// a plain literal, or a program counter value
+				break;
+			case FIXUP_GLOBALDATA:
+				value.SetGlobalVar(&reinterpret_cast<ScriptVariable *>(arg)->RValue);
+				op.ValueIndex = dcode->Values.size();
+				break;
+			case FIXUP_STRING:
+				value.SetStringLiteral(strings + arg);
+				op.ValueIndex = dcode->Values.size();
+				break;
+			case FIXUP_IMPORT: {
+				const ScriptImport *import = _GP(simp).getByIndex(static_cast<uint32_t>(arg));
+				if (import) {
+					value = import->Value;
+					op.ValueIndex = dcode->Values.size();
+				} else {
+					// let the executor report this, if it's ever run
+					op.Fixup = FIXUP_IMPORT;
+				}
+			}
+			break;
+			case FIXUP_STACK:
+				// depends on the stack contents at the time
+				op.Fixup = FIXUP_STACK;
+				break;
+			default:
+				cc_error("internal fixup type error: %d", code_fixups[ip + 2]);
+				return false;
+			}
+			if (op.ValueIndex >= 0)
+				dcode->Values.push_back(value);
+		}
+
+		dcode->OpIndex[ip] = dcode->Ops.size();
+		dcode->Ops.push_back(op);
+		ip += arg_count + 1;
+	}
+	// Invalid code marker, for positions which do not start an instruction
+	dcode->Ops.push_back(ScriptCodeOp());
+
+	decoded_code = dcode;
+	return true;
+}
+
 bool ccInstance::ResolveImportFixups(const ccScript *scri) {
 	for (int fixup_idx = 0; fixup_idx < scri->numfixups; ++fixup_idx) {
 		if (scri->fixuptypes[fixup_idx] != FIXUP_IMPORT)
@@ -1950,7 +2023,8 @@ bool ccInstance::ResolveImportFixups(const ccScript *scri) {
 		if (import->InstancePtr != nullptr && (code[fixup + 1] & INSTANCE_ID_REMOVEMASK) == SCMD_CALLEXT)
 			code[fixup + 1] = SCMD_CALLAS | (import->InstancePtr->loadedInstanceId << INSTANCE_ID_SHIFT);
 	}
-	return true;
+	// All the fixups are known now, prepare the code for the executor
+	return CreateDecodedCode();
 }
 
 void ccInstance::PushValueToStack(const RuntimeScriptValue &rval) {
@@ -24,6 +24,7 @@
 
 #include "common/std/memory.h"
 #include "common/std/map.h"
+#include "common/std/vector.h"
 #include "ags/engine/ac/timer.h"
 #include "ags/shared/script/cc_internal.h"
 #include "ags/shared/script/cc_script.h"  // ccScript
@@ -83,6 +84,44 @@ struct ScriptOperation {
 	inline int Arg3i() const { return Args[2].IValue; }
 };
 
+// Script operation, decoded from the bytecode in advance when the script
+// instance is prepared, so that the executor does not have to do that
+// each time the operation is run.
+struct ScriptCodeOp {
+	uint8_t Code = 0;           // pure instruction code; 0 marks invalid code
+	uint8_t InstanceId = 0;
+	uint8_t ArgCount = 0;
+	uint8_t Fixup = FIXUP_NOFIXUP; // fixup which has to be applied to arg2 at runtime
+	int32_t Args[MAX_SCMD_ARGS] = {};
+	// Index of the already fixed up arg2 in ScriptDecodedCode::Values, or -1
+	int32_t ValueIndex = -1;
+
+	// returns argN as a integer literal
+	inline int Arg1i() const { return Args[0]; }
+	inline int Arg2i() const { return Args[1]; }
+	inline int Arg3i() const { return Args[2]; }
+};
+
+// The script's bytecode in the decoded form; shared between the forks
+// of the script instance, same as the bytecode itself.
+struct ScriptDecodedCode {
+	// Decoded operations, in the order of the bytecode; the last one is
+	// always an invalid code marker
+	std::vector<ScriptCodeOp> Ops;
+	// Index of the operation starting at each bytecode position, or -1
+	std::vector<int32_t> OpIndex;
+	// Literal arguments with the fixups applied
+	std::vector<RuntimeScriptValue> Values;
+
+	// Returns operation starting at the given bytecode position,
+	// or the invalid code marker if there's none
+	inline const ScriptCodeOp &GetOp(int32_t pc) const {
+		if (pc >= 0 && pc < (int32_t)OpIndex.size() && OpIndex[pc] >= 0)
+			return Ops[OpIndex[pc]];
+		return Ops.back();
+	}
+};
+
 struct ScriptVariable {
 	ScriptVariable() {
 		ScAddress = -1; // address = 0 is valid one, -1 means undefined
@@ -154,6 +193,8 @@ public:
 	int  numimports;
 
 	char *code_fixups;
+	// bytecode decoded for the executor
+	std::shared_ptr<ScriptDecodedCode> decoded_code;
 
 	// returns the currently executing instance, or NULL if none
 	static ccInstance *GetCurrentInstance(void);
@@ -208,6 +249,9 @@ private:
 	bool    AddGlobalVar(const ScriptVariable &glvar);
 	ScriptVariable *FindGlobalVar(int32_t var_addr);
 	bool    CreateRuntimeCodeFixups(const ccScript *scri);
+	// Decodes the bytecode into the form used by the executor,
+	// applying all the fixups which do not depend on the execution state
+	bool    CreateDecodedCode();
 
 	// Begin executing script starting from the given bytecode index
 	int     Run(int32_t curpc);
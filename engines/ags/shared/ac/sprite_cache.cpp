@@ -47,6 +47,10 @@ using namespace AGS::Shared;
 #define SPRCACHEFLAG_ERROR	  0x04
 // Locked sprites are ones that should not be freed when out of cache space.
 #define SPRCACHEFLAG_LOCKED	  0x08
+// Tells that the sprite is waiting in the prefetch queue
+#define SPRCACHEFLAG_QUEUED	  0x10
+// Tells that the sprite was prefetched, and was not requested since
+#define SPRCACHEFLAG_PREFETCHED 0x20
 
 // High-verbosity sprite cache log
 #if DEBUG_SPRITECACHE
@@ -60,7 +64,7 @@ namespace Shared {
 
 SpriteCache::SpriteCache(std::vector<SpriteInfo> &sprInfos, const Callbacks &callbacks)
 	: _sprInfos(sprInfos), _maxCacheSize(DEFAULTCACHESIZE_KB * 1024u),
-	  _cacheSize(0u), _lockedSize(0u) {
+	  _cacheSize(0u), _lockedSize(0u), _prefetchPos(0u) {
 	_callbacks.AdjustSize = (callbacks.AdjustSize) ? callbacks.AdjustSize : DummyAdjustSize;
 	_callbacks.InitSprite = (callbacks.InitSprite) ? callbacks.InitSprite : DummyInitSprite;
 	_callbacks.PostInitSprite = (callbacks.PostInitSprite) ? callbacks.PostInitSprite : DummyPostInitSprite;
@@ -104,6 +108,8 @@ void SpriteCache::Reset() {
 	_file.Close();
 	_spriteData.clear();
 	_mru.clear();
+	_prefetchQueue.clear();
+	_prefetchPos = 0;
 	_cacheSize = 0;
 	_lockedSize = 0;
 }
@@ -227,11 +233,16 @@ Bitmap *SpriteCache::operator[](sprkey_t index) {
 		return _spriteData[index].Image.get();
 	// Either use ready image, or load one from assets
 	if (_spriteData[index].Image) {
+		if (_spriteData[index].Flags & SPRCACHEFLAG_PREFETCHED) {
+			_spriteData[index].Flags &= ~SPRCACHEFLAG_PREFETCHED;
+			_stats.PrefetchHits++;
+		}
 		// Move to the beginning of the MRU list
 		_mru.splice(_mru.begin(), _mru, _spriteData[index].MruIt);
 		return _spriteData[index].Image.get();
 	} else {
 		// Sprite exists in file but is not in mem, load it and add to MRU list
+		_stats.SyncLoads++;
 		if (LoadSprite(index)) {
 			_spriteData[index].MruIt = _mru.insert(_mru.begin(), index);
 			return _spriteData[index].Image.get();
@@ -364,8 +375,10 @@ size_t SpriteCache::LoadSprite(sprkey_t index, bool lock) {
 		return 0;
 	assert((_spriteData[index].Flags & SPRCACHEFLAG_ISASSET) != 0);
 
+	const uint32_t start_ms = g_system->getMillis();
 	Bitmap *image;
 	HError err = _file.LoadSprite(index, image);
+	_stats.DecodeMs += g_system->getMillis() - start_ms;
 	if (!image) {
 		Debug::Printf(kDbgGroup_SprCache, kDbgMsg_Warn,
 			"LoadSprite: failed to load sprite %d:\n%s\n - remapping to placeholder", index,
@@ -404,6 +417,66 @@ size_t SpriteCache::LoadSprite(sprkey_t index, bool lock) {
 	return size;
 }
 
+void SpriteCache::PrefetchSprite(sprkey_t index) {
+	if (index < 0 || (size_t)index >= _spriteData.size())
+		return;
+	SpriteData &spr = _spriteData[index];
+	if (!spr.IsAssetSprite() || spr.IsError() || spr.Image ||
+		(spr.Flags & SPRCACHEFLAG_QUEUED))
+		return; // not loadable, already loaded, or already in queue
+	spr.Flags |= SPRCACHEFLAG_QUEUED;
+	_prefetchQueue.push_back(index);
+}
+
+size_t SpriteCache::ProcessPrefetch(uint32_t max_ms) {
+	if (max_ms == 0 || _prefetchPos >= _prefetchQueue.size())
+		return 0;
+
+	const uint32_t start_ms = g_system->getMillis();
+	size_t loaded = 0;
+	while (_prefetchPos < _prefetchQueue.size()) {
+		const sprkey_t index = _prefetchQueue[_prefetchPos];
+		// The slot might have been changed since the sprite was queued
+		if ((size_t)index >= _spriteData.size() || !(_spriteData[index].Flags & SPRCACHEFLAG_QUEUED)) {
+			_prefetchPos++;
+			continue;
+		}
+		// Only use the free cache space; we don't know the sprite's color
+		// depth before it's loaded, so assume the largest one
+		const size_t max_size = _sprInfos[index].Width * _sprInfos[index].Height * 4;
+		if (_cacheSize + max_size >= _maxCacheSize) {
+			SprCacheLog("ProcessPrefetch: cache is full, dropping %zu requests", _prefetchQueue.size() - _prefetchPos);
+			ClearPrefetch();
+			break;
+		}
+
+		_spriteData[index].Flags &= ~SPRCACHEFLAG_QUEUED;
+		_prefetchPos++;
+		if (!_spriteData[index].Image && LoadSprite(index)) {
+			_spriteData[index].MruIt = _mru.insert(_mru.begin(), index);
+			_spriteData[index].Flags |= SPRCACHEFLAG_PREFETCHED;
+			_stats.PrefetchLoads++;
+			loaded++;
+		}
+		if (g_system->getMillis() - start_ms >= max_ms)
+			break;
+	}
+
+	if (_prefetchPos >= _prefetchQueue.size())
+		ClearPrefetch();
+	return loaded;
+}
+
+void SpriteCache::ClearPrefetch() {
+	for (; _prefetchPos < _prefetchQueue.size(); ++_prefetchPos) {
+		const sprkey_t index = _prefetchQueue[_prefetchPos];
+		if ((size_t)index < _spriteData.size())
+			_spriteData[index].Flags &= ~SPRCACHEFLAG_QUEUED;
+	}
+	_prefetchQueue.clear();
+	_prefetchPos = 0;
+}
+
 void SpriteCache::RemapSpriteToPlaceholder(sprkey_t index) {
 	assert((index > 0) && ((size_t)index < _spriteData.size()));
 	_sprInfos[index] = SpriteInfo(_placeholder->GetWidth(), _placeholder->GetHeight(), _placeholder->GetColorDepth());
@@ -95,6 +95,14 @@ public:
 		PfnPrewriteSprite PrewriteSprite;
 	};
 
+	// Sprite loading statistics
+	struct Stats {
+		uint32_t PrefetchLoads = 0; // sprites loaded ahead of time from the prefetch queue
+		uint32_t PrefetchHits = 0;  // prefetched sprites which were requested afterwards
+		uint32_t SyncLoads = 0;     // sprites loaded on demand, at the time of request
+		uint32_t DecodeMs = 0;      // total time spent reading and decoding sprites
+	};
+
 	SpriteCache(std::vector<SpriteInfo> &sprInfos, const Callbacks &callbacks);
 	~SpriteCache() = default;
 
@@ -175,6 +183,18 @@ public:
 	// Sets max cache size in bytes
 	void        SetMaxCacheSize(size_t size);
 
+	// Puts an asset sprite into the prefetch queue, unless it's already loaded
+	void        PrefetchSprite(sprkey_t index);
+	// Loads sprites from the prefetch queue until the queue is empty, or the
+	// given time runs out. Prefetching never disposes other sprites, so the
+	// queue is dropped once the cache is full. Returns number of loaded sprites.
+	size_t      ProcessPrefetch(uint32_t max_ms);
+	// Drops all the pending prefetch requests
+	void        ClearPrefetch();
+	// Returns sprite loading statistics
+	const Stats &GetStats() const { return _stats; }
+	void        ResetStats() { _stats = Stats(); }
+
 	// Loads (if it's not in cache yet) and returns bitmap by the sprite index
 	Bitmap *operator[](sprkey_t index);
 
@@ -245,6 +265,11 @@ private:
 	// that were last time used long ago.
 	std::list<sprkey_t> _mru;
 
+	// Sprites requested for prefetch, and the position of the next one to load
+	std::vector<sprkey_t> _prefetchQueue;
+	size_t _prefetchPos;
+
+	Stats _stats;
 };
 
 } // namespace Shared
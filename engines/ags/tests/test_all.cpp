@@ -27,6 +27,7 @@ namespace AGS3 {
 void Test_DoAllTests() {
 	Test_Math();
 	Test_Memory();
+	Test_Script();
 	// The commented out tests don't work right now (will fix, but that is not my problem right now) @eklipsed
 	//Test_Path();
 	Test_ScriptSprintf();
@@ -0,0 +1,119 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "ags/shared/core/platform.h"
+#include "common/scummsys.h"
+#include "common/debug.h"
+#include "common/std/chrono.h"
+#include "ags/shared/script/cc_internal.h"
+#include "ags/engine/script/cc_instance.h"
+
+namespace AGS3 {
+
+// Creates a script with the single "Bench" function, which runs a loop
+// reading a global variable, and returns the accumulated result
+static PScript CreateBenchScript(int iterations, int32_t global_value) {
+	static const int32_t bench_code[] = {
+		/* 0*/ SCMD_LOOPCHECKOFF,
+		/* 1*/ SCMD_LITTOREG, SREG_DX, 0,
+		/* 4*/ SCMD_LITTOREG, SREG_CX, 0, // iterations
+		// loop:
+		/* 7*/ SCMD_LINENUM, 1,
+		/* 9*/ SCMD_LITTOREG, SREG_MAR, 0, // global variable address
+		/*12*/ SCMD_MEMREAD, SREG_BX,
+		/*14*/ SCMD_ADDREG, SREG_DX, SREG_BX,
+		/*17*/ SCMD_ADD, SREG_DX, 1,
+		/*20*/ SCMD_SUB, SREG_CX, 1,
+		/*23*/ SCMD_REGTOREG, SREG_CX, SREG_AX,
+		/*26*/ SCMD_JZ, 2,    // to end
+		/*28*/ SCMD_JMP, -23, // to loop
+		// end:
+		/*30*/ SCMD_REGTOREG, SREG_DX, SREG_AX,
+		/*33*/ SCMD_RET
+	};
+
+	PScript scri(new ccScript());
+	scri->codesize = ARRAYSIZE(bench_code);
+	scri->code = (int32_t *)malloc(sizeof(bench_code));
+	memcpy(scri->code, bench_code, sizeof(bench_code));
+	scri->code[6] = iterations;
+
+	scri->globaldatasize = sizeof(int32_t);
+	scri->globaldata = (char *)malloc(scri->globaldatasize);
+	*(int32_t *)scri->globaldata = global_value;
+
+	scri->numfixups = 1;
+	scri->fixups = (int32_t *)malloc(sizeof(int32_t));
+	scri->fixuptypes = (char *)malloc(sizeof(char));
+	scri->fixups[0] = 11;
+	scri->fixuptypes[0] = FIXUP_GLOBALDATA;
+
+	// NOTE: ccScript frees exports along with the imports array
+	scri->imports = (char **)malloc(sizeof(char *));
+	scri->numexports = 1;
+	scri->exports = (char **)malloc(sizeof(char *));
+	scri->export_addr = (int32_t *)malloc(sizeof(int32_t));
+	scri->exports[0] = scumm_strdup("Bench");
+	scri->export_addr[0] = (EXPORT_FUNCTION << 24) | 0;
+	return scri;
+}
+
+static std::unique_ptr<ccInstance> CreateBenchInstance(int iterations, int32_t global_value) {
+	PScript scri = CreateBenchScript(iterations, global_value);
+	std::unique_ptr<ccInstance> inst = ccInstance::CreateFromScript(scri);
+	assert(inst);
+	bool resolved = inst->ResolveScriptImports(scri.get()) && inst->ResolveImportFixups(scri.get());
+	assert(resolved);
+	return inst;
+}
+
+static void Test_ScriptRun() {
+	std::unique_ptr<ccInstance> inst = CreateBenchInstance(100, 3);
+	int result = inst->CallScriptFunction("Bench", 0, nullptr);
+	assert(result == 0);
+	assert(inst->returnValue == 100 * (3 + 1));
+
+	// Forks share the decoded code, but run on their own
+	std::unique_ptr<ccInstance> fork = inst->Fork();
+	assert(fork);
+	result = fork->CallScriptFunction("Bench", 0, nullptr);
+	assert(result == 0);
+	assert(fork->returnValue == 100 * (3 + 1));
+}
+
+static void Test_ScriptSpeed() {
+	const int iterations = 1000000;
+	std::unique_ptr<ccInstance> inst = CreateBenchInstance(iterations, 1);
+	uint32 start = std::chrono::high_resolution_clock::now();
+	int result = inst->CallScriptFunction("Bench", 0, nullptr);
+	uint32 end = std::chrono::high_resolution_clock::now();
+	assert(result == 0 && inst->returnValue == iterations * 2);
+	debug("Script loop: %d iterations (%d ops) in %u ms\n", iterations, iterations * 9, end - start);
+}
+
+void Test_Script() {
+	Test_ScriptRun();
+#ifdef SLOW_TESTS
+	Test_ScriptSpeed();
+#endif
+}
+
+} // namespace AGS3
@@ -740,6 +740,7 @@ bool Actor::tick(bool forceDraw, Common::Rect *screenRect) {
 		assert(newFrame >= 0);
 
 		if (_animationId != newAnimation) {
+			_vm->_sliceAnimations->prefetchAnimation(newAnimation);
 			if (_fps != 0 && _fps != -1) {
 				_animationId = newAnimation;
 				setFPS(-2);
@@ -962,6 +963,11 @@ void Actor::setSetId(int setId) {
 	// _setId updated to new (arrived in) setId
 	_setId = setId;
 	_vm->_aiScripts->enteredSet(_id, _setId);
+	if (_vm->_scene && _setId == _vm->_scene->getSetId()) {
+		// Start loading the animation before the actor is first drawn
+		_vm->_sliceAnimations->prefetchFrame(_animationId, _animationFrame);
+		_vm->_sliceAnimations->prefetchAnimation(_animationId);
+	}
 	if (_setId > 0) {
 		for (i = 0; i < (int)_vm->_gameInfo->getActorCount(); ++i) {
 			if (_vm->_actors[i]->_id != _id && _vm->_actors[i]->_setId == _setId) {
@@ -1343,6 +1349,10 @@ int Actor::getAnimationId() const {
 	return _animationId;
 }
 
+int Actor::getAnimationFrame() const {
+	return _animationFrame;
+}
+
 void Actor::setGoal(int goalNumber) {
 	int oldGoalNumber = _goalNumber;
 	_goalNumber = goalNumber;
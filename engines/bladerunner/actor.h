@@ -135,6 +135,7 @@ public:
 	int getFacing() const;
 	int getAnimationMode() const;
 	int getAnimationId() const;
+	int getAnimationFrame() const;
 
 	Vector3 getPosition() const { return _position; }
 
@@ -1253,6 +1253,10 @@ void BladeRunnerEngine::gameTick() {
 
 	_sliceRenderer->setView(_view);
 
+	// Load some of the animation pages queued when the set changed, when actors
+	// entered it or changed animation, so that they don't have to be read while drawing
+	_sliceAnimations->prefetchPages(kPrefetchPagesPerTick);
+
 	// Tick and draw all actors in current set
 	int setId = _scene->getSetId();
 	for (int i = 0, end = _gameInfo->getActorCount(); i != end; ++i) {
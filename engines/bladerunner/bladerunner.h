@@ -116,6 +116,7 @@ public:
 	static const int kActorCount =  100;
 	static const int kActorVoiceOver = kActorCount - 1;
 	static const int kMaxCustomConcurrentRepeatableEvents = 20;
+	static const uint32 kPrefetchPagesPerTick = 4;
 
 	static const int16 kOriginalGameWidth  = 640;
 	static const int16 kOriginalGameHeight = 480;
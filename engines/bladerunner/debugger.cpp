@@ -43,6 +43,7 @@
 #include "bladerunner/item_pickup.h"
 #include "bladerunner/screen_effects.h"
 #include "bladerunner/settings.h"
+#include "bladerunner/slice_animations.h"
 #include "bladerunner/set.h"
 #include "bladerunner/set_effects.h"
 #include "bladerunner/text_resource.h"
@@ -146,6 +147,7 @@ Debugger::Debugger(BladeRunnerEngine *vm) : GUI::Debugger() {
 	registerCmd("playvqa", WRAP_METHOD(Debugger, cmdPlayVqa));
 	registerCmd("ammo", WRAP_METHOD(Debugger, cmdAmmo));
 	registerCmd("cheat", WRAP_METHOD(Debugger, cmdCheatReport));
+	registerCmd("pages", WRAP_METHOD(Debugger, cmdPages));
 #if BLADERUNNER_ORIGINAL_BUGS
 #else
 	registerCmd("effect", WRAP_METHOD(Debugger, cmdEffect));
@@ -3331,4 +3333,27 @@ bool Debugger::cmdCheatReport(int argc, const char** argv) {
 	return true;
 }
 
+bool Debugger::cmdPages(int argc, const char **argv) {
+	SliceAnimations *sliceAnimations = _vm->_sliceAnimations;
+
+	if (argc == 2 && !scumm_stricmp(argv[1], "reset")) {
+		sliceAnimations->resetStatistics();
+		debugPrintf("Animation page statistics reset\n");
+		return true;
+	}
+
+	if (argc != 1) {
+		debugPrintf("Show the animation page cache statistics, or reset them\n");
+		debugPrintf("Usage: %s [reset]\n", argv[0]);
+		return true;
+	}
+
+	debugPrintf("Loaded pages:     %u / %u\n", sliceAnimations->getLoadedPageCount(), sliceAnimations->getMaxLoadedPages());
+	debugPrintf("Queued pages:     %u\n", sliceAnimations->getQueuedPageCount());
+	debugPrintf("Page faults:      %u\n", sliceAnimations->getPageFaults());
+	debugPrintf("Prefetched pages: %u\n", sliceAnimations->getPrefetchedPages());
+	debugPrintf("Prefetch hits:    %u\n", sliceAnimations->getPrefetchHits());
+	return true;
+}
+
 } // End of namespace BladeRunner
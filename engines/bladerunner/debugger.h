@@ -137,6 +137,7 @@ public:
 	bool cmdPlayVqa(int argc, const char** argv);
 	bool cmdAmmo(int argc, const char** argv);
 	bool cmdCheatReport(int argc, const char** argv);
+	bool cmdPages(int argc, const char **argv);
 #if BLADERUNNER_ORIGINAL_BUGS
 #else
 	bool cmdEffect(int argc, const char **argv);
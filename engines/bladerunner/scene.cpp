@@ -34,6 +34,7 @@
 #include "bladerunner/screen_effects.h"
 #include "bladerunner/set.h"
 #include "bladerunner/settings.h"
+#include "bladerunner/slice_animations.h"
 #include "bladerunner/slice_renderer.h"
 #include "bladerunner/script/police_maze.h"
 #include "bladerunner/script/scene_script.h"
@@ -133,6 +134,8 @@ bool Scene::open(int setId, int sceneId, bool isLoadingGame) {
 
 	_vm->_sliceRenderer->setView(_vm->_view);
 
+	prefetchActorAnimations();
+
 	if ((setId == kSetMA02_MA04 || setId == kSetMA04)
 	    && sceneId == kSceneMA04) {
 		_vm->setExtraCNotify(0);
@@ -420,6 +423,25 @@ const Common::String &Scene::objectGetName(int objectId) {
 	return _set->objectGetName(objectId);
 }
 
+void Scene::prefetchActorAnimations() {
+	// Queue the animations of the actors in the set, so that they are loaded
+	// over the next ticks instead of when they are drawn. The current frames
+	// are queued first, as they are needed right away.
+	int actorCount = _vm->_gameInfo->getActorCount();
+	for (int i = 0; i != actorCount; ++i) {
+		const Actor *actor = _vm->_actors[i];
+		if (actor->getSetId() == _setId) {
+			_vm->_sliceAnimations->prefetchFrame(actor->getAnimationId(), actor->getAnimationFrame());
+		}
+	}
+	for (int i = 0; i != actorCount; ++i) {
+		const Actor *actor = _vm->_actors[i];
+		if (actor->getSetId() == _setId) {
+			_vm->_sliceAnimations->prefetchAnimation(actor->getAnimationId());
+		}
+	}
+}
+
 void Scene::loopEnded(int frame, int loopId) {
 	if (_specialLoopMode == kSceneLoopModeLoseControl || _specialLoopMode == kSceneLoopModeOnce || _specialLoopMode == kSceneLoopModeSpinner) {
 		if (_defaultLoopPreloadedSet) {
@@ -96,6 +96,7 @@ public:
 	void load(SaveFileReadStream &f);
 
 private:
+	void prefetchActorAnimations();
 	void loopEnded(int frame, int loopId);
 	static void loopEndedStatic(void *data, int frame, int loopId);
 };
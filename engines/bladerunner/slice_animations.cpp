@@ -30,6 +30,9 @@
 
 namespace BladeRunner {
 
+// Upper bound of the memory used by loaded pages, the oldest pages are freed first
+static const uint32 kMaxLoadedPagesSize = 64 * 1024 * 1024;
+
 bool SliceAnimations::open(const Common::String &name) {
 	Common::File file;
 	if (!file.open(_vm->getResourceStream(name), name))
@@ -80,6 +83,8 @@ bool SliceAnimations::open(const Common::String &name) {
 	for (uint32 i = 0; i != _pageCount; ++i)
 		_pages[i]._data = nullptr;
 
+	_maxLoadedPages = MAX<uint32>(kMaxLoadedPagesSize / MAX<uint32>(_pageSize, 1), 16);
+
 	return true;
 }
 
@@ -270,15 +275,14 @@ void *SliceAnimations::getFramePtr(uint32 animation, uint32 frame) {
 
 	if (page._data == nullptr) {                          // if not cached already
 		newPage = true;
-		page._data = _coreAnimPageFile.loadPage(pageId);    // look in COREANIM first
-
-		if (page._data == nullptr) {                      // if not in COREAMIM
-			page._data = _framesPageFile.loadPage(pageId);  // Look in CDFRAMES or HDFRAMES loaded data
-
-			if (page._data == nullptr) {
-				error("Unable to locate page %d for animation %d frame %d", pageId, animation, frame);
-			}
+		if (!loadPage(pageId)) {
+			error("Unable to locate page %d for animation %d frame %d", pageId, animation, frame);
 		}
+		++_pageFaults;
+		debugC(3, kDebugAnimation, "SliceAnimations::getFramePtr: page fault on page %d for animation %d frame %d", pageId, animation, frame);
+	} else if (page._prefetched) {
+		page._prefetched = false;
+		++_prefetchHits;
 	}
 
 	page._lastAccess = _vm->_time->currentSystem();
@@ -287,6 +291,106 @@ void *SliceAnimations::getFramePtr(uint32 animation, uint32 frame) {
 	return (byte *)page._data + pageOffset;
 }
 
+bool SliceAnimations::loadPage(uint32 pageId) {
+	Page &page = _pages[pageId];
+
+	page._data = _coreAnimPageFile.loadPage(pageId);    // look in COREANIM first
+
+	if (page._data == nullptr) {                      // if not in COREAMIM
+		page._data = _framesPageFile.loadPage(pageId);  // Look in CDFRAMES or HDFRAMES loaded data
+	}
+
+	if (page._data == nullptr) {
+		return false;
+	}
+
+	++_loadedPageCount;
+	return true;
+}
+
+void SliceAnimations::queuePage(uint32 pageId) {
+	if (pageId >= _pageCount) {
+		return;
+	}
+
+	Page &page = _pages[pageId];
+	if (page._data == nullptr && !page._queued) {
+		page._queued = true;
+		_prefetchQueue.push_back(pageId);
+	}
+}
+
+void SliceAnimations::prefetchAnimation(int animation) {
+	if (animation < 0 || animation >= (int)_animations.size() || _pageSize == 0) {
+		return;
+	}
+
+	const Animation &anim = _animations[animation];
+	if (anim.frameCount == 0 || anim.frameSize == 0) {
+		return;
+	}
+
+	uint32 firstPage = anim.offset / _pageSize;
+	uint32 lastPage  = (anim.offset + anim.frameCount * anim.frameSize - 1) / _pageSize;
+
+	for (uint32 pageId = firstPage; pageId <= lastPage; ++pageId) {
+		queuePage(pageId);
+	}
+}
+
+void SliceAnimations::prefetchFrame(int animation, int frame) {
+	if (animation < 0 || animation >= (int)_animations.size() || _pageSize == 0) {
+		return;
+	}
+
+	const Animation &anim = _animations[animation];
+	if (frame < 0 || (uint32)frame >= anim.frameCount) {
+		return;
+	}
+
+	queuePage((anim.offset + frame * anim.frameSize) / _pageSize);
+}
+
+uint32 SliceAnimations::prefetchPages(uint32 maxPages) {
+	uint32 loaded = 0;
+
+	while (loaded < maxPages && _prefetchQueueStart < _prefetchQueue.size()) {
+		uint32 pageId = _prefetchQueue[_prefetchQueueStart++];
+		Page &page = _pages[pageId];
+		page._queued = false;
+
+		// Already faulted in by getFramePtr()
+		if (page._data != nullptr) {
+			continue;
+		}
+
+		// Pages of animations on another CD are not available yet
+		if (!loadPage(pageId)) {
+			continue;
+		}
+
+		page._prefetched = true;
+		page._lastAccess = _vm->_time->currentSystem();
+		updatePagesList(page, true);
+
+		++_prefetchedPages;
+		++loaded;
+	}
+
+	if (_prefetchQueueStart == _prefetchQueue.size()) {
+		_prefetchQueue.clear();
+		_prefetchQueueStart = 0;
+	}
+
+	return loaded;
+}
+
+void SliceAnimations::resetStatistics() {
+	_pageFaults = 0;
+	_prefetchedPages = 0;
+	_prefetchHits = 0;
+}
+
 void SliceAnimations::updatePagesList(Page &page, bool newPage) {
 	// We are already at the end, nothing to update
 	// Only cleanup old pages if any
@@ -335,19 +439,15 @@ void SliceAnimations::cleanupOutdatedPages() {
 		return;
 	}
 
-	// If we are too young, no cleanup to do
-	// The counter will wrap in approx. 49 days
-	if (_lastUsedPage->_lastAccess < 60000) {
-		return;
-	}
-
-	// Keep all pages used in the last 60s
-	uint32 deadline = _lastUsedPage->_lastAccess - 60000;
+	uint32 now = _lastUsedPage->_lastAccess;
 
 	// _lastUsedPage->_nextNode is the oldest page in the list
 	Page *page = _lastUsedPage->_nextPage;
 	while(page != _lastUsedPage) {
-		if (page->_lastAccess >= deadline) {
+		// Keep all pages used in the last 60s, unless there are too many pages loaded
+		// The counter will wrap in approx. 49 days
+		bool outdated = now >= 60000 && page->_lastAccess < now - 60000;
+		if (!outdated && _loadedPageCount <= _maxLoadedPages) {
 			break;
 		}
 		Page *next = page->_nextPage;
@@ -362,6 +462,8 @@ void SliceAnimations::cleanupOutdatedPages() {
 		page->_lastAccess = 0;
 		page->_prevPage = nullptr;
 		page->_nextPage = nullptr;
+		page->_prefetched = false;
+		--_loadedPageCount;
 
 		page = next;
 	}
@@ -61,8 +61,10 @@ class SliceAnimations {
 		// Use a doubly linked list to sort pages by access time
 		Page   *_prevPage;
 		Page   *_nextPage;
+		bool    _queued;     // waiting in the prefetch queue
+		bool    _prefetched; // loaded by the prefetcher and not accessed since
 
-		Page() : _data(nullptr), _lastAccess(0), _prevPage(nullptr), _nextPage(nullptr) {}
+		Page() : _data(nullptr), _lastAccess(0), _prevPage(nullptr), _nextPage(nullptr), _queued(false), _prefetched(false) {}
 	};
 
 	struct PageFile {
@@ -94,6 +96,20 @@ class SliceAnimations {
 	PageFile _coreAnimPageFile;
 	PageFile _framesPageFile;
 
+	// Pages waiting to be loaded by prefetchPages(), oldest request first
+	Common::Array<uint32>       _prefetchQueue;
+	uint32                      _prefetchQueueStart;
+
+	uint32 _loadedPageCount;
+	uint32 _maxLoadedPages;
+
+	// Statistics
+	uint32 _pageFaults;      // pages loaded synchronously by getFramePtr()
+	uint32 _prefetchedPages; // pages loaded by prefetchPages()
+	uint32 _prefetchHits;    // prefetched pages later used by getFramePtr()
+
+	bool loadPage(uint32 pageId);
+	void queuePage(uint32 pageId);
 	void updatePagesList(Page &page, bool newPage);
 	void cleanupOutdatedPages();
 
@@ -106,7 +122,13 @@ public:
 		, _pageSize(0)
 		, _pageCount(0)
 		, _paletteCount(0)
-		, _lastUsedPage(nullptr) {}
+		, _lastUsedPage(nullptr)
+		, _prefetchQueueStart(0)
+		, _loadedPageCount(0)
+		, _maxLoadedPages(0)
+		, _pageFaults(0)
+		, _prefetchedPages(0)
+		, _prefetchHits(0) {}
 	~SliceAnimations();
 
 	bool open(const Common::String &name);
@@ -122,6 +144,21 @@ public:
 
 	Vector3 getPositionChange(int animation) const;
 	float   getFacingChange(int animation) const;
+
+	// Queue all pages of an animation that are not loaded yet
+	void prefetchAnimation(int animation);
+	// Queue the page of a single frame if it is not loaded yet
+	void prefetchFrame(int animation, int frame);
+	// Load up to maxPages queued pages, returns the number of pages loaded
+	uint32 prefetchPages(uint32 maxPages);
+
+	uint32 getLoadedPageCount() const { return _loadedPageCount; }
+	uint32 getMaxLoadedPages() const { return _maxLoadedPages; }
+	uint32 getQueuedPageCount() const { return _prefetchQueue.size() - _prefetchQueueStart; }
+	uint32 getPageFaults() const { return _pageFaults; }
+	uint32 getPrefetchedPages() const { return _prefetchedPages; }
+	uint32 getPrefetchHits() const { return _prefetchHits; }
+	void   resetStatistics();
 };
 
 } // End of namespace BladeRunner
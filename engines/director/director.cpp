@@ -93,6 +93,16 @@ DirectorEngine::DirectorEngine(OSystem *syst, const DirectorGameDescription *gam
 	_wmMode = 0;
 	_primitives = nullptr;
 
+	_inkSpanSIMD = nullptr;
+#ifdef SCUMMVM_NEON
+	if (g_system->hasFeature(OSystem::kFeatureCpuNEON))
+		_inkSpanSIMD = inkBlitSpanNEON;
+#endif
+#ifdef SCUMMVM_SSE2
+	if (g_system->hasFeature(OSystem::kFeatureCpuSSE2))
+		_inkSpanSIMD = inkBlitSpanSSE2;
+#endif
+
 	_wmWidth = 1024;
 	_wmHeight = 768;
 
@@ -131,6 +131,57 @@ struct PaletteV4 {
 	PaletteV4() : id(), palette(nullptr), length(0) {}
 };
 
+// Vectorized arithmetic and blend inks for rows of 32bpp pixels.
+// Returns the number of leading pixels processed, the caller does the rest.
+typedef int (*InkSpanSIMDFunc)(InkType ink, int alpha, uint32 *dst, const uint32 *src, int width, uint32 rgbMask, uint32 alphaMask);
+
+// The vectorized inks work on whole bytes, so they need 8 bits per colour channel
+inline bool getInkSIMDMasks(const Graphics::PixelFormat &format, uint32 &rgbMask, uint32 &alphaMask) {
+	if (format.bytesPerPixel != 4 || format.rLoss || format.gLoss || format.bLoss)
+		return false;
+	if ((format.rShift | format.gShift | format.bShift) & 7)
+		return false;
+
+	rgbMask = (0xffu << format.rShift) | (0xffu << format.gShift) | (0xffu << format.bShift);
+	alphaMask = format.RGBToColor(0, 0, 0);
+	return true;
+}
+
+// Applies an arithmetic ink, or the blend with the given alpha, to one colour
+// channel. Shared by the scalar inks of all depths, the vectorized inks must
+// give the same results.
+inline byte inkChannel(InkType ink, int alpha, byte src, byte dst) {
+	switch (ink) {
+	case kInkTypeBlend:
+		return lerpByte(src, dst, alpha, 255);
+	case kInkTypeAddPin:
+		// Add src to dst, but pinning each channel so it can't go above 0xff.
+		return dst + MIN(0xff - dst, (int)src);
+	case kInkTypeAdd:
+		// Add src to dst, allowing each channel to overflow and wrap around.
+		return dst + src;
+	case kInkTypeSubPin:
+		// Subtract src from dst, but pinning each channel so it can't go below 0x00.
+		return MAX(dst - src, 1) - 1;
+	case kInkTypeLight:
+		// Pick the higher of src and dst for each channel, lightening the image.
+		return MAX(src, dst);
+	case kInkTypeSub:
+		// Subtract src from dst, allowing each channel to underflow and wrap around.
+		return dst - src;
+	case kInkTypeDark:
+		// Pick the lower of src and dst for each channel, darkening the image.
+		return MIN(src, dst);
+	default:
+		return dst;
+	}
+}
+
+// graphics_sse2.cpp
+int inkBlitSpanSSE2(InkType ink, int alpha, uint32 *dst, const uint32 *src, int width, uint32 rgbMask, uint32 alphaMask);
+// graphics_neon.cpp
+int inkBlitSpanNEON(InkType ink, int alpha, uint32 *dst, const uint32 *src, int width, uint32 rgbMask, uint32 alphaMask);
+
 struct MacShape {
 	InkType ink;
 	byte spriteType;
@@ -222,6 +273,7 @@ public:
 	void draw();
 
 	Graphics::Primitives *getInkPrimitives();
+	InkSpanSIMDFunc getInkSpanSIMD() const { return _inkSpanSIMD; }
 	uint32 getColorBlack();
 	uint32 getColorWhite();
 
@@ -330,6 +382,7 @@ private:
 
 	Graphics::ManagedSurface *_surface;
 	Graphics::Primitives *_primitives;
+	InkSpanSIMDFunc _inkSpanSIMD;
 
 	StartOptions _options;
 
@@ -374,6 +427,7 @@ struct DirectorPlotData {
 	uint32 preprocessColor(uint32 src);
 	void inkBlitShape(Common::Rect &srcRect);
 	void inkBlitSurface(Common::Rect &srcRect, const Graphics::Surface *mask);
+	void inkBlitPoints(Common::Rect &srcRect, const Graphics::Surface *mask, bool &failedBoundsCheck);
 
 	DirectorPlotData(DirectorEngine *d_, SpriteType s, InkType i, int a, uint32 b, uint32 f) : d(d_), sprite(s), ink(i), alpha(a), backColor(b), foreColor(f) {
 		colorWhite = d->_wm->_colorWhite;
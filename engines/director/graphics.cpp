@@ -284,77 +284,23 @@ void DirectorEngine::draw() {
 	g_system->updateScreen();
 }
 
+// Sprite blend does not respect colourization; defaults to matte ink
 template <typename T>
-class InkPrimitives final : public Graphics::Primitives {
-public:
-	constexpr InkPrimitives() {}
-	void drawPoint(int x, int y, uint32 src, void *data) override;
-};
-
-template <typename T>
-void InkPrimitives<T>::drawPoint(int x, int y, uint32 src, void *data) {
-	DirectorPlotData *p = (DirectorPlotData *)data;
-	Graphics::MacWindowManager *wm = p->d->_wm;
-
-	if (!p->destRect.contains(x, y))
-		return;
-
-
-	T *dst;
-	uint32 tmpDst;
-
-	dst = (T *)p->dst->getBasePtr(x, y);
-
-	if (p->ms) {
-		if (p->ms->pd->thickness > 1) {
-			int prevThickness = p->ms->pd->thickness;
-			int x1 = x;
-			int x2 = x1 + prevThickness;
-			int y1 = y;
-			int y2 = y1 + prevThickness;
-
-			p->ms->pd->thickness = 1;	// We do not want recursive loops
-
-			for (y = y1; y < y2; y++)
-				for (x = x1; x < x2; x++)
-					if (x >= 0 && x < p->ms->pd->surface->w && y >= 0 && y < p->ms->pd->surface->h) {
-						drawPoint(x, y, src, data);
-					}
-
-			p->ms->pd->thickness = prevThickness;
-			return;
-		}
-
-		if (p->ms->tile) {
-			int x1 = p->ms->tileRect->left + (p->ms->pd->fillOriginX + x) % p->ms->tileRect->width();
-			int y1 = p->ms->tileRect->top  + (p->ms->pd->fillOriginY + y) % p->ms->tileRect->height();
-
-			src = p->ms->tile->_surface.getPixel(x1, y1);
-		} else {
-			// Get the pixel that macDrawPixel will give us, but store it to apply the
-			// ink later
-			tmpDst = *dst;
-			wm->getDrawPrimitives().drawPoint(x, y, src, p->ms->pd);
-			src = *dst;
+static inline void inkBlendPixel(DirectorPlotData *p, Graphics::MacWindowManager *wm, T *dst, uint32 src) {
+	byte rSrc, gSrc, bSrc;
+	byte rDst, gDst, bDst;
 
-			*dst = tmpDst;
-		}
-	} else if (p->alpha) {
-		// Sprite blend does not respect colourization; defaults to matte ink
-		byte rSrc, gSrc, bSrc;
-		byte rDst, gDst, bDst;
+	wm->decomposeColor<T>(src, rSrc, gSrc, bSrc);
+	wm->decomposeColor<T>(*dst, rDst, gDst, bDst);
 
-		wm->decomposeColor<T>(src, rSrc, gSrc, bSrc);
-		wm->decomposeColor<T>(*dst, rDst, gDst, bDst);
-
-		rDst = lerpByte(rSrc, rDst, p->alpha, 255);
-		gDst = lerpByte(gSrc, gDst, p->alpha, 255);
-		bDst = lerpByte(bSrc, bDst, p->alpha, 255);
-		*dst = wm->findBestColor(rDst, gDst, bDst);
-		return;
-	}
+	*dst = wm->findBestColor(inkChannel(kInkTypeBlend, p->alpha, rSrc, rDst), inkChannel(kInkTypeBlend, p->alpha, gSrc, gDst), inkChannel(kInkTypeBlend, p->alpha, bSrc, bDst));
+}
 
- 	switch (p->ink) {
+// Applies the ink to a single pixel. When inlined with a constant ink,
+// the switch is folded away, which the span blitters below rely on.
+template <typename T>
+static inline void inkDrawPixel(DirectorPlotData *p, Graphics::MacWindowManager *wm, T *dst, uint32 src, InkType ink) {
+	switch (ink) {
 	case kInkTypeBackgndTrans:
 		if (p->oneBitImage) {
 			// One-bit images have a slightly different rendering algorithm for BackgndTrans.
@@ -482,30 +428,14 @@ void InkPrimitives<T>::drawPoint(int x, int y, uint32 src, void *data) {
 		wm->decomposeColor<T>(src, rSrc, gSrc, bSrc);
 		wm->decomposeColor<T>(*dst, rDst, gDst, bDst);
 
-		switch (p->ink) {
+		switch (ink) {
 		case kInkTypeAddPin:
-			// Add src to dst, but pinning each channel so it can't go above 0xff.
-			*dst = wm->findBestColor(rDst + MIN(0xff - rDst, (int)rSrc), gDst + MIN(0xff - gDst, (int)gSrc), bDst + MIN(0xff - bDst, (int)bSrc));
-			break;
 		case kInkTypeAdd:
-			// Add src to dst, allowing each channel to overflow and wrap around.
-			*dst = wm->findBestColor(rDst + rSrc, gDst + gSrc, bDst + bSrc);
-			break;
 		case kInkTypeSubPin:
-			// Subtract src from dst, but pinning each channel so it can't go below 0x00.
-			*dst = wm->findBestColor(MAX(rDst - rSrc, 1) - 1, MAX(gDst - gSrc, 1) - 1, MAX(bDst - bSrc, 1) - 1);
-			break;
 		case kInkTypeLight:
-			// Pick the higher of src and dst for each channel, lightening the image.
-			*dst = wm->findBestColor(MAX(rSrc, rDst), MAX(gSrc, gDst), MAX(bSrc, bDst));
-			break;
 		case kInkTypeSub:
-			// Subtract src from dst, allowing each channel to underflow and wrap around.
-			*dst = wm->findBestColor(rDst - rSrc, gDst - gSrc, bDst - bSrc);
-			break;
 		case kInkTypeDark:
-			// Pick the lower of src and dst for each channel, darkening the image.
-			*dst = wm->findBestColor(MIN(rSrc, rDst), MIN(gSrc, gDst), MIN(bSrc, bDst));
+			*dst = wm->findBestColor(inkChannel(ink, 0, rSrc, rDst), inkChannel(ink, 0, gSrc, gDst), inkChannel(ink, 0, bSrc, bDst));
 			break;
 		default:
 			break;
@@ -514,6 +444,184 @@ void InkPrimitives<T>::drawPoint(int x, int y, uint32 src, void *data) {
 	}
 }
 
+template <typename T>
+class InkPrimitives final : public Graphics::Primitives {
+public:
+	constexpr InkPrimitives() {}
+	void drawPoint(int x, int y, uint32 src, void *data) override;
+};
+
+template <typename T>
+void InkPrimitives<T>::drawPoint(int x, int y, uint32 src, void *data) {
+	DirectorPlotData *p = (DirectorPlotData *)data;
+	Graphics::MacWindowManager *wm = p->d->_wm;
+
+	if (!p->destRect.contains(x, y))
+		return;
+
+
+	T *dst;
+	uint32 tmpDst;
+
+	dst = (T *)p->dst->getBasePtr(x, y);
+
+	if (p->ms) {
+		if (p->ms->pd->thickness > 1) {
+			int prevThickness = p->ms->pd->thickness;
+			int x1 = x;
+			int x2 = x1 + prevThickness;
+			int y1 = y;
+			int y2 = y1 + prevThickness;
+
+			p->ms->pd->thickness = 1;	// We do not want recursive loops
+
+			for (y = y1; y < y2; y++)
+				for (x = x1; x < x2; x++)
+					if (x >= 0 && x < p->ms->pd->surface->w && y >= 0 && y < p->ms->pd->surface->h) {
+						drawPoint(x, y, src, data);
+					}
+
+			p->ms->pd->thickness = prevThickness;
+			return;
+		}
+
+		if (p->ms->tile) {
+			int x1 = p->ms->tileRect->left + (p->ms->pd->fillOriginX + x) % p->ms->tileRect->width();
+			int y1 = p->ms->tileRect->top  + (p->ms->pd->fillOriginY + y) % p->ms->tileRect->height();
+
+			src = p->ms->tile->_surface.getPixel(x1, y1);
+		} else {
+			// Get the pixel that macDrawPixel will give us, but store it to apply the
+			// ink later
+			tmpDst = *dst;
+			wm->getDrawPrimitives().drawPoint(x, y, src, p->ms->pd);
+			src = *dst;
+
+			*dst = tmpDst;
+		}
+	} else if (p->alpha) {
+		inkBlendPixel<T>(p, wm, dst, src);
+		return;
+	}
+
+	inkDrawPixel<T>(p, wm, dst, src, p->ink);
+}
+
+
+// Row blitters for bitmap sprites. Every ink gets its own instantiation of the
+// pixel loop, so the ink is dispatched once per blit rather than per pixel.
+template <typename T>
+struct InkSpan {
+	typedef void (*Func)(DirectorPlotData *p, T *dst, const T *src, const byte *msk, int width);
+
+	template <InkType INK>
+	static void blit(DirectorPlotData *p, T *dst, const T *src, const byte *msk, int width) {
+		Graphics::MacWindowManager *wm = p->d->_wm;
+		for (int j = 0; j < width; j++) {
+			if (!msk || msk[j])
+				inkDrawPixel<T>(p, wm, &dst[j], src[j], INK);
+		}
+	}
+
+	static void blitBlend(DirectorPlotData *p, T *dst, const T *src, const byte *msk, int width) {
+		Graphics::MacWindowManager *wm = p->d->_wm;
+		for (int j = 0; j < width; j++) {
+			if (!msk || msk[j])
+				inkBlendPixel<T>(p, wm, &dst[j], src[j]);
+		}
+	}
+
+	// Same as drawPoint(), used for the sprites which need their colours adjusted
+	static void blitGeneric(DirectorPlotData *p, T *dst, const T *src, const byte *msk, int width) {
+		Graphics::MacWindowManager *wm = p->d->_wm;
+		for (int j = 0; j < width; j++) {
+			if (msk && !msk[j])
+				continue;
+
+			uint32 color = p->preprocessColor(src[j]);
+			if (p->alpha)
+				inkBlendPixel<T>(p, wm, &dst[j], color);
+			else
+				inkDrawPixel<T>(p, wm, &dst[j], color, p->ink);
+		}
+	}
+
+	static Func get(DirectorPlotData *p, bool preprocess) {
+		if (preprocess)
+			return blitGeneric;
+		if (p->alpha)
+			return blitBlend;
+
+		switch (p->ink) {
+		case kInkTypeCopy:			return blit<kInkTypeCopy>;
+		case kInkTypeTransparent:	return blit<kInkTypeTransparent>;
+		case kInkTypeReverse:		return blit<kInkTypeReverse>;
+		case kInkTypeGhost:			return blit<kInkTypeGhost>;
+		case kInkTypeNotCopy:		return blit<kInkTypeNotCopy>;
+		case kInkTypeNotTrans:		return blit<kInkTypeNotTrans>;
+		case kInkTypeNotReverse:	return blit<kInkTypeNotReverse>;
+		case kInkTypeNotGhost:		return blit<kInkTypeNotGhost>;
+		case kInkTypeMatte:			return blit<kInkTypeMatte>;
+		case kInkTypeMask:			return blit<kInkTypeMask>;
+		case kInkTypeBlend:			return blit<kInkTypeBlend>;
+		case kInkTypeAddPin:		return blit<kInkTypeAddPin>;
+		case kInkTypeAdd:			return blit<kInkTypeAdd>;
+		case kInkTypeSubPin:		return blit<kInkTypeSubPin>;
+		case kInkTypeBackgndTrans:	return blit<kInkTypeBackgndTrans>;
+		case kInkTypeLight:			return blit<kInkTypeLight>;
+		case kInkTypeSub:			return blit<kInkTypeSub>;
+		case kInkTypeDark:			return blit<kInkTypeDark>;
+		default:
+			return blitGeneric;
+		}
+	}
+};
+
+// Blits the surface row by row, clipped against the source surface.
+// Returns false if any part of the destination rect was out of bounds.
+template <typename T>
+static bool inkBlitSpans(DirectorPlotData *p, const Common::Rect &srcRect, const Graphics::Surface *mask) {
+	const Common::Rect &destRect = p->destRect;
+	const int srcX = abs(srcRect.left - destRect.left);
+	const int srcY = abs(srcRect.top - destRect.top);
+	const int width = MIN<int>(destRect.width(), p->srf->w - srcX);
+	const int height = MIN<int>(destRect.height(), p->srf->h - srcY);
+
+	if (width > 0 && height > 0) {
+		SpriteType sprite = p->sprite;
+		bool preprocess = (sprite == kTextSprite || sprite == kButtonSprite || sprite == kCheckboxSprite || sprite == kRadioButtonSprite);
+		typename InkSpan<T>::Func span = InkSpan<T>::get(p, preprocess);
+
+		// Arithmetic and blend inks in 32bpp can be done on several pixels at once
+		InkSpanSIMDFunc simd = nullptr;
+		InkType simdInk = p->alpha ? kInkTypeBlend : p->ink;
+		int simdAlpha = CLIP<int>(p->alpha, 0, 255);
+		uint32 rgbMask = 0, alphaMask = 0;
+		if (sizeof(T) == 4 && !preprocess && !mask && !p->srfMask &&
+				(p->alpha || (p->ink >= kInkTypeAddPin && p->ink <= kInkTypeDark && p->ink != kInkTypeBackgndTrans)) &&
+				getInkSIMDMasks(p->d->_wm->_pixelformat, rgbMask, alphaMask))
+			simd = p->d->getInkSpanSIMD();
+
+		for (int i = 0; i < height; i++) {
+			T *dst = (T *)p->dst->getBasePtr(destRect.left, destRect.top + i);
+			const T *src = (const T *)p->srf->getBasePtr(srcX, srcY + i);
+			const byte *msk = nullptr;
+			if (p->srfMask)
+				msk = (const byte *)p->srfMask->getBasePtr(srcX, srcY + i);
+			else if (mask)
+				msk = (const byte *)mask->getBasePtr(srcX, srcY + i);
+
+			int done = 0;
+			if (simd)
+				done = simd(simdInk, simdAlpha, (uint32 *)dst, (const uint32 *)src, width, rgbMask, alphaMask);
+			if (done < width)
+				span(p, dst + done, src + done, msk, width - done);
+		}
+	}
+
+	return destRect.isEmpty() || (width >= destRect.width() && height >= destRect.height());
+}
+
 Graphics::Primitives *DirectorEngine::getInkPrimitives() {
 	if (!_primitives) {
 		if (_pixelformat.bytesPerPixel == 1)
@@ -750,6 +858,25 @@ void DirectorPlotData::inkBlitSurface(Common::Rect &srcRect, const Graphics::Sur
 	// format as the window manager. Most of the time this is
 	// the job of BitmapCastMember::createWidget.
 
+	if (!ms) {
+		if (d->_wm->_pixelformat.bytesPerPixel == 1)
+			failedBoundsCheck = !inkBlitSpans<byte>(this, srcRect, mask);
+		else
+			failedBoundsCheck = !inkBlitSpans<uint32>(this, srcRect, mask);
+	} else {
+		inkBlitPoints(srcRect, mask, failedBoundsCheck);
+	}
+
+	if (failedBoundsCheck) {
+		warning("DirectorPlotData::inkBlitSurface: Out of bounds - srfClip: %d,%d,%d,%d, srcRect: %d,%d,%d,%d, dstRect: %d,%d,%d,%d",
+				srfClip.left, srfClip.top, srfClip.right, srfClip.bottom,
+				srcRect.left, srcRect.top, srcRect.right, srcRect.bottom,
+				destRect.left, destRect.top, destRect.right, destRect.bottom);
+	}
+}
+
+void DirectorPlotData::inkBlitPoints(Common::Rect &srcRect, const Graphics::Surface *mask, bool &failedBoundsCheck) {
+	Common::Rect srfClip = srf->getBounds();
 	Graphics::Primitives *primitives = g_director->getInkPrimitives();
 
 	srcPoint.y = abs(srcRect.top - destRect.top);
@@ -777,14 +904,6 @@ void DirectorPlotData::inkBlitSurface(Common::Rect &srcRect, const Graphics::Sur
 			}
 		}
 	}
-
-	if (failedBoundsCheck) {
-		warning("DirectorPlotData::inkBlitSurface: Out of bounds - srfClip: %d,%d,%d,%d, srcRect: %d,%d,%d,%d, dstRect: %d,%d,%d,%d",
-				srfClip.left, srfClip.top, srfClip.right, srfClip.bottom,
-				srcRect.left, srcRect.top, srcRect.right, srcRect.bottom,
-				destRect.left, destRect.top, destRect.right, destRect.bottom);
-	}
-
 }
 
 } // End of namespace Director
@@ -0,0 +1,128 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+// Without this ifdef the iOS backend breaks
+#ifdef SCUMMVM_NEON
+
+#include "director/director.h"
+
+#include <arm_neon.h>
+
+#if !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("neon"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("fpu=neon")
+#endif
+
+#endif // !defined(__aarch64__) && !defined(__ARM_NEON)
+
+namespace Director {
+
+// Computes lerpByte(src, dst, alpha, 255) on eight channels.
+// (x + 1 + (x >> 8)) >> 8 is x / 255 for every x up to 255 * 255.
+static inline uint8x8_t blendNEON(uint8x8_t d, uint8x8_t s, uint8x8_t alpha, uint8x8_t invAlpha) {
+	uint16x8_t x = vmlal_u8(vmull_u8(d, alpha), s, invAlpha);
+	return vmovn_u16(vshrq_n_u16(vaddq_u16(x, vsraq_n_u16(vdupq_n_u16(1), x, 8)), 8));
+}
+
+template <InkType INK>
+static inline uint8x16_t inkPixelsNEON(uint8x16_t d, uint8x16_t s, uint8x8_t alpha, uint8x8_t invAlpha) {
+	switch (INK) {
+	case kInkTypeAddPin:
+		return vqaddq_u8(d, s);
+	case kInkTypeAdd:
+		return vaddq_u8(d, s);
+	case kInkTypeSubPin:
+		// MAX(dst - src, 1) - 1
+		return vqsubq_u8(vqsubq_u8(d, s), vdupq_n_u8(1));
+	case kInkTypeSub:
+		return vsubq_u8(d, s);
+	case kInkTypeLight:
+		return vmaxq_u8(d, s);
+	case kInkTypeDark:
+		return vminq_u8(d, s);
+	case kInkTypeBlend:
+		return vcombine_u8(blendNEON(vget_low_u8(d), vget_low_u8(s), alpha, invAlpha),
+		                   blendNEON(vget_high_u8(d), vget_high_u8(s), alpha, invAlpha));
+	default:
+		return d;
+	}
+}
+
+template <InkType INK>
+static int inkSpanNEON(int alpha, uint32 *dst, const uint32 *src, int width, uint32 rgbMask, uint32 alphaMask) {
+	const uint32x4_t rgb = vdupq_n_u32(rgbMask);
+	const uint32x4_t alphaBits = vdupq_n_u32(alphaMask);
+	const uint8x8_t blendAlpha = vdup_n_u8(alpha);
+	const uint8x8_t blendInvAlpha = vdup_n_u8(255 - alpha);
+
+	int j = 0;
+	for (; j + 4 <= width; j += 4) {
+		uint8x16_t d = vreinterpretq_u8_u32(vld1q_u32(dst + j));
+		uint8x16_t s = vreinterpretq_u8_u32(vld1q_u32(src + j));
+		uint32x4_t r = vreinterpretq_u32_u8(inkPixelsNEON<INK>(d, s, blendAlpha, blendInvAlpha));
+
+		// Like findBestColor(), the result has the alpha channel set to opaque
+		vst1q_u32(dst + j, vorrq_u32(vandq_u32(r, rgb), alphaBits));
+	}
+
+	return j;
+}
+
+int inkBlitSpanNEON(InkType ink, int alpha, uint32 *dst, const uint32 *src, int width, uint32 rgbMask, uint32 alphaMask) {
+	switch (ink) {
+	case kInkTypeAddPin:
+		return inkSpanNEON<kInkTypeAddPin>(alpha, dst, src, width, rgbMask, alphaMask);
+	case kInkTypeAdd:
+		return inkSpanNEON<kInkTypeAdd>(alpha, dst, src, width, rgbMask, alphaMask);
+	case kInkTypeSubPin:
+		return inkSpanNEON<kInkTypeSubPin>(alpha, dst, src, width, rgbMask, alphaMask);
+	case kInkTypeSub:
+		return inkSpanNEON<kInkTypeSub>(alpha, dst, src, width, rgbMask, alphaMask);
+	case kInkTypeLight:
+		return inkSpanNEON<kInkTypeLight>(alpha, dst, src, width, rgbMask, alphaMask);
+	case kInkTypeDark:
+		return inkSpanNEON<kInkTypeDark>(alpha, dst, src, width, rgbMask, alphaMask);
+	case kInkTypeBlend:
+		return inkSpanNEON<kInkTypeBlend>(alpha, dst, src, width, rgbMask, alphaMask);
+	default:
+		return 0;
+	}
+}
+
+} // End of namespace Director
+
+#if !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#endif // SCUMMVM_NEON
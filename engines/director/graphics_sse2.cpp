@@ -0,0 +1,129 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#include "director/director.h"
+
+#include <emmintrin.h>
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("sse2"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("sse2")
+#endif
+
+#endif // !defined(__x86_64__)
+
+namespace Director {
+
+// Computes lerpByte(src, dst, alpha, 255) on eight 16-bit channels.
+// (x * 0x8081) >> 23 is x / 255 for every x that fits in 16 bits.
+static inline __m128i blendSSE2(__m128i d, __m128i s, __m128i alpha, __m128i invAlpha) {
+	const __m128i div255 = _mm_set1_epi16((short)0x8081);
+
+	__m128i x = _mm_add_epi16(_mm_mullo_epi16(d, alpha), _mm_mullo_epi16(s, invAlpha));
+	return _mm_srli_epi16(_mm_mulhi_epu16(x, div255), 7);
+}
+
+template <InkType INK>
+static inline __m128i inkPixelsSSE2(__m128i d, __m128i s, __m128i alpha, __m128i invAlpha) {
+	const __m128i zero = _mm_setzero_si128();
+
+	switch (INK) {
+	case kInkTypeAddPin:
+		return _mm_adds_epu8(d, s);
+	case kInkTypeAdd:
+		return _mm_add_epi8(d, s);
+	case kInkTypeSubPin:
+		// MAX(dst - src, 1) - 1
+		return _mm_subs_epu8(_mm_subs_epu8(d, s), _mm_set1_epi8(1));
+	case kInkTypeSub:
+		return _mm_sub_epi8(d, s);
+	case kInkTypeLight:
+		return _mm_max_epu8(d, s);
+	case kInkTypeDark:
+		return _mm_min_epu8(d, s);
+	case kInkTypeBlend: {
+		__m128i lo = blendSSE2(_mm_unpacklo_epi8(d, zero), _mm_unpacklo_epi8(s, zero), alpha, invAlpha);
+		__m128i hi = blendSSE2(_mm_unpackhi_epi8(d, zero), _mm_unpackhi_epi8(s, zero), alpha, invAlpha);
+		return _mm_packus_epi16(lo, hi);
+	}
+	default:
+		return d;
+	}
+}
+
+template <InkType INK>
+static int inkSpanSSE2(int alpha, uint32 *dst, const uint32 *src, int width, uint32 rgbMask, uint32 alphaMask) {
+	const __m128i rgb = _mm_set1_epi32(rgbMask);
+	const __m128i alphaBits = _mm_set1_epi32(alphaMask);
+	const __m128i blendAlpha = _mm_set1_epi16(alpha);
+	const __m128i blendInvAlpha = _mm_set1_epi16(255 - alpha);
+
+	int j = 0;
+	for (; j + 4 <= width; j += 4) {
+		__m128i d = _mm_loadu_si128((const __m128i *)(dst + j));
+		__m128i s = _mm_loadu_si128((const __m128i *)(src + j));
+		__m128i r = inkPixelsSSE2<INK>(d, s, blendAlpha, blendInvAlpha);
+
+		// Like findBestColor(), the result has the alpha channel set to opaque
+		_mm_storeu_si128((__m128i *)(dst + j), _mm_or_si128(_mm_and_si128(r, rgb), alphaBits));
+	}
+
+	return j;
+}
+
+int inkBlitSpanSSE2(InkType ink, int alpha, uint32 *dst, const uint32 *src, int width, uint32 rgbMask, uint32 alphaMask) {
+	switch (ink) {
+	case kInkTypeAddPin:
+		return inkSpanSSE2<kInkTypeAddPin>(alpha, dst, src, width, rgbMask, alphaMask);
+	case kInkTypeAdd:
+		return inkSpanSSE2<kInkTypeAdd>(alpha, dst, src, width, rgbMask, alphaMask);
+	case kInkTypeSubPin:
+		return inkSpanSSE2<kInkTypeSubPin>(alpha, dst, src, width, rgbMask, alphaMask);
+	case kInkTypeSub:
+		return inkSpanSSE2<kInkTypeSub>(alpha, dst, src, width, rgbMask, alphaMask);
+	case kInkTypeLight:
+		return inkSpanSSE2<kInkTypeLight>(alpha, dst, src, width, rgbMask, alphaMask);
+	case kInkTypeDark:
+		return inkSpanSSE2<kInkTypeDark>(alpha, dst, src, width, rgbMask, alphaMask);
+	case kInkTypeBlend:
+		return inkSpanSSE2<kInkTypeBlend>(alpha, dst, src, width, rgbMask, alphaMask);
+	default:
+		return 0;
+	}
+}
+
+} // End of namespace Director
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__x86_64__)
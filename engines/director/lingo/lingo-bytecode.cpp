@@ -680,6 +680,15 @@ void LC::cb_thepush2() {
 }
 
 void LC::cb_varpush() {
+	int slot = g_lingo->readInt();
+	Datum *value = g_lingo->getLocalSlot(slot);
+	if (value) {
+		const char *localName = g_lingo->readString();
+		g_debugger->varReadHook(localName);
+		g_lingo->push(*value);
+		return;
+	}
+
 	Common::String name = g_lingo->readString();
 	Datum target(name);
 	target.type = LOCALREF;
@@ -690,6 +699,15 @@ void LC::cb_varpush() {
 
 
 void LC::cb_varassign() {
+	int slot = g_lingo->readInt();
+	Datum *value = g_lingo->getLocalSlot(slot);
+	if (value) {
+		const char *localName = g_lingo->readString();
+		*value = g_lingo->pop();
+		g_debugger->varWriteHook(localName);
+		return;
+	}
+
 	Common::String name = g_lingo->readString();
 	Datum target(name);
 	target.type = LOCALREF;
@@ -1513,7 +1531,9 @@ ScriptContext *LingoCompiler::compileLingoV4(Common::SeekableReadStreamEndian &s
 				size_t argc = strlen(g_lingo->_lingoV4[opcode]->proto);
 				if (argc) {
 					bool codeName = false;
+					bool codeSlot = false;
 					int arg = 0;
+					int slot = -1;
 					for (uint c = 0; c < argc; c++) {
 						switch (g_lingo->_lingoV4[opcode]->proto[c]) {
 						case 'b':
@@ -1561,7 +1581,9 @@ ScriptContext *LingoCompiler::compileLingoV4(Common::SeekableReadStreamEndian &s
 							break;
 						case 'a':
 							// argument is a function argument ID
+							codeSlot = true;
 							if (argMap.contains(arg)) {
+								slot = arg;
 								arg = argMap[arg];
 							} else {
 								warning("No argument name found for ID %d", arg);
@@ -1570,7 +1592,9 @@ ScriptContext *LingoCompiler::compileLingoV4(Common::SeekableReadStreamEndian &s
 							break;
 						case 'v':
 							// argument is a local variable ID
+							codeSlot = true;
 							if (varMap.contains(arg)) {
+								slot = argNames->size() + arg;
 								arg = varMap[arg];
 							} else {
 								warning("No variable name found for ID %d", arg);
@@ -1589,6 +1613,11 @@ ScriptContext *LingoCompiler::compileLingoV4(Common::SeekableReadStreamEndian &s
 							break;
 						}
 					}
+					if (codeSlot) {
+						// locals are accessed by their index in the call frame,
+						// the name is kept for the debugger and disassembly
+						codeInt(slot);
+					}
 					if (codeName) {
 						codeString(_assemblyArchive->getName(arg).c_str());
 					} else {
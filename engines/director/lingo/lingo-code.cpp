@@ -102,7 +102,8 @@ static const struct FuncDescr {
 	{ LC::c_le,				"c_le",				"" },
 	{ LC::c_lineToOf,		"c_lineToOf",		"" },	// D3
 	{ LC::c_lineToOfRef,	"c_lineToOfRef",	"" },	// D3
-	{ LC::c_localpush,		"c_localpush",		"s" },
+	{ LC::c_localassign,	"c_localassign",	"is" },
+	{ LC::c_localpush,		"c_localpush",		"is" },
 	{ LC::c_localrefpush,	"c_localrefpush",	"s" },
 	{ LC::c_lt,				"c_lt",				"" },
 	{ LC::c_mod,			"c_mod",			"" },
@@ -158,8 +159,8 @@ static const struct FuncDescr {
 	{ LC::cb_unk,			"cb_unk",			"i" },
 	{ LC::cb_unk1,			"cb_unk1",			"ii" },
 	{ LC::cb_unk2,			"cb_unk2",			"iii" },
-	{ LC::cb_varassign,		"cb_varassign",		"s" },
-	{ LC::cb_varpush,		"cb_varpush",		"s" },
+	{ LC::cb_varassign,		"cb_varassign",		"is" },
+	{ LC::cb_varpush,		"cb_varpush",		"is" },
 	{ LC::cb_v4assign,		"cb_v4assign",		"i" },
 	{ LC::cb_v4assign2,		"cb_v4assign2",		"i" },
 	{ LC::cb_v4theentitypush,"cb_v4theentitypush","i" },
@@ -296,6 +297,18 @@ void Lingo::pushContext(const Symbol funcSym, bool allowRetVal, Datum defaultRet
 	}
 	_state->localVars = localvars;
 
+	// Resolve the slots used by the compiled code to access arguments and
+	// local variables. The hash nodes are never removed while the frame is
+	// alive, so the pointers stay valid until cleanLocalVars().
+	if (funcSym.argNames) {
+		for (auto &it : *funcSym.argNames)
+			fp->localSlots.push_back(&localvars->getVal(it));
+	}
+	if (funcSym.varNames) {
+		for (auto &it : *funcSym.varNames)
+			fp->localSlots.push_back(&localvars->getVal(it));
+	}
+
 	fp->stackSizeBefore = _state->stack.size();
 
 	callstack.push_back(fp);
@@ -529,11 +542,34 @@ void LC::c_globalpush() {
 }
 
 void LC::c_localpush() {
+	int slot = g_lingo->readInt();
+	Datum *value = g_lingo->getLocalSlot(slot);
+	if (value) {
+		const char *name = g_lingo->readString();
+		g_debugger->varReadHook(name);
+		g_lingo->push(*value);
+		return;
+	}
 	LC::c_localrefpush();
 	Datum d = g_lingo->pop();
 	g_lingo->push(g_lingo->varFetch(d));
 }
 
+void LC::c_localassign() {
+	int slot = g_lingo->readInt();
+	Datum *value = g_lingo->getLocalSlot(slot);
+	if (value) {
+		const char *name = g_lingo->readString();
+		*value = g_lingo->pop();
+		g_debugger->varWriteHook(name);
+		return;
+	}
+	LC::c_localrefpush();
+	Datum d1 = g_lingo->pop();
+	Datum d2 = g_lingo->pop();
+	g_lingo->varAssign(d1, d2);
+}
+
 void LC::c_proppush() {
 	LC::c_proprefpush();
 	Datum d = g_lingo->pop();
@@ -136,6 +136,7 @@ ScriptContext *LingoCompiler::compileLingo(const Common::U32String &code, LingoA
 	_currentAssembly = new ScriptData;
 
 	_methodVars = new VarTypeHash;
+	_localSlotFixups.clear();
 	_linenumber = _colnumber = 1;
 	_hadError = false;
 
@@ -195,6 +196,14 @@ ScriptContext *LingoCompiler::compileLingo(const Common::U32String &code, LingoA
 		code1(LC::c_procret);
 		code1(STOP);
 
+		Common::Array<Common::String> *argNames = new Common::Array<Common::String>;
+		Common::Array<Common::String> *varNames = new Common::Array<Common::String>;
+		for (auto &it : *_methodVars) {
+			if (it._value == kVarLocal)
+				varNames->push_back(Common::String(it._key));
+		}
+		patchLocalSlots(*argNames, *varNames);
+
 		if (debugChannelSet(3, kDebugCompile)) {
 			if (_currentAssembly->size() && !_hadError)
 				Common::hexdump((byte *)&_currentAssembly->front(), _currentAssembly->size() * sizeof(inst));
@@ -217,12 +226,6 @@ ScriptContext *LingoCompiler::compileLingo(const Common::U32String &code, LingoA
 		currentFunc.name = new Common::String("scummvm_" + typeStr + "_" + _assemblyContext->getName());
 		currentFunc.ctx = _assemblyContext;
 		currentFunc.anonymous = anonymous;
-		Common::Array<Common::String> *argNames = new Common::Array<Common::String>;
-		Common::Array<Common::String> *varNames = new Common::Array<Common::String>;
-		for (auto &it : *_methodVars) {
-			if (it._value == kVarLocal)
-				varNames->push_back(Common::String(it._key));
-		}
 
 		if (debugChannelSet(1, kDebugCompile)) {
 			debug("Function vars");
@@ -339,6 +342,13 @@ int LingoCompiler::codeFunc(const Common::String &s, int numpar) {
 
 void LingoCompiler::codeVarSet(const Common::String &name) {
 	registerMethodVar(name);
+	VarType type = (*_methodVars)[name];
+	if (type == kVarLocal || type == kVarArgument) {
+		code1(LC::c_localassign);
+		codeLocalSlot(name);
+		codeString(name.c_str());
+		return;
+	}
 	codeVarRef(name);
 	code1(LC::c_assign);
 }
@@ -388,6 +398,7 @@ void LingoCompiler::codeVarGet(const Common::String &name) {
 	case kVarLocal:
 	case kVarArgument:
 		code1(LC::c_localpush);
+		codeLocalSlot(name);
 		break;
 	case kVarProperty:
 	case kVarInstance:
@@ -397,6 +408,29 @@ void LingoCompiler::codeVarGet(const Common::String &name) {
 	codeString(name.c_str());
 }
 
+void LingoCompiler::codeLocalSlot(const Common::String &name) {
+	_localSlotFixups.push_back(LocalSlotFixup(_currentAssembly->size(), name));
+	codeInt(-1);
+}
+
+void LingoCompiler::patchLocalSlots(const Common::Array<Common::String> &argNames, const Common::Array<Common::String> &varNames) {
+	// Slots are numbered in the same order as Lingo::pushContext() fills them in
+	Common::HashMap<Common::String, int, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> slots;
+	for (uint i = 0; i < argNames.size(); i++)
+		slots.setVal(argNames[i], i);
+	for (uint i = 0; i < varNames.size(); i++) {
+		if (!slots.contains(varNames[i]))
+			slots.setVal(varNames[i], argNames.size() + i);
+	}
+
+	for (auto &it : _localSlotFixups) {
+		// Unresolved names keep the slot -1 and are looked up by name at runtime
+		if (slots.contains(it.name))
+			WRITE_UINT32(&(*_currentAssembly)[it.pos], slots[it.name]);
+	}
+	_localSlotFixups.clear();
+}
+
 void LingoCompiler::registerMethodVar(const Common::String &name, VarType type) {
 	if (!_methodVars->contains(name)) {
 		if (_indef && type == kVarGeneric) {
@@ -480,6 +514,8 @@ bool LingoCompiler::visitHandlerNode(HandlerNode *node) {
 	_currentAssembly = new ScriptData;
 	VarTypeHash *mainMethodVars = _methodVars;
 	_methodVars = new VarTypeHash;
+	Common::Array<LocalSlotFixup> mainSlotFixups = _localSlotFixups;
+	_localSlotFixups.clear();
 
 	if (_inFactory) {
 		registerMethodVar("me", kVarArgument);
@@ -528,12 +564,14 @@ bool LingoCompiler::visitHandlerNode(HandlerNode *node) {
 		debugN("\n");
 	}
 
+	patchLocalSlots(*argNames, *varNames);
 	_assemblyContext->define(*node->name, _currentAssembly, argNames, varNames);
 
 	_indef = false;
 	_currentAssembly = mainAssembly;
 	delete _methodVars;
 	_methodVars = mainMethodVars;
+	_localSlotFixups = mainSlotFixups;
 	return true;
 }
 
@@ -48,6 +48,8 @@ public:
 	void codeVarSet(const Common::String &name);
 	void codeVarRef(const Common::String &name);
 	void codeVarGet(const Common::String &name);
+	void codeLocalSlot(const Common::String &name);
+	void patchLocalSlots(const Common::Array<Common::String> &argNames, const Common::Array<Common::String> &varNames);
 	int getTheFieldID(int entity, const Common::String &field, bool silent = false);
 	void registerFactory(Common::String &s);
 	void registerMethodVar(const Common::String &name, VarType type = kVarGeneric);
@@ -69,6 +71,17 @@ public:
 
 	Common::HashMap<Common::String, VarType, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> *_methodVars;
 
+	struct LocalSlotFixup {
+		uint pos;
+		Common::String name;
+
+		LocalSlotFixup() : pos(0) {}
+		LocalSlotFixup(uint p, const Common::String &n) : pos(p), name(n) {}
+	};
+	// Slot operands of the local variable accesses in the current handler,
+	// resolved once its argument and variable lists are known
+	Common::Array<LocalSlotFixup> _localSlotFixups;
+
 	bool _hadError;
 
 public:
@@ -206,6 +206,15 @@ MODULE_OBJS = \
 	lingo/xtras/x/xsound.o
 
 
+ifdef SCUMMVM_NEON
+MODULE_OBJS += \
+	graphics_neon.o
+endif
+ifdef SCUMMVM_SSE2
+MODULE_OBJS += \
+	graphics_sse2.o
+endif
+
 ifdef USE_IMGUI
 MODULE_OBJS += \
 	debugger/debugtools.o \
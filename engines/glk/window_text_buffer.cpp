@@ -37,7 +37,7 @@ namespace Glk {
 
 TextBufferWindow::TextBufferWindow(Windows *windows, uint rock) : TextWindow(windows, rock),
 		_font(g_conf->_propInfo), _historyPos(0), _historyFirst(0), _historyPresent(0),
-		_lastSeen(0), _scrollPos(0), _scrollMax(0), _scrollBack(SCROLLBACK), _width(-1), _height(-1),
+		_lastSeen(0), _scrollPos(0), _scrollMax(0), _scrollBack(SCROLLBACK), _reflowPending(false), _width(-1), _height(-1),
 		_inBuf(nullptr), _lineTerminators(nullptr), _echoLineInput(true), _ladjw(0), _radjw(0),
 		_ladjn(0), _radjn(0), _numChars(0), _chars(nullptr), _attrs(nullptr), _spaced(0), _dashed(0),
 		_copyBuf(nullptr), _copyPos(0) {
@@ -45,8 +45,10 @@ TextBufferWindow::TextBufferWindow(Windows *windows, uint rock) : TextWindow(win
 	_history.resize(HISTORYLEN);
 
 	_lines.resize(SCROLLBACK);
-	_chars = _lines[0]._chars;
-	_attrs = _lines[0]._attrs;
+	_lines[0]._chars.resize(TBLINELEN);
+	_lines[0]._attrs.resize(TBLINELEN);
+	_chars = _lines[0]._chars.begin();
+	_attrs = _lines[0]._attrs.begin();
 
 	Common::copy(&g_conf->_tStyles[0], &g_conf->_tStyles[style_NUMSTYLES], _styles);
 
@@ -88,9 +90,11 @@ void TextBufferWindow::rearrange(const Rect &box) {
 	_yAdj = (box.height() - rnd);
 	_bbox.top += (box.height() - rnd);
 
+	// Wrapping the scrollback again is deferred to the next redraw, so that
+	// resizing through several sizes in a row only does it once
 	if (newwid != _width) {
 		_width = newwid;
-		reflow();
+		_reflowPending = true;
 	}
 
 	if (newhgt != _height) {
@@ -125,29 +129,29 @@ void TextBufferWindow::reflow() {
 	int i, k, p, s;
 	int x;
 
+	_reflowPending = false;
+
 	if (_height < 4 || _width < 20)
 		return;
 
 	_lines[0]._len = _numChars;
 
-	// allocate temp buffers
-	Attributes *attrbuf = new Attributes[SCROLLBACK * TBLINELEN];
-	uint32 *charbuf = new uint32[SCROLLBACK * TBLINELEN];
-	int *alignbuf = new int[SCROLLBACK];
-	Picture **pictbuf = new Picture *[SCROLLBACK];
-	uint *hyperbuf = new uint[SCROLLBACK];
-	int *offsetbuf = new int[SCROLLBACK];
-
-	if (!attrbuf || !charbuf || !alignbuf || !pictbuf || !hyperbuf || !offsetbuf) {
-		delete[] attrbuf;
-		delete[] charbuf;
-		delete[] alignbuf;
-		delete[] pictbuf;
-		delete[] hyperbuf;
-		delete[] offsetbuf;
-		return;
+	s = _scrollMax < SCROLLBACK ? _scrollMax : SCROLLBACK - 1;
+
+	// size the temp buffers for the text actually in the scrollback
+	int numChars = 0, numPics = 0;
+	for (k = s; k >= 0; k--) {
+		numChars += _lines[k]._len + (_lines[k]._newLine ? 1 : 0);
+		numPics += (_lines[k]._lPic ? 1 : 0) + (_lines[k]._rPic ? 1 : 0);
 	}
 
+	Common::Array<Attributes> attrbuf(MAX(numChars, 1));
+	Common::Array<uint32> charbuf(MAX(numChars, 1));
+	Common::Array<int> alignbuf(numPics + 1);
+	Common::Array<Picture *> pictbuf(numPics + 1);
+	Common::Array<uint> hyperbuf(numPics + 1);
+	Common::Array<int> offsetbuf(numPics + 1);
+
 	// copy text to temp buffers
 
 	oldattr = _attr;
@@ -155,7 +159,6 @@ void TextBufferWindow::reflow() {
 
 	x = 0;
 	p = 0;
-	s = _scrollMax < SCROLLBACK ? _scrollMax : SCROLLBACK - 1;
 
 	for (k = s; k >= 0; k--) {
 		if (k == 0 && _lineRequest)
@@ -219,18 +222,10 @@ void TextBufferWindow::reflow() {
 
 	if (inputbyte != -1) {
 		_inFence = _numChars;
-		putTextUni(charbuf + inputbyte, p - inputbyte, _numChars, 0);
+		putTextUni(charbuf.begin() + inputbyte, p - inputbyte, _numChars, 0);
 		_inCurs = _numChars;
 	}
 
-	// free temp buffers
-	delete[] attrbuf;
-	delete[] charbuf;
-	delete[] alignbuf;
-	delete[] pictbuf;
-	delete[] hyperbuf;
-	delete[] offsetbuf;
-
 	_attr = oldattr;
 
 	touchScroll();
@@ -819,12 +814,16 @@ void TextBufferWindow::redraw() {
 	int selrow, selchar, sx0, sx1, selleft, selright;
 	bool selBuf;
 	int tx, tsc, tsw, lsc, rsc;
+	Attributes selAttrs[TBLINELEN];
 	Screen &screen = *g_vm->_screen;
 
 	gli_tts_flush();
 
 	Window::redraw();
 
+	if (_reflowPending)
+		reflow();
+
 	_lines[0]._len = _numChars;
 	sx0 = sx1 = selleft = selright = 0;
 
@@ -856,7 +855,9 @@ void TextBufferWindow::redraw() {
 		if (selrow)
 			_lines[i]._dirty = true;
 
-		TextBufferRow ln(_lines[i]);
+		const TextBufferRow &ln = _lines[i];
+		const uint32 *chars = ln._chars.begin();
+		const Attributes *attrs = ln._attrs.begin();
 
 		// skip if we can
 		if (!ln._dirty && !ln._repaint && !Windows::_forceRedraw && _scrollPos == 0)
@@ -883,13 +884,13 @@ void TextBufferWindow::redraw() {
 
 		// kill spaces at the end unless they're a different color
 		color = Windows::_overrideBgSet ? g_conf->_windowColor : _bgColor;
-		while (i > 0 && linelen > 1 && ln._chars[linelen - 1] == ' '
-				&& _styles[ln._attrs[linelen - 1].style].bg == color
-				&& !_styles[ln._attrs[linelen - 1].style].reverse)
+		while (i > 0 && linelen > 1 && chars[linelen - 1] == ' '
+				&& _styles[attrs[linelen - 1].style].bg == color
+				&& !_styles[attrs[linelen - 1].style].reverse)
 			linelen --;
 
 		// kill characters that would overwrite the scroll bar
-		while (linelen > 1 && calcWidth(ln._chars, ln._attrs, 0, linelen, -1) >= pw)
+		while (linelen > 1 && calcWidth(chars, attrs, 0, linelen, -1) >= pw)
 			linelen --;
 
 		/*
@@ -897,9 +898,9 @@ void TextBufferWindow::redraw() {
 		 */
 		if (_font._justify && !ln._newLine && i > 0) {
 			for (a = 0, nsp = 0; a < linelen; a++)
-				if (ln._chars[a] == ' ')
+				if (chars[a] == ' ')
 					nsp ++;
-			w = calcWidth(ln._chars, ln._attrs, 0, linelen, 0);
+			w = calcWidth(chars, attrs, 0, linelen, 0);
 			if (nsp)
 				spw = (x1 - x0 - ln._lm - ln._rm - 2 * SLOP - w) / nsp;
 			else
@@ -916,20 +917,20 @@ void TextBufferWindow::redraw() {
 			// optimized case for all chars selected
 			if (selleft && selright) {
 				rsc = linelen > 0 ? linelen - 1 : 0;
-				selchar = calcWidth(ln._chars, ln._attrs, lsc, rsc, spw) / GLI_SUBPIX;
+				selchar = calcWidth(chars, attrs, lsc, rsc, spw) / GLI_SUBPIX;
 			} else {
 				// optimized case for leftmost char selected
 				if (selleft) {
 					tsc = linelen > 0 ? linelen - 1 : 0;
-					selchar = calcWidth(ln._chars, ln._attrs, lsc, tsc, spw) / GLI_SUBPIX;
+					selchar = calcWidth(chars, attrs, lsc, tsc, spw) / GLI_SUBPIX;
 				} else {
 					// find the substring contained by the selection
 					tx = (x0 + SLOP + ln._lm) / GLI_SUBPIX;
 					// measure string widths until we find left char
 					for (tsc = 0; tsc < linelen; tsc++) {
-						tsw = calcWidth(ln._chars, ln._attrs, 0, tsc, spw) / GLI_SUBPIX;
+						tsw = calcWidth(chars, attrs, 0, tsc, spw) / GLI_SUBPIX;
 						if (tsw + tx >= sx0 ||
-								((tsw + tx + GLI_SUBPIX) >= sx0 && ln._chars[tsc] != ' ')) {
+								((tsw + tx + GLI_SUBPIX) >= sx0 && chars[tsc] != ' ')) {
 							lsc = tsc;
 							selchar = true;
 							break;
@@ -943,7 +944,7 @@ void TextBufferWindow::redraw() {
 					} else {
 						// measure string widths until we find right char
 						for (tsc = lsc; tsc < linelen; tsc++) {
-							tsw = calcWidth(ln._chars, ln._attrs, lsc, tsc, spw) / GLI_SUBPIX;
+							tsw = calcWidth(chars, attrs, lsc, tsc, spw) / GLI_SUBPIX;
 							if (tsw + sx0 < sx1)
 								rsc = tsc;
 						}
@@ -952,11 +953,13 @@ void TextBufferWindow::redraw() {
 					}
 				}
 			}
-			// reverse colors for selected chars
+			// reverse colors for selected chars, on a copy of the attributes
 			if (selchar) {
+				Common::copy(attrs, attrs + MAX(linelen, rsc + 1), selAttrs);
+				attrs = selAttrs;
 				for (tsc = lsc; tsc <= rsc; tsc++) {
-					ln._attrs[tsc].reverse = !ln._attrs[tsc].reverse;
-					_copyBuf[_copyPos] = ln._chars[tsc];
+					selAttrs[tsc].reverse = !selAttrs[tsc].reverse;
+					_copyBuf[_copyPos] = chars[tsc];
 					_copyPos++;
 				}
 			}
@@ -981,11 +984,11 @@ void TextBufferWindow::redraw() {
 		x = x0 + SLOP + ln._lm;
 		a = 0;
 		for (b = 0; b < linelen; b++) {
-			if (ln._attrs[a] != ln._attrs[b]) {
-				link = ln._attrs[a].hyper;
-				font = ln._attrs[a].attrFont(_styles);
-				color = ln._attrs[a].attrBg(_styles);
-				w = screen.stringWidthUni(font, Common::U32String(ln._chars + a, b - a), spw);
+			if (attrs[a] != attrs[b]) {
+				link = attrs[a].hyper;
+				font = attrs[a].attrFont(_styles);
+				color = attrs[a].attrBg(_styles);
+				w = screen.stringWidthUni(font, Common::U32String(chars + a, b - a), spw);
 				screen.fillRect(Rect::fromXYWH(x / GLI_SUBPIX, y, w / GLI_SUBPIX, _font._leading),
 								color);
 				if (link) {
@@ -999,10 +1002,10 @@ void TextBufferWindow::redraw() {
 				a = b;
 			}
 		}
-		link = ln._attrs[a].hyper;
-		font = ln._attrs[a].attrFont(_styles);
-		color = ln._attrs[a].attrBg(_styles);
-		w = screen.stringWidthUni(font, Common::U32String(ln._chars + a, b - a), spw);
+		link = attrs[a].hyper;
+		font = attrs[a].attrFont(_styles);
+		color = attrs[a].attrBg(_styles);
+		w = screen.stringWidthUni(font, Common::U32String(chars + a, b - a), spw);
 		screen.fillRect(Rect::fromXYWH(x / GLI_SUBPIX, y, w / GLI_SUBPIX, _font._leading), color);
 		if (link) {
 			screen.fillRect(Rect::fromXYWH(x / GLI_SUBPIX + 1, y + _font._baseLine + 1,
@@ -1033,19 +1036,19 @@ void TextBufferWindow::redraw() {
 		x = x0 + SLOP + ln._lm;
 		a = 0;
 		for (b = 0; b < linelen; b++) {
-			if (ln._attrs[a] != ln._attrs[b]) {
-				link = ln._attrs[a].hyper;
-				font = ln._attrs[a].attrFont(_styles);
-				color = link ? _font._linkColor : ln._attrs[a].attrFg(_styles);
+			if (attrs[a] != attrs[b]) {
+				link = attrs[a].hyper;
+				font = attrs[a].attrFont(_styles);
+				color = link ? _font._linkColor : attrs[a].attrFg(_styles);
 				x = screen.drawStringUni(Point(x, y + _font._baseLine),
-										 font, color, Common::U32String(ln._chars + a, b - a), spw);
+										 font, color, Common::U32String(chars + a, b - a), spw);
 				a = b;
 			}
 		}
-		link = ln._attrs[a].hyper;
-		font = ln._attrs[a].attrFont(_styles);
-		color = link ? _font._linkColor : ln._attrs[a].attrFg(_styles);
-		screen.drawStringUni(Point(x, y + _font._baseLine), font, color, Common::U32String(ln._chars + a, linelen - a), spw);
+		link = attrs[a].hyper;
+		font = attrs[a].attrFont(_styles);
+		color = link ? _font._linkColor : attrs[a].attrFg(_styles);
+		screen.drawStringUni(Point(x, y + _font._baseLine), font, color, Common::U32String(chars + a, linelen - a), spw);
 	}
 
 	/*
@@ -1087,7 +1090,7 @@ void TextBufferWindow::redraw() {
 	 * draw the images
 	 */
 	for (i = 0; i < _scrollBack; i++) {
-		TextBufferRow ln(_lines[i]);
+		const TextBufferRow &ln = _lines[i];
 
 		y = y0 + (_height - (i - _scrollPos) - 1) * _font._leading;
 
@@ -1550,11 +1553,13 @@ void TextBufferWindow::scrollOneLine(bool forced) {
 	_lines[0]._newLine = forced;
 
 	for (int i = _scrollBack - 1; i > 0; i--) {
-		memcpy(&_lines[i], &_lines[i - 1], sizeof(TextBufferRow));
+		_lines[i].swap(_lines[i - 1]);
 		if (i < _height)
 			touch(i);
 	}
 
+	compactLine();
+
 	if (_radjn)
 		_radjn--;
 	if (_radjn == 0)
@@ -1585,13 +1590,26 @@ void TextBufferWindow::scrollOneLine(bool forced) {
 
 }
 
+void TextBufferWindow::compactLine() {
+	TextBufferRow &line = _lines[0];
+	TextBufferRow &prev = _lines[1];
+
+	// The full size buffers stay with line 0, which _chars and _attrs point to
+	line._chars.swap(prev._chars);
+	line._attrs.swap(prev._attrs);
+
+	int len = CLIP(prev._len, 0, TBLINELEN - 1) + 1;
+	prev._chars = Common::Array<uint32>(line._chars.begin(), len);
+	prev._attrs = Common::Array<Attributes>(line._attrs.begin(), len);
+}
+
 void TextBufferWindow::scrollResize() {
 	int i;
 
 	_lines.resize(_scrollBack + SCROLLBACK);
 
-	_chars = _lines[0]._chars;
-	_attrs = _lines[0]._attrs;
+	_chars = _lines[0]._chars.begin();
+	_attrs = _lines[0]._attrs.begin();
 
 	for (i = _scrollBack; i < (_scrollBack + SCROLLBACK); i++) {
 		_lines[i]._dirty = false;
@@ -1604,8 +1622,8 @@ void TextBufferWindow::scrollResize() {
 		_lines[i]._rHyper = 0;
 		_lines[i]._len = 0;
 		_lines[i]._newLine = 0;
-		*(_lines[i]._chars) = 0;
-		_lines[i]._attrs->clear();
+		_lines[i]._chars[0] = 0;
+		_lines[i]._attrs[0].clear();
 	}
 
 	_scrollBack += SCROLLBACK;
@@ -1647,7 +1665,23 @@ void TextBufferWindow::flowBreak() {
 TextBufferWindow::TextBufferRow::TextBufferRow() : _len(0), _newLine(0), _dirty(false),
 	_repaint(false), _lPic(nullptr), _rPic(nullptr), _lHyper(0), _rHyper(0),
 	_lm(0), _rm(0) {
-	Common::fill(&_chars[0], &_chars[TBLINELEN], 0);
+	_chars.resize(1);
+	_attrs.resize(1);
+}
+
+void TextBufferWindow::TextBufferRow::swap(TextBufferRow &row) {
+	_chars.swap(row._chars);
+	_attrs.swap(row._attrs);
+	SWAP(_len, row._len);
+	SWAP(_newLine, row._newLine);
+	SWAP(_dirty, row._dirty);
+	SWAP(_repaint, row._repaint);
+	SWAP(_lPic, row._lPic);
+	SWAP(_rPic, row._rPic);
+	SWAP(_lHyper, row._lHyper);
+	SWAP(_rHyper, row._rHyper);
+	SWAP(_lm, row._lm);
+	SWAP(_rm, row._rm);
 }
 
 } // End of namespace Glk
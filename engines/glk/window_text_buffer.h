@@ -36,11 +36,13 @@ namespace Glk {
  */
 class TextBufferWindow : public TextWindow, Speech {
 	/**
-	 * Structure for a row within the window
+	 * Structure for a row within the window. The row being written to has
+	 * room for TBLINELEN characters, while the rows scrolled up into the
+	 * scrollback only keep the characters they use, plus one.
 	 */
 	struct TextBufferRow {
-		uint32 _chars[TBLINELEN];
-		Attributes _attrs[TBLINELEN];
+		Common::Array<uint32> _chars;
+		Common::Array<Attributes> _attrs;
 		int _len, _newLine;
 		bool _dirty, _repaint;
 		Picture *_lPic, *_rPic;
@@ -51,6 +53,11 @@ class TextBufferWindow : public TextWindow, Speech {
 		 * Constructor
 		 */
 		TextBufferRow();
+
+		/**
+		 * Exchange the contents of two rows, without copying the characters
+		 */
+		void swap(TextBufferRow &row);
 	};
 	typedef Common::Array<TextBufferRow> TextBufferRows;
 private:
@@ -58,6 +65,12 @@ private:
 private:
 	void reflow();
 	void touchScroll();
+
+	/**
+	 * Move the finished line 0 into the scrollback. Line 0 gets its full
+	 * size buffers back, and line 1 a copy of just the characters it uses.
+	 */
+	void compactLine();
 	bool putPicture(Picture *pic, uint align, uint linkval);
 
 	/**
@@ -98,6 +111,7 @@ public:
 
 	TextBufferRows _lines;
 	int _scrollBack;
+	bool _reflowPending;    ///< width changed, text needs wrapping again before the next redraw
 
 	int _numChars;        ///< number of chars in last line: lines[0]
 	uint32 *_chars;       ///< alias to lines[0].chars
@@ -780,7 +780,7 @@ void Attributes::clear() {
 	hyper = 0;
 }
 
-uint Attributes::attrBg(const WindowStyle *styles) {
+uint Attributes::attrBg(const WindowStyle *styles) const {
 	int revset = reverse || (styles[style].reverse && !Windows::_overrideReverse);
 
 	bool zfset = fgset ? fgset : Windows::_overrideFgSet;
@@ -817,7 +817,7 @@ uint Attributes::attrBg(const WindowStyle *styles) {
 	}
 }
 
-uint Attributes::attrFg(const WindowStyle *styles) {
+uint Attributes::attrFg(const WindowStyle *styles) const {
 	int revset = reverse || (styles[style].reverse && !Windows::_overrideReverse);
 
 	bool zfset = fgset ? fgset : Windows::_overrideFgSet;
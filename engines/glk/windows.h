@@ -369,12 +369,12 @@ struct Attributes {
 	/**
 	 * Return the background color for the current font style
 	 */
-	uint attrBg(const WindowStyle *styles);
+	uint attrBg(const WindowStyle *styles) const;
 
 	/**
 	 * Return the foreground color for the current font style
 	 */
-	uint attrFg(const WindowStyle *styles);
+	uint attrFg(const WindowStyle *styles) const;
 
 	/**
 	 * Get the font for the current font style
@@ -225,42 +225,33 @@ void EMIModel::setSkeleton(Skeleton *skel) {
 	for (int i = 0; i < _numBoneInfos; i++) {
 		_vertexBoneInfo[i] = _skeleton->findJointIndex(_boneNames[_boneInfos[i]._joint]);
 	}
-}
-
-void EMIModel::prepareForRender() {
-	if (!_skeleton || !_vertexBoneInfo)
-		return;
-
-	for (int i = 0; i < _numVertices; i++) {
-		_drawVertices[i].set(0.0f, 0.0f, 0.0f);
-		_drawNormals[i].set(0.0f, 0.0f, 0.0f);
-	}
 
+	_skin.setVertices(_vertices[0].getData(), _normals[0].getData(), _numVertices, sizeof(Math::Vector3d));
 	int boneVert = -1;
 	for (int i = 0; i < _numBoneInfos; i++) {
 		if (_boneInfos[i]._incFac == 1) {
 			boneVert++;
 		}
+		if (boneVert >= 0 && boneVert < _numVertices && _vertexBoneInfo[i] >= 0) {
+			_skin.addInfluence(boneVert, _vertexBoneInfo[i], _boneInfos[i]._weight);
+		}
+	}
+	_skin.finalize();
+	_skinMatrices.resize(_skeleton->_numJoints);
+}
 
-		int jointIndex = _vertexBoneInfo[i];
-		const Math::Matrix4 &jointMatrix = _skeleton->_joints[jointIndex]._finalMatrix;
-		const Math::Matrix4 &bindPose = _skeleton->_joints[jointIndex]._absMatrix;
-
-		Math::Vector3d vert = _vertices[boneVert];
-		vert -= bindPose.getPosition();
-		vert = vert * bindPose.getRotation();
-		jointMatrix.transform(&vert, true);
-		_drawVertices[boneVert] += vert * _boneInfos[i]._weight;
+void EMIModel::prepareForRender() {
+	if (!_skeleton || !_vertexBoneInfo)
+		return;
 
-		Math::Vector3d normal = _normals[boneVert];
-		normal = normal * bindPose.getRotation();
-		jointMatrix.transform(&normal, false);
-		_drawNormals[boneVert] += normal * _boneInfos[i]._weight;
+	// Each joint moves the vertices from its bind pose to its current pose
+	for (int i = 0; i < _skeleton->_numJoints; i++) {
+		Math::Matrix4 bindPoseInverse = _skeleton->_joints[i]._absMatrix;
+		bindPoseInverse.invertAffineOrthonormal();
+		_skinMatrices[i] = _skeleton->_joints[i]._finalMatrix * bindPoseInverse;
 	}
 
-	for (int i = 0; i < _numVertices; i++) {
-		_drawNormals[i].normalize();
-	}
+	_skin.skin(_skinMatrices.data(), _skinMatrices.size(), _drawVertices[0].getData(), _drawNormals[0].getData(), sizeof(Math::Vector3d));
 
 	g_driver->updateEMIModel(this);
 }
@@ -26,6 +26,7 @@
 #include "engines/grim/actor.h"
 
 #include "math/matrix4.h"
+#include "math/skinning.h"
 #include "math/vector2d.h"
 #include "math/vector3d.h"
 #include "math/vector4d.h"
@@ -114,6 +115,8 @@ public:
 	BoneInfo *_boneInfos;
 	Common::String *_boneNames;
 	int *_vertexBoneInfo;
+	Math::SkinnedMesh _skin;
+	Common::Array<Math::Matrix4> _skinMatrices;
 
 	// Stuff we dont know how to use:
 	float _radius;
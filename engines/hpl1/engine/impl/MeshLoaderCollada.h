@@ -497,7 +497,16 @@ private:
 						cColladaScene *apColladaScene,
 						bool abCache);
 
-	bool SaveStructures(const tString &asFile,
+	void ClearStructures(tColladaImageVec *apColladaImageVec,
+						 tColladaTextureVec *apColladaTextureVec,
+						 tColladaMaterialVec *apColladaMaterialVec,
+						 tColladaLightVec *apColladaLightVec,
+						 tColladaGeometryVec *apColladaGeometryVec,
+						 tColladaControllerVec *apColladaControllerVec,
+						 tColladaAnimationVec *apColladaAnimVec,
+						 cColladaScene *apColladaScene);
+
+	bool SaveStructures(const tString &asFile, uint32 alSourceSize, uint32 alSourceChecksum,
 						tColladaImageVec *apColladaImageVec,
 						tColladaTextureVec *apColladaTextureVec,
 						tColladaMaterialVec *apColladaMaterialVec,
@@ -507,7 +516,7 @@ private:
 						tColladaAnimationVec *apColladaAnimVec,
 						cColladaScene *apColladaScene);
 
-	bool LoadStructures(const tString &asFile,
+	bool LoadStructures(const tString &asFile, uint32 alSourceSize, uint32 alSourceChecksum,
 						tColladaImageVec *apColladaImageVec,
 						tColladaTextureVec *apColladaTextureVec,
 						tColladaMaterialVec *apColladaMaterialVec,
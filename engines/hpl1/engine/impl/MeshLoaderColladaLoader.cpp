@@ -47,6 +47,14 @@
 
 #include "hpl1/engine/math/Math.h"
 
+#include "common/config-manager.h"
+#include "common/crc.h"
+#include "common/file.h"
+#include "common/memstream.h"
+#include "common/savefile.h"
+#include "hpl1/debug.h"
+#include "hpl1/hpl1.h"
+
 namespace hpl {
 
 //------------------------------------------------------------------------
@@ -55,6 +63,15 @@ namespace hpl {
 // FILL STRUCTURES
 //////////////////////////////////////////////////////////////////////////
 
+static uint32 GetCacheSections(tColladaImageVec *apColladaImageVec,
+							   tColladaTextureVec *apColladaTextureVec,
+							   tColladaMaterialVec *apColladaMaterialVec,
+							   tColladaLightVec *apColladaLightVec,
+							   tColladaGeometryVec *apColladaGeometryVec,
+							   tColladaControllerVec *apColladaControllerVec,
+							   tColladaAnimationVec *apColladaAnimVec,
+							   cColladaScene *apColladaScene);
+
 //-----------------------------------------------------------------------
 
 bool cMeshLoaderCollada::FillStructures(const tString &asFile,
@@ -66,39 +83,52 @@ bool cMeshLoaderCollada::FillStructures(const tString &asFile,
 										tColladaControllerVec *apColladaControllerVec,
 										tColladaAnimationVec *apColladaAnimVec,
 										cColladaScene *apColladaScene, bool abCache) {
-	abCache = false; // FIXME: find a way to enable the use of cache files
-	bool bLoadCache = false;
-	// abCache = false;
-	// Log("Loading %s\n",asFile.c_str());
-
-	tString sCacheFile = cString::GetFileName(cString::SetFileExt(asFile, "collcach"));
-	sCacheFile = "core/cache/" + sCacheFile;
-
-	if (abCache &&
-		FileExists(cString::To16Char(sCacheFile)) &&
-		FileExists(cString::To16Char(asFile))) {
-		cDate colladaDate = FileModifiedDate(cString::To16Char(asFile));
-		cDate cacheDate = FileModifiedDate(cString::To16Char(sCacheFile));
-
-		// Check if cache is newer
-		if (cacheDate > colladaDate)
-			bLoadCache = true;
+	// The cache is only used when it was made from the very same file
+	Common::File colladaFile;
+	if (colladaFile.open(Common::Path(asFile)) == false) {
+		Error("Couldn't load Collada XML file '%s'!\n", asFile.c_str());
+		return false;
+	}
+	uint32 lSourceSize = colladaFile.size();
+	byte *pSourceData = (byte *)malloc(lSourceSize);
+	if (pSourceData == NULL || colladaFile.read(pSourceData, lSourceSize) != lSourceSize) {
+		Error("Couldn't load Collada XML file '%s'!\n", asFile.c_str());
+		free(pSourceData);
+		return false;
 	}
+	colladaFile.close();
+	Common::MemoryReadStream colladaStream(pSourceData, lSourceSize, DisposeAfterUse::YES);
+	uint32 lSourceChecksum = Common::CRC32().crcFast(pSourceData, lSourceSize);
+
+	// Meshes and animations are loaded from the same file into different
+	// structures, so each combination gets its own cache. Files in different
+	// directories may share a name, so the full path is hashed as well.
+	uint32 lSections = GetCacheSections(apColladaImageVec, apColladaTextureVec, apColladaMaterialVec,
+										apColladaLightVec, apColladaGeometryVec, apColladaControllerVec,
+										apColladaAnimVec, apColladaScene);
+	tString sPath = cString::ToLowerCase(asFile);
+	uint32 lPathHash = Common::CRC32().crcFast((const byte *)sPath.c_str(), sPath.size());
+	tString sCacheFile = Common::String::format("%s-%s-%08x-%02x.collcach", ConfMan.getActiveDomainName().c_str(),
+												cString::SetFileExt(cString::GetFileName(asFile), "").c_str(),
+												lPathHash, lSections);
 
 	/////////////////////////////////////////////////
 	// LOAD CACHE
-	if (bLoadCache) {
-		return LoadStructures(sCacheFile,
-							  apColladaImageVec,
-							  apColladaTextureVec,
-							  apColladaMaterialVec,
-							  apColladaLightVec,
-							  apColladaGeometryVec,
-							  apColladaControllerVec,
-							  apColladaAnimVec,
-							  apColladaScene);
-	} else if (abCache) {
-		Log("Cache out of date! Reloading collada file '%s'\n and generating cache files", asFile.c_str());
+	if (abCache) {
+		if (LoadStructures(sCacheFile, lSourceSize, lSourceChecksum,
+						   apColladaImageVec,
+						   apColladaTextureVec,
+						   apColladaMaterialVec,
+						   apColladaLightVec,
+						   apColladaGeometryVec,
+						   apColladaControllerVec,
+						   apColladaAnimVec,
+						   apColladaScene)) {
+			return true;
+		}
+		Hpl1::logInfo(Hpl1::kDebugResourceLoading, "no valid cache for collada file '%s', generating it\n", asFile.c_str());
+		ClearStructures(apColladaImageVec, apColladaTextureVec, apColladaMaterialVec, apColladaLightVec,
+						apColladaGeometryVec, apColladaControllerVec, apColladaAnimVec, apColladaScene);
 	}
 
 	/////////////////////////////////////////////////
@@ -106,7 +136,7 @@ bool cMeshLoaderCollada::FillStructures(const tString &asFile,
 	// unsigned long lStartTime = mpSystem->GetLowLevel()->GetTime();
 
 	TiXmlDocument *pXmlDoc = hplNew(TiXmlDocument, (asFile.c_str()));
-	if (pXmlDoc->LoadFile() == false) {
+	if (pXmlDoc->LoadFile(colladaStream) == false) {
 		Error("Couldn't load Collada XML file '%s'!\n", asFile.c_str());
 		hplDelete(pXmlDoc);
 		return false;
@@ -264,7 +294,8 @@ bool cMeshLoaderCollada::FillStructures(const tString &asFile,
 	}
 
 	if (abCache) {
-		SaveStructures(sCacheFile, apColladaImageVec,
+		SaveStructures(sCacheFile, lSourceSize, lSourceChecksum,
+					   apColladaImageVec,
 					   apColladaTextureVec,
 					   apColladaMaterialVec,
 					   apColladaLightVec,
@@ -277,515 +308,302 @@ bool cMeshLoaderCollada::FillStructures(const tString &asFile,
 	return true;
 }
 
+//-----------------------------------------------------------------------
+
+void cMeshLoaderCollada::ClearStructures(tColladaImageVec *apColladaImageVec,
+										 tColladaTextureVec *apColladaTextureVec,
+										 tColladaMaterialVec *apColladaMaterialVec,
+										 tColladaLightVec *apColladaLightVec,
+										 tColladaGeometryVec *apColladaGeometryVec,
+										 tColladaControllerVec *apColladaControllerVec,
+										 tColladaAnimationVec *apColladaAnimVec,
+										 cColladaScene *apColladaScene) {
+	if (apColladaImageVec)
+		apColladaImageVec->clear();
+	if (apColladaTextureVec)
+		apColladaTextureVec->clear();
+	if (apColladaMaterialVec)
+		apColladaMaterialVec->clear();
+	if (apColladaLightVec)
+		apColladaLightVec->clear();
+	if (apColladaGeometryVec)
+		apColladaGeometryVec->clear();
+	if (apColladaControllerVec)
+		apColladaControllerVec->clear();
+	if (apColladaAnimVec)
+		apColladaAnimVec->clear();
+	if (apColladaScene) {
+		apColladaScene->ResetNodes();
+		apColladaScene->mfStartTime = 0;
+		apColladaScene->mfEndTime = 0;
+		apColladaScene->mfDeltaTime = 0;
+	}
+}
+
 //--------------------------------------------------------------------------
 
 //////////////////////////////////////////////////////////////////////////
 // SAVE COLLADA DATA
 //////////////////////////////////////////////////////////////////////////
 
-#define CreateXMLChild(parent, name) static_cast<TiXmlElement *>(parent->InsertEndChild(TiXmlElement(name)));
-
-#define CreateXMLTextChild(parent, name) static_cast<TiXmlText *>(parent->InsertEndChild(TiXmlText(name)));
-
-//-----------------------------------------------------------------------
-
-static void SaveImageVec(TiXmlElement *apRootElem, tColladaImageVec *apColladaImageVec);
-static void SaveTextureVec(TiXmlElement *apRootElem, tColladaTextureVec *apColladaTextureVec);
-static void SaveMaterialVec(TiXmlElement *apRootElem, tColladaMaterialVec *apColladaMaterialVec);
-static void SaveLightVec(TiXmlElement *apRootElem, tColladaLightVec *apColladaLightVec);
-static void SaveAnimationVec(TiXmlElement *apRootElem, tColladaAnimationVec *apColladaAnimationVec);
-static void SaveControllerVec(TiXmlElement *apRootElem, tColladaControllerVec *apColladaControllerVec);
-static void SaveGeometryVec(TiXmlElement *apRootElem, tColladaGeometryVec *apColladaGeometryVec);
-static void SaveScene(TiXmlElement *apRootElem, cColladaScene *apColladaScene);
-
-bool cMeshLoaderCollada::SaveStructures(const tString &asFile,
-										tColladaImageVec *apColladaImageVec,
-										tColladaTextureVec *apColladaTextureVec,
-										tColladaMaterialVec *apColladaMaterialVec,
-										tColladaLightVec *apColladaLightVec,
-										tColladaGeometryVec *apColladaGeometryVec,
-										tColladaControllerVec *apColladaControllerVec,
-										tColladaAnimationVec *apColladaAnimVec,
-										cColladaScene *apColladaScene) {
-	TiXmlDocument *pXmlDoc = hplNew(TiXmlDocument, (asFile.c_str()));
-
-	TiXmlElement *pRootElem = CreateXMLChild(pXmlDoc, "ColladaCache");
-
+// The cache holds the structures filled from a Collada file in binary form,
+// so that loading it again does not need to parse any XML.
+
+#define COLLADA_CACHE_TAG MKTAG('H', 'P', 'L', 'C')
+
+// Increase when the layout of the cache changes
+static const uint32 kColladaCacheVersion = 1;
+
+enum eColladaCacheSection {
+	eColladaCacheSection_Images = 1 << 0,
+	eColladaCacheSection_Textures = 1 << 1,
+	eColladaCacheSection_Materials = 1 << 2,
+	eColladaCacheSection_Lights = 1 << 3,
+	eColladaCacheSection_Animations = 1 << 4,
+	eColladaCacheSection_Controllers = 1 << 5,
+	eColladaCacheSection_Geometries = 1 << 6,
+	eColladaCacheSection_Scene = 1 << 7
+};
+
+static uint32 GetCacheSections(tColladaImageVec *apColladaImageVec,
+							   tColladaTextureVec *apColladaTextureVec,
+							   tColladaMaterialVec *apColladaMaterialVec,
+							   tColladaLightVec *apColladaLightVec,
+							   tColladaGeometryVec *apColladaGeometryVec,
+							   tColladaControllerVec *apColladaControllerVec,
+							   tColladaAnimationVec *apColladaAnimVec,
+							   cColladaScene *apColladaScene) {
+	uint32 lSections = 0;
 	if (apColladaImageVec)
-		SaveImageVec(pRootElem, apColladaImageVec);
+		lSections |= eColladaCacheSection_Images;
 	if (apColladaTextureVec)
-		SaveTextureVec(pRootElem, apColladaTextureVec);
+		lSections |= eColladaCacheSection_Textures;
 	if (apColladaMaterialVec)
-		SaveMaterialVec(pRootElem, apColladaMaterialVec);
+		lSections |= eColladaCacheSection_Materials;
 	if (apColladaLightVec)
-		SaveLightVec(pRootElem, apColladaLightVec);
+		lSections |= eColladaCacheSection_Lights;
 	if (apColladaAnimVec)
-		SaveAnimationVec(pRootElem, apColladaAnimVec);
+		lSections |= eColladaCacheSection_Animations;
 	if (apColladaControllerVec)
-		SaveControllerVec(pRootElem, apColladaControllerVec);
+		lSections |= eColladaCacheSection_Controllers;
 	if (apColladaGeometryVec)
-		SaveGeometryVec(pRootElem, apColladaGeometryVec);
+		lSections |= eColladaCacheSection_Geometries;
 	if (apColladaScene)
-		SaveScene(pRootElem, apColladaScene);
-
-	if (pXmlDoc->SaveFile() == false) {
-		Error("Couldn't save XML file %s\n", asFile.c_str());
-		hplDelete(pXmlDoc);
-		return false;
-	}
-	hplDelete(pXmlDoc);
-	return true;
+		lSections |= eColladaCacheSection_Scene;
+	return lSections;
 }
 
 //-----------------------------------------------------------------------
 
-static void SaveImageVec(TiXmlElement *apRootElem, tColladaImageVec *apColladaImageVec) {
-	TiXmlElement *pImageRootElem = CreateXMLChild(apRootElem, "ImageRoot");
+static void WriteString(Common::WriteStream *apStream, const tString &asString) {
+	apStream->writeUint32LE(asString.size());
+	apStream->write(asString.c_str(), asString.size());
+}
 
-	pImageRootElem->SetAttribute("Size", (int)apColladaImageVec->size());
+static void WriteVector3f(Common::WriteStream *apStream, const cVector3f &avVec) {
+	apStream->writeFloatLE(avVec.x);
+	apStream->writeFloatLE(avVec.y);
+	apStream->writeFloatLE(avVec.z);
+}
 
-	for (size_t i = 0; i < apColladaImageVec->size(); ++i) {
-		cColladaImage *pImage = &(*apColladaImageVec)[i];
+static void WriteColor(Common::WriteStream *apStream, const cColor &aColor) {
+	apStream->writeFloatLE(aColor.r);
+	apStream->writeFloatLE(aColor.g);
+	apStream->writeFloatLE(aColor.b);
+	apStream->writeFloatLE(aColor.a);
+}
 
-		TiXmlElement *pImageElem = CreateXMLChild(pImageRootElem, "Image");
+static void WriteMatrix(Common::WriteStream *apStream, const cMatrixf &a_mtxMatrix) {
+	for (int i = 0; i < 16; ++i)
+		apStream->writeFloatLE(a_mtxMatrix.v[i]);
+}
 
-		pImageElem->SetAttribute("Id", pImage->msId.c_str());
-		pImageElem->SetAttribute("Name", pImage->msName.c_str());
-		pImageElem->SetAttribute("Source", cString::GetFileName(pImage->msSource.c_str()).c_str());
-	}
+static void WriteFloatVec(Common::WriteStream *apStream, const tFloatVec &avVec) {
+	apStream->writeUint32LE(avVec.size());
+	for (size_t i = 0; i < avVec.size(); ++i)
+		apStream->writeFloatLE(avVec[i]);
 }
 
 //-----------------------------------------------------------------------
 
-static void SaveTextureVec(TiXmlElement *apRootElem, tColladaTextureVec *apColladaTextureVec) {
-	TiXmlElement *pTextureRootElem = CreateXMLChild(apRootElem, "TextureRoot");
-
-	pTextureRootElem->SetAttribute("Size", (int)apColladaTextureVec->size());
+static void SaveImageVec(Common::WriteStream *apStream, tColladaImageVec *apColladaImageVec) {
+	apStream->writeUint32LE(apColladaImageVec->size());
+	for (size_t i = 0; i < apColladaImageVec->size(); ++i) {
+		cColladaImage &image = (*apColladaImageVec)[i];
+		WriteString(apStream, image.msId);
+		WriteString(apStream, image.msName);
+		WriteString(apStream, image.msSource);
+	}
+}
 
+static void SaveTextureVec(Common::WriteStream *apStream, tColladaTextureVec *apColladaTextureVec) {
+	apStream->writeUint32LE(apColladaTextureVec->size());
 	for (size_t i = 0; i < apColladaTextureVec->size(); ++i) {
-		cColladaTexture *pTexture = &(*apColladaTextureVec)[i];
-
-		TiXmlElement *pTextureElem = CreateXMLChild(pTextureRootElem, "Texture");
-
-		pTextureElem->SetAttribute("Id", pTexture->msId.c_str());
-		pTextureElem->SetAttribute("Name", pTexture->msName.c_str());
-		pTextureElem->SetAttribute("Image", pTexture->msImage.c_str());
+		cColladaTexture &texture = (*apColladaTextureVec)[i];
+		WriteString(apStream, texture.msId);
+		WriteString(apStream, texture.msName);
+		WriteString(apStream, texture.msImage);
 	}
 }
 
-//-----------------------------------------------------------------------
-
-static void SaveMaterialVec(TiXmlElement *apRootElem, tColladaMaterialVec *apColladaMaterialVec) {
-	TiXmlElement *pMaterialRootElem = CreateXMLChild(apRootElem, "MaterialRoot");
-
-	pMaterialRootElem->SetAttribute("Size", (int)apColladaMaterialVec->size());
-
+static void SaveMaterialVec(Common::WriteStream *apStream, tColladaMaterialVec *apColladaMaterialVec) {
+	apStream->writeUint32LE(apColladaMaterialVec->size());
 	for (size_t i = 0; i < apColladaMaterialVec->size(); ++i) {
-		cColladaMaterial *pMaterial = &(*apColladaMaterialVec)[i];
-
-		TiXmlElement *pMaterialElem = CreateXMLChild(pMaterialRootElem, "Material");
-
-		pMaterialElem->SetAttribute("Id", pMaterial->msId.c_str());
-		pMaterialElem->SetAttribute("Name", pMaterial->msName.c_str());
-		pMaterialElem->SetAttribute("Texture", pMaterial->msTexture.c_str());
-		pMaterialElem->SetAttribute("Color", pMaterial->mDiffuseColor.ToFileString().c_str());
+		cColladaMaterial &material = (*apColladaMaterialVec)[i];
+		WriteString(apStream, material.msId);
+		WriteString(apStream, material.msName);
+		WriteString(apStream, material.msTexture);
+		WriteColor(apStream, material.mDiffuseColor);
 	}
 }
 
-//-----------------------------------------------------------------------
-
-static void SaveLightVec(TiXmlElement *apRootElem, tColladaLightVec *apColladaLightVec) {
-	TiXmlElement *pLightRootElem = CreateXMLChild(apRootElem, "LightRoot");
-
-	pLightRootElem->SetAttribute("Size", (int)apColladaLightVec->size());
-
+static void SaveLightVec(Common::WriteStream *apStream, tColladaLightVec *apColladaLightVec) {
+	apStream->writeUint32LE(apColladaLightVec->size());
 	for (size_t i = 0; i < apColladaLightVec->size(); ++i) {
-		cColladaLight *pLight = &(*apColladaLightVec)[i];
-
-		TiXmlElement *pLightElem = CreateXMLChild(pLightRootElem, "Light");
-
-		// Log("Light %s\n",pLight->msName.c_str());
-
-		pLightElem->SetAttribute("Id", pLight->msId.c_str());
-		pLightElem->SetAttribute("Name", pLight->msName.c_str());
-		pLightElem->SetAttribute("Type", pLight->msType.c_str());
-
-		pLightElem->SetAttribute("Angle", cString::ToString(pLight->mfAngle).c_str());
-		pLightElem->SetAttribute("Color", pLight->mDiffuseColor.ToFileString().c_str());
+		cColladaLight &light = (*apColladaLightVec)[i];
+		WriteString(apStream, light.msId);
+		WriteString(apStream, light.msName);
+		WriteString(apStream, light.msType);
+		WriteColor(apStream, light.mDiffuseColor);
+		apStream->writeFloatLE(light.mfAngle);
 	}
 }
 
-//-----------------------------------------------------------------------
-
-static void SaveAnimationVec(TiXmlElement *apRootElem, tColladaAnimationVec *apColladaAnimationVec) {
-	TiXmlElement *pAnimationRootElem = CreateXMLChild(apRootElem, "AnimationRoot");
-
-	pAnimationRootElem->SetAttribute("Size", (int)apColladaAnimationVec->size());
-
+static void SaveAnimationVec(Common::WriteStream *apStream, tColladaAnimationVec *apColladaAnimationVec) {
+	apStream->writeUint32LE(apColladaAnimationVec->size());
 	for (size_t i = 0; i < apColladaAnimationVec->size(); ++i) {
-		cColladaAnimation *pAnimation = &(*apColladaAnimationVec)[i];
-
-		TiXmlElement *pAnimationElem = CreateXMLChild(pAnimationRootElem, "Animation");
-
-		pAnimationElem->SetAttribute("Id", pAnimation->msId.c_str());
-		pAnimationElem->SetAttribute("TargetNode", pAnimation->msTargetNode.c_str());
-
-		/////////////////////////////////////
-		// Channels
-		{
-			TiXmlElement *pChannelVecElem = CreateXMLChild(pAnimationElem, "ChannelVec");
-			pChannelVecElem->SetAttribute("Size", (int)pAnimation->mvChannels.size());
-
-			for (size_t idx = 0; idx < pAnimation->mvChannels.size(); ++idx) {
-				cColladaChannel *pChannel = &pAnimation->mvChannels[idx];
-				TiXmlElement *pChannelElem = CreateXMLChild(pChannelVecElem, "Channel");
-
-				pChannelElem->SetAttribute("Id", pChannel->msId.c_str());
-				pChannelElem->SetAttribute("Target", pChannel->msTarget.c_str());
-				pChannelElem->SetAttribute("Source", pChannel->msSource.c_str());
-			}
+		cColladaAnimation &anim = (*apColladaAnimationVec)[i];
+		WriteString(apStream, anim.msId);
+		WriteString(apStream, anim.msTargetNode);
+
+		apStream->writeUint32LE(anim.mvChannels.size());
+		for (size_t j = 0; j < anim.mvChannels.size(); ++j) {
+			WriteString(apStream, anim.mvChannels[j].msId);
+			WriteString(apStream, anim.mvChannels[j].msTarget);
+			WriteString(apStream, anim.mvChannels[j].msSource);
 		}
-		/////////////////////////////////////
-		// Samplers
-		{
-			TiXmlElement *pSamplerVecElem = CreateXMLChild(pAnimationElem, "SamplerVec");
-			pSamplerVecElem->SetAttribute("Size", (int)pAnimation->mvSamplers.size());
-
-			for (size_t idx = 0; idx < pAnimation->mvSamplers.size(); ++idx) {
-				cColladaSampler *pSampler = &pAnimation->mvSamplers[idx];
-				TiXmlElement *pSamplerElem = CreateXMLChild(pSamplerVecElem, "Sampler");
-
-				pSamplerElem->SetAttribute("Id", pSampler->msId.c_str());
-				pSamplerElem->SetAttribute("TimeArray", pSampler->msTimeArray.c_str());
-				pSamplerElem->SetAttribute("ValueArray", pSampler->msValueArray.c_str());
-				pSamplerElem->SetAttribute("Target", pSampler->msTarget.c_str());
-			}
+
+		apStream->writeUint32LE(anim.mvSamplers.size());
+		for (size_t j = 0; j < anim.mvSamplers.size(); ++j) {
+			WriteString(apStream, anim.mvSamplers[j].msId);
+			WriteString(apStream, anim.mvSamplers[j].msTimeArray);
+			WriteString(apStream, anim.mvSamplers[j].msValueArray);
+			WriteString(apStream, anim.mvSamplers[j].msTarget);
 		}
-		/////////////////////////////////////
-		// Sources
-		{
-			TiXmlElement *pSourceVecElem = CreateXMLChild(pAnimationElem, "SourceVec");
-			pSourceVecElem->SetAttribute("Size", (int)pAnimation->mvSources.size());
-
-			for (size_t idx = 0; idx < pAnimation->mvSources.size(); ++idx) {
-				cColladaAnimSource *pSource = &pAnimation->mvSources[idx];
-				TiXmlElement *pSourceElem = CreateXMLChild(pSourceVecElem, "Source");
-
-				pSourceElem->SetAttribute("Id", pSource->msId.c_str());
-				tString sData = "";
-				for (size_t j = 0; j < pSource->mvValues.size(); ++j)
-					sData += cString::ToString(pSource->mvValues[j]) + " ";
-
-				pSourceElem->SetAttribute("Values", sData.c_str());
-			}
+
+		apStream->writeUint32LE(anim.mvSources.size());
+		for (size_t j = 0; j < anim.mvSources.size(); ++j) {
+			WriteString(apStream, anim.mvSources[j].msId);
+			WriteFloatVec(apStream, anim.mvSources[j].mvValues);
 		}
 	}
 }
 
-//-----------------------------------------------------------------------
-
-static void SaveControllerVec(TiXmlElement *apRootElem, tColladaControllerVec *apColladaControllerVec) {
-	TiXmlElement *pControllerRootElem = CreateXMLChild(apRootElem, "ControllerRoot");
-
-	pControllerRootElem->SetAttribute("Size", (int)apColladaControllerVec->size());
-
+static void SaveControllerVec(Common::WriteStream *apStream, tColladaControllerVec *apColladaControllerVec) {
+	apStream->writeUint32LE(apColladaControllerVec->size());
 	for (size_t i = 0; i < apColladaControllerVec->size(); ++i) {
-		cColladaController *pController = &(*apColladaControllerVec)[i];
-
-		TiXmlElement *pControllerElem = CreateXMLChild(pControllerRootElem, "Controller");
-
-		pControllerElem->SetAttribute("Id", pController->msId.c_str());
-		pControllerElem->SetAttribute("Target", pController->msTarget.c_str());
-
-		pControllerElem->SetAttribute("BindShapeMatrix", pController->m_mtxBindShapeMatrix.ToFileString().c_str());
-
-		pControllerElem->SetAttribute("JointPairIdx", pController->mlJointPairIdx);
-		pControllerElem->SetAttribute("WeightPairIdx", pController->mlWeightPairIdx);
-
-		///////////////////////
-		// Joints
-		{
-			TiXmlElement *pJointsElem = CreateXMLChild(pControllerElem, "Joints");
-			pJointsElem->SetAttribute("Size", (int)pController->mvJoints.size());
-
-			tString sData;
-			for (size_t idx = 0; idx < pController->mvJoints.size(); ++idx) {
-				sData += pController->mvJoints[idx] + " ";
-			}
-			CreateXMLTextChild(pJointsElem, sData.c_str());
-		}
-		///////////////////////
-		// Weights
-		{
-			TiXmlElement *pWeightsElem = CreateXMLChild(pControllerElem, "Weights");
-			pWeightsElem->SetAttribute("Size", (int)pController->mvWeights.size());
-
-			tString sData = "";
-			for (size_t idx = 0; idx < pController->mvWeights.size(); ++idx) {
-				sData += cString::ToString(pController->mvWeights[idx]) + " ";
-			}
-			CreateXMLTextChild(pWeightsElem, sData.c_str());
-		}
-		///////////////////////
-		// Matrices
-		{
-			TiXmlElement *pMatricesElem = CreateXMLChild(pControllerElem, "Matrices");
-			pMatricesElem->SetAttribute("Size", (int)pController->mvMatrices.size());
-
-			tString sData = "";
-			for (size_t idx = 0; idx < pController->mvMatrices.size(); ++idx) {
-				sData += pController->mvMatrices[idx].ToFileString() + " ";
-			}
-			CreateXMLTextChild(pMatricesElem, sData.c_str());
-		}
-		///////////////////////
-		// Pairs
-		{
-			TiXmlElement *pPairVecElem = CreateXMLChild(pControllerElem, "PairVec");
-			pPairVecElem->SetAttribute("Size", (int)pController->mvPairs.size());
-
-			tIntVec vPairNumVec;
-			Hpl1::resizeAndFill(vPairNumVec, pController->mvPairs.size(), 0);
-
-			////////////////////////////////
-			// The pair connections
-			int lCount = 0;
-			TiXmlElement *pPairsElem = CreateXMLChild(pPairVecElem, "Pairs");
-			tString sData = "";
-			for (size_t idx = 0; idx < pController->mvPairs.size(); ++idx) {
-				tColladaJointPairList *pList = &pController->mvPairs[idx];
-
-				for (tColladaJointPairListIt it = pList->begin(); it != pList->end(); ++it) {
-					cColladaJointPair &Pair = *it;
-					sData += cString::ToString(Pair.mlJoint) + " " + cString::ToString(Pair.mlWeight) + " ";
-					++lCount;
-					++vPairNumVec[idx];
-				}
+		cColladaController &controller = (*apColladaControllerVec)[i];
+		WriteString(apStream, controller.msTarget);
+		WriteString(apStream, controller.msId);
+		WriteMatrix(apStream, controller.m_mtxBindShapeMatrix);
+		apStream->writeSint32LE(controller.mlJointPairIdx);
+		apStream->writeSint32LE(controller.mlWeightPairIdx);
+
+		apStream->writeUint32LE(controller.mvJoints.size());
+		for (size_t j = 0; j < controller.mvJoints.size(); ++j)
+			WriteString(apStream, controller.mvJoints[j]);
+
+		WriteFloatVec(apStream, controller.mvWeights);
+
+		apStream->writeUint32LE(controller.mvMatrices.size());
+		for (size_t j = 0; j < controller.mvMatrices.size(); ++j)
+			WriteMatrix(apStream, controller.mvMatrices[j]);
+
+		apStream->writeUint32LE(controller.mvPairs.size());
+		for (size_t j = 0; j < controller.mvPairs.size(); ++j) {
+			tColladaJointPairList &lstPairs = controller.mvPairs[j];
+			apStream->writeUint32LE(lstPairs.size());
+			for (tColladaJointPairListIt it = lstPairs.begin(); it != lstPairs.end(); ++it) {
+				apStream->writeSint32LE(it->mlJoint);
+				apStream->writeSint32LE(it->mlWeight);
 			}
-			CreateXMLTextChild(pPairsElem, sData.c_str());
-			pPairsElem->SetAttribute("Size", lCount);
-
-			////////////////////////////////
-			// The pair numbers
-			TiXmlElement *pPairNumElem = CreateXMLChild(pPairVecElem, "PairNum");
-			sData = "";
-			for (size_t idx = 0; idx < pController->mvPairs.size(); ++idx) {
-				sData += cString::ToString(vPairNumVec[idx]) + " ";
-			}
-			CreateXMLTextChild(pPairNumElem, sData.c_str());
 		}
 	}
 }
 
-//-----------------------------------------------------------------------
-
-static void SaveGeometryVec(TiXmlElement *apRootElem, tColladaGeometryVec *apColladaGeometryVec) {
-	TiXmlElement *pGeometryRootElem = CreateXMLChild(apRootElem, "GeometryRoot");
-
-	pGeometryRootElem->SetAttribute("Size", (int)apColladaGeometryVec->size());
-
+static void SaveGeometryVec(Common::WriteStream *apStream, tColladaGeometryVec *apColladaGeometryVec) {
+	apStream->writeUint32LE(apColladaGeometryVec->size());
 	for (size_t i = 0; i < apColladaGeometryVec->size(); ++i) {
-		cColladaGeometry *pGeometry = &(*apColladaGeometryVec)[i];
-
-		TiXmlElement *pGeometryElem = CreateXMLChild(pGeometryRootElem, "Geometry");
-
-		/////////////////////////////////7
-		// Main properties
-		pGeometryElem->SetAttribute("Id", pGeometry->msId.c_str());
-		pGeometryElem->SetAttribute("Name", pGeometry->msName.c_str());
-
-		pGeometryElem->SetAttribute("Material", pGeometry->msMaterial.c_str());
-
-		/////////////////////////////////
-		// Vertex properties
-		// Should not be needed.
-		/*pGeometryElem->SetAttribute("PosIdxNum",pGeometry->mlPosIdxNum);
-		pGeometryElem->SetAttribute("NormIdxNum",pGeometry->mlNormIdxNum);
-		pGeometryElem->SetAttribute("TexIdxNum",pGeometry->mlTexIdxNum);
-
-		pGeometryElem->SetAttribute("PosArrayIdx",pGeometry->mlPosArrayIdx);
-		pGeometryElem->SetAttribute("NormArrayIdx",pGeometry->mlNormArrayIdx);
-		pGeometryElem->SetAttribute("TexArrayIdx",pGeometry->mlTexArrayIdx); */
-
-		/////////////////////////////////
-		// Index Vec
-		TiXmlElement *pIndexVecElem = CreateXMLChild(pGeometryElem, "IndexVec");
-
-		pIndexVecElem->SetAttribute("Size", (int)pGeometry->mvIndexVec.size());
-
-		TiXmlElement *pIndicesDataElem = CreateXMLChild(pIndexVecElem, "Indices");
-
-		tString sIndexVec = "";
-		for (size_t j = 0; j < pGeometry->mvIndexVec.size(); ++j) {
-			sIndexVec += cString::ToString((int)pGeometry->mvIndexVec[j]) + " ";
-		}
-		TiXmlText *pIndecVecText = CreateXMLTextChild(pIndicesDataElem, "Data");
-		pIndecVecText->SetValue(sIndexVec.c_str());
-
-		/////////////////////////////////
-		// Vertex vec
-		TiXmlElement *pVertexVecElem = CreateXMLChild(pGeometryElem, "VertexVec");
-		pVertexVecElem->SetAttribute("Size", (int)pGeometry->mvVertexVec.size());
-		{
-			/////////////////////////////////
-			// Positions
-			tString sData = "";
-			for (size_t j = 0; j < pGeometry->mvVertexVec.size(); ++j) {
-				sData += pGeometry->mvVertexVec[j].pos.ToFileString() + " ";
-			}
-			TiXmlElement *pDataElem = CreateXMLChild(pVertexVecElem, "Positions");
-			TiXmlText *pVecText = CreateXMLTextChild(pDataElem, "Data");
-			pVecText->SetValue(sData.c_str());
-
-			/////////////////////////////////
-			// Normals
-			sData = "";
-			for (size_t j = 0; j < pGeometry->mvVertexVec.size(); ++j) {
-				sData += pGeometry->mvVertexVec[j].norm.ToFileString() + " ";
-			}
-			pDataElem = CreateXMLChild(pVertexVecElem, "Normals");
-			pVecText = CreateXMLTextChild(pDataElem, "Data");
-			pVecText->SetValue(sData.c_str());
-
-			/////////////////////////////////
-			// UVs
-			sData = "";
-			for (size_t j = 0; j < pGeometry->mvVertexVec.size(); ++j) {
-				sData += pGeometry->mvVertexVec[j].tex.ToFileString() + " ";
-			}
-			pDataElem = CreateXMLChild(pVertexVecElem, "UV");
-			pVecText = CreateXMLTextChild(pDataElem, "Data");
-			pVecText->SetValue(sData.c_str());
-
-			/////////////////////////////////
-			// Tangents
-			sData = "";
-			char sTemp[20];
-			for (size_t j = 0; j < pGeometry->mvTangents.size(); ++j) {
-				snprintf(sTemp, 20, "%g ", pGeometry->mvTangents[j]);
-				sData += sTemp;
-			}
-			pDataElem = CreateXMLChild(pVertexVecElem, "Tangents");
-			CreateXMLTextChild(pDataElem, sData.c_str());
+		cColladaGeometry &geom = (*apColladaGeometryVec)[i];
+		WriteString(apStream, geom.msId);
+		WriteString(apStream, geom.msName);
+		WriteString(apStream, geom.msMaterial);
+
+		apStream->writeUint32LE(geom.mvVertexVec.size());
+		for (size_t j = 0; j < geom.mvVertexVec.size(); ++j) {
+			const cVertex &vtx = geom.mvVertexVec[j];
+			WriteVector3f(apStream, vtx.pos);
+			WriteVector3f(apStream, vtx.tex);
+			WriteVector3f(apStream, vtx.tan);
+			WriteVector3f(apStream, vtx.norm);
+			WriteColor(apStream, vtx.col);
 		}
 
-		/////////////////////////////////
-		// Extra vertex vec
-		// if(false)
-		{
-			TiXmlElement *pExtraVertexVecElem = CreateXMLChild(pGeometryElem, "ExtraVertexVec");
-			pExtraVertexVecElem->SetAttribute("Size", (int)pGeometry->mvExtraVtxVec.size());
-
-			tUIntVec vExtraNum;
-			Hpl1::resizeAndFill(vExtraNum, pGeometry->mvExtraVtxVec.size(), 0);
-
-			////////////////////////////
-			// Extra vertices
-			tString sData = "";
-			int lExtraCount = 0;
-			TiXmlElement *pExtraElem = CreateXMLChild(pExtraVertexVecElem, "ExtraVertex");
-			for (size_t idx = 0; idx < pGeometry->mvExtraVtxVec.size(); ++idx) {
-				tColladaExtraVtxList *pList = &pGeometry->mvExtraVtxVec[idx];
-
-				tColladaExtraVtxListIt it = pList->begin();
-				for (; it != pList->end(); ++it) {
-					cColladaExtraVtx &extra = *it;
-					sData += cString::ToString(extra.mlVtx) + " " +
-							 cString::ToString(extra.mlNorm) + " " +
-							 cString::ToString(extra.mlTex) + " " +
-							 cString::ToString(extra.mlNewVtx) + " ";
-					++lExtraCount;
-					++vExtraNum[idx];
-				}
-			}
-			CreateXMLTextChild(pExtraElem, sData.c_str());
-			pExtraElem->SetAttribute("Size", (int)lExtraCount);
-
-			////////////////////////////
-			// Extra num
-			sData = "";
-			TiXmlElement *pExtraNumElem = CreateXMLChild(pExtraVertexVecElem, "ExtraNum");
-			for (size_t idx = 0; idx < pGeometry->mvExtraVtxVec.size(); ++idx) {
-				sData += cString::ToString((int)vExtraNum[idx]) + " ";
+		apStream->writeUint32LE(geom.mvIndexVec.size());
+		for (size_t j = 0; j < geom.mvIndexVec.size(); ++j)
+			apStream->writeUint32LE(geom.mvIndexVec[j]);
+
+		WriteFloatVec(apStream, geom.mvTangents);
+
+		apStream->writeUint32LE(geom.mvExtraVtxVec.size());
+		for (size_t j = 0; j < geom.mvExtraVtxVec.size(); ++j) {
+			tColladaExtraVtxList &lstExtra = geom.mvExtraVtxVec[j];
+			apStream->writeUint32LE(lstExtra.size());
+			for (tColladaExtraVtxListIt it = lstExtra.begin(); it != lstExtra.end(); ++it) {
+				apStream->writeSint32LE(it->mlVtx);
+				apStream->writeSint32LE(it->mlNorm);
+				apStream->writeSint32LE(it->mlTex);
+				apStream->writeSint32LE(it->mlNewVtx);
 			}
-			CreateXMLTextChild(pExtraNumElem, sData.c_str());
 		}
 	}
 }
 
-//-----------------------------------------------------------------------
-
-static void SaveIterativeNode(TiXmlElement *apParentElem, cColladaNode *apParentNode) {
-	tColladaNodeListIt it = apParentNode->mlstChildren.begin();
-	for (; it != apParentNode->mlstChildren.end(); ++it) {
+static void SaveIterativeNode(Common::WriteStream *apStream, cColladaNode *apParentNode) {
+	apStream->writeUint32LE(apParentNode->mlstChildren.size());
+	for (tColladaNodeListIt it = apParentNode->mlstChildren.begin(); it != apParentNode->mlstChildren.end(); ++it) {
 		cColladaNode *pNode = *it;
-		TiXmlElement *pNodeElem = CreateXMLChild(apParentElem, "Node");
-
-		pNodeElem->SetAttribute("Id", pNode->msId.c_str());
-		pNodeElem->SetAttribute("Name", pNode->msName.c_str());
-		pNodeElem->SetAttribute("Type", pNode->msType.c_str());
-
-		pNodeElem->SetAttribute("Source", pNode->msSource.c_str());
-		pNodeElem->SetAttribute("SourceIsFile", pNode->mbSourceIsFile ? "true" : "false");
-
-		pNodeElem->SetAttribute("Transform", pNode->m_mtxTransform.ToFileString().c_str());
-		pNodeElem->SetAttribute("WorldTransform", pNode->m_mtxWorldTransform.ToFileString().c_str());
-
-		pNodeElem->SetAttribute("Scale", pNode->mvScale.ToFileString().c_str());
-
-		pNodeElem->SetAttribute("Count", pNode->mlCount);
-
-		TiXmlElement *pTransformRootElem = CreateXMLChild(pNodeElem, "TransformRoot");
-		// tColladaTransformList mlstTransforms;
-		tColladaTransformListIt transIt = pNode->mlstTransforms.begin();
-		for (; transIt != pNode->mlstTransforms.end(); ++transIt) {
-			cColladaTransform &transform = *transIt;
-			TiXmlElement *pTransformElem = CreateXMLChild(pTransformRootElem, "Transform");
-
-			pTransformElem->SetAttribute("Sid", transform.msSid.c_str());
-			pTransformElem->SetAttribute("Type", transform.msType.c_str());
-
-			tString sValues = "";
-			for (size_t i = 0; i < transform.mvValues.size(); ++i)
-				sValues += cString::ToString(transform.mvValues[i]) + " ";
-
-			pTransformElem->SetAttribute("Values", sValues.c_str());
+		WriteString(apStream, pNode->msId);
+		WriteString(apStream, pNode->msName);
+		WriteString(apStream, pNode->msType);
+		WriteString(apStream, pNode->msSource);
+		apStream->writeByte(pNode->mbSourceIsFile ? 1 : 0);
+		WriteMatrix(apStream, pNode->m_mtxTransform);
+		WriteMatrix(apStream, pNode->m_mtxWorldTransform);
+		WriteVector3f(apStream, pNode->mvScale);
+		apStream->writeSint32LE(pNode->mlCount);
+
+		apStream->writeUint32LE(pNode->mlstTransforms.size());
+		for (tColladaTransformListIt transIt = pNode->mlstTransforms.begin(); transIt != pNode->mlstTransforms.end(); ++transIt) {
+			WriteString(apStream, transIt->msSid);
+			WriteString(apStream, transIt->msType);
+			WriteFloatVec(apStream, transIt->mvValues);
 		}
 
-		SaveIterativeNode(pNodeElem, pNode);
+		SaveIterativeNode(apStream, pNode);
 	}
 }
 
-static void SaveScene(TiXmlElement *apRootElem, cColladaScene *apColladaScene) {
-	TiXmlElement *pSceneElem = CreateXMLChild(apRootElem, "Scene");
-
-	pSceneElem->SetAttribute("StartTime", cString::ToString(apColladaScene->mfStartTime).c_str());
-	pSceneElem->SetAttribute("EndTime", cString::ToString(apColladaScene->mfEndTime).c_str());
-	pSceneElem->SetAttribute("DeltaTime", cString::ToString(apColladaScene->mfDeltaTime).c_str());
-
-	TiXmlElement *pSceneRootElem = CreateXMLChild(pSceneElem, "Root");
-
-	SaveIterativeNode(pSceneRootElem, &apColladaScene->mRoot);
+static void SaveScene(Common::WriteStream *apStream, cColladaScene *apColladaScene) {
+	apStream->writeFloatLE(apColladaScene->mfStartTime);
+	apStream->writeFloatLE(apColladaScene->mfEndTime);
+	apStream->writeFloatLE(apColladaScene->mfDeltaTime);
+	SaveIterativeNode(apStream, &apColladaScene->mRoot);
 }
 
 //-----------------------------------------------------------------------
 
-//////////////////////////////////////////////////////////////////////////
-// LOAD COLLADA DATA
-//////////////////////////////////////////////////////////////////////////
-
-//-----------------------------------------------------------------------
-
-static void LoadImageVec(TiXmlElement *apRootElem, tColladaImageVec *apColladaImageVec);
-static void LoadTextureVec(TiXmlElement *apRootElem, tColladaTextureVec *apColladaTextureVec);
-static void LoadMaterialVec(TiXmlElement *apRootElem, tColladaMaterialVec *apColladaMaterialVec);
-static void LoadLightVec(TiXmlElement *apRootElem, tColladaLightVec *apColladaLightVec);
-static void LoadAnimationVec(TiXmlElement *apRootElem, tColladaAnimationVec *apColladaAnimVec);
-static void LoadControllerVec(TiXmlElement *apRootElem, tColladaControllerVec *apColladaControllerVec);
-static void LoadGeometryVec(TiXmlElement *apRootElem, tColladaGeometryVec *apColladaGeometryVec);
-static void LoadScene(TiXmlElement *apRootElem, cColladaScene *apColladaScene);
-
-bool cMeshLoaderCollada::LoadStructures(const tString &asFile,
+bool cMeshLoaderCollada::SaveStructures(const tString &asFile, uint32 alSourceSize, uint32 alSourceChecksum,
 										tColladaImageVec *apColladaImageVec,
 										tColladaTextureVec *apColladaTextureVec,
 										tColladaMaterialVec *apColladaMaterialVec,
@@ -794,570 +612,355 @@ bool cMeshLoaderCollada::LoadStructures(const tString &asFile,
 										tColladaControllerVec *apColladaControllerVec,
 										tColladaAnimationVec *apColladaAnimVec,
 										cColladaScene *apColladaScene) {
-	// unsigned long lStartTime = mpSystem->GetLowLevel()->GetTime();
-
-	TiXmlDocument *pXmlDoc = hplNew(TiXmlDocument, (asFile.c_str()));
-	if (pXmlDoc->LoadFile() == false) {
-		Warning("Couldn't open XML file %s\n", asFile.c_str());
-		hplDelete(pXmlDoc);
+	Common::ScopedPtr<Common::OutSaveFile> pCacheFile(g_engine->getSaveFileManager()->openForSaving(asFile, false));
+	if (!pCacheFile) {
+		Hpl1::logWarning(Hpl1::kDebugResourceLoading, "couldn't create collada cache file '%s'\n", asFile.c_str());
 		return false;
 	}
 
-	// unsigned long lTime = mpSystem->GetLowLevel()->GetTime() - lStartTime;
-	// Log("Loading cached collada XML file '%s' took: %d ms\n",asFile.c_str(),lTime);
-
-	TiXmlElement *pRootElem = pXmlDoc->RootElement();
+	pCacheFile->writeUint32BE(COLLADA_CACHE_TAG);
+	pCacheFile->writeUint32LE(kColladaCacheVersion);
+	pCacheFile->writeUint32LE(alSourceSize);
+	pCacheFile->writeUint32LE(alSourceChecksum);
+	pCacheFile->writeUint32LE(GetCacheSections(apColladaImageVec, apColladaTextureVec, apColladaMaterialVec,
+											   apColladaLightVec, apColladaGeometryVec, apColladaControllerVec,
+											   apColladaAnimVec, apColladaScene));
+	pCacheFile->writeByte(mbZToY ? 1 : 0);
 
 	if (apColladaImageVec)
-		LoadImageVec(pRootElem, apColladaImageVec);
+		SaveImageVec(pCacheFile.get(), apColladaImageVec);
 	if (apColladaTextureVec)
-		LoadTextureVec(pRootElem, apColladaTextureVec);
+		SaveTextureVec(pCacheFile.get(), apColladaTextureVec);
 	if (apColladaMaterialVec)
-		LoadMaterialVec(pRootElem, apColladaMaterialVec);
+		SaveMaterialVec(pCacheFile.get(), apColladaMaterialVec);
 	if (apColladaLightVec)
-		LoadLightVec(pRootElem, apColladaLightVec);
+		SaveLightVec(pCacheFile.get(), apColladaLightVec);
 	if (apColladaAnimVec)
-		LoadAnimationVec(pRootElem, apColladaAnimVec);
+		SaveAnimationVec(pCacheFile.get(), apColladaAnimVec);
 	if (apColladaControllerVec)
-		LoadControllerVec(pRootElem, apColladaControllerVec);
+		SaveControllerVec(pCacheFile.get(), apColladaControllerVec);
 	if (apColladaGeometryVec)
-		LoadGeometryVec(pRootElem, apColladaGeometryVec);
+		SaveGeometryVec(pCacheFile.get(), apColladaGeometryVec);
 	if (apColladaScene)
-		LoadScene(pRootElem, apColladaScene);
+		SaveScene(pCacheFile.get(), apColladaScene);
 
-	hplDelete(pXmlDoc);
+	pCacheFile->finalize();
+	if (pCacheFile->err()) {
+		Hpl1::logWarning(Hpl1::kDebugResourceLoading, "couldn't write collada cache file '%s'\n", asFile.c_str());
+		pCacheFile.reset();
+		g_engine->getSaveFileManager()->removeSavefile(asFile);
+		return false;
+	}
 	return true;
 }
 
 //-----------------------------------------------------------------------
 
-static void LoadImageVec(TiXmlElement *apRootElem, tColladaImageVec *apColladaImageVec) {
-	TiXmlElement *pImageRootElem = apRootElem->FirstChildElement("ImageRoot");
-
-	int lSize = cString::ToInt(pImageRootElem->Attribute("Size"), 0);
-
-	apColladaImageVec->clear();
-	apColladaImageVec->resize(lSize);
+//////////////////////////////////////////////////////////////////////////
+// LOAD COLLADA DATA
+//////////////////////////////////////////////////////////////////////////
 
-	int lCount = 0;
-	TiXmlElement *pImageElem = pImageRootElem->FirstChildElement();
-	for (; pImageElem != NULL; pImageElem = pImageElem->NextSiblingElement(), ++lCount) {
-		cColladaImage *pImage = &(*apColladaImageVec)[lCount];
+//-----------------------------------------------------------------------
 
-		pImage->msId = pImageElem->Attribute("Id");
-		pImage->msName = pImageElem->Attribute("Name");
-		pImage->msSource = pImageElem->Attribute("Source");
+static tString ReadString(Common::SeekableReadStream *apStream) {
+	uint32 lSize = apStream->readUint32LE();
+	if (lSize > (uint32)(apStream->size() - apStream->pos())) {
+		// Corrupt cache, reading on sets eos()
+		apStream->seek(0, SEEK_END);
+		apStream->readByte();
+		return tString();
 	}
+	return apStream->readString(0, lSize);
 }
 
-//-----------------------------------------------------------------------
-
-static void LoadTextureVec(TiXmlElement *apRootElem, tColladaTextureVec *apColladaTextureVec) {
-	TiXmlElement *pTextureRootElem = apRootElem->FirstChildElement("TextureRoot");
-
-	int lSize = cString::ToInt(pTextureRootElem->Attribute("Size"), 0);
+static cVector3f ReadVector3f(Common::SeekableReadStream *apStream) {
+	cVector3f vVec;
+	vVec.x = apStream->readFloatLE();
+	vVec.y = apStream->readFloatLE();
+	vVec.z = apStream->readFloatLE();
+	return vVec;
+}
 
-	apColladaTextureVec->clear();
-	apColladaTextureVec->resize(lSize);
+static cColor ReadColor(Common::SeekableReadStream *apStream) {
+	cColor color;
+	color.r = apStream->readFloatLE();
+	color.g = apStream->readFloatLE();
+	color.b = apStream->readFloatLE();
+	color.a = apStream->readFloatLE();
+	return color;
+}
 
-	int lCount = 0;
-	TiXmlElement *pTextureElem = pTextureRootElem->FirstChildElement();
-	for (; pTextureElem != NULL; pTextureElem = pTextureElem->NextSiblingElement(), ++lCount) {
-		cColladaTexture *pTexture = &(*apColladaTextureVec)[lCount];
+static cMatrixf ReadMatrix(Common::SeekableReadStream *apStream) {
+	cMatrixf mtxMatrix;
+	for (int i = 0; i < 16; ++i)
+		mtxMatrix.v[i] = apStream->readFloatLE();
+	return mtxMatrix;
+}
 
-		pTexture->msId = pTextureElem->Attribute("Id");
-		pTexture->msName = pTextureElem->Attribute("Name");
-		pTexture->msImage = pTextureElem->Attribute("Image");
+// Reads the size of an array whose elements take at least alElementSize bytes
+static uint32 ReadSize(Common::SeekableReadStream *apStream, uint32 alElementSize) {
+	uint32 lSize = apStream->readUint32LE();
+	if (apStream->eos() || (uint64)lSize * alElementSize > (uint64)(apStream->size() - apStream->pos())) {
+		apStream->seek(0, SEEK_END);
+		apStream->readByte();
+		return 0;
 	}
+	return lSize;
 }
 
-//-----------------------------------------------------------------------
-
-static void LoadMaterialVec(TiXmlElement *apRootElem, tColladaMaterialVec *apColladaMaterialVec) {
-	TiXmlElement *pMaterialRootElem = apRootElem->FirstChildElement("MaterialRoot");
-
-	int lSize = cString::ToInt(pMaterialRootElem->Attribute("Size"), 0);
-
-	apColladaMaterialVec->clear();
-	apColladaMaterialVec->resize(lSize);
-
-	int lCount = 0;
-	TiXmlElement *pMaterialElem = pMaterialRootElem->FirstChildElement();
-	for (; pMaterialElem != NULL; pMaterialElem = pMaterialElem->NextSiblingElement(), ++lCount) {
-		cColladaMaterial *pMaterial = &(*apColladaMaterialVec)[lCount];
-
-		pMaterial->msId = pMaterialElem->Attribute("Id");
-		pMaterial->msName = pMaterialElem->Attribute("Name");
-		pMaterial->msTexture = pMaterialElem->Attribute("Texture");
-		pMaterial->mDiffuseColor = cString::ToColor(pMaterialElem->Attribute("Color"), cColor(0, 0));
-	}
+static void ReadFloatVec(Common::SeekableReadStream *apStream, tFloatVec &avVec) {
+	avVec.resize(ReadSize(apStream, 4));
+	for (size_t i = 0; i < avVec.size(); ++i)
+		avVec[i] = apStream->readFloatLE();
 }
 
 //-----------------------------------------------------------------------
 
-static void LoadControllerVec(TiXmlElement *apRootElem, tColladaControllerVec *apColladaControllerVec) {
-	TiXmlElement *pControllerRootElem = apRootElem->FirstChildElement("ControllerRoot");
-	if (pControllerRootElem == NULL) {
-		Warning("Could not find root element 'ControllerRoot' for controller!\n");
-		return;
+static void LoadImageVec(Common::SeekableReadStream *apStream, tColladaImageVec *apColladaImageVec) {
+	apColladaImageVec->clear();
+	apColladaImageVec->resize(ReadSize(apStream, 12));
+	for (size_t i = 0; i < apColladaImageVec->size(); ++i) {
+		cColladaImage &image = (*apColladaImageVec)[i];
+		image.msId = ReadString(apStream);
+		image.msName = ReadString(apStream);
+		image.msSource = ReadString(apStream);
 	}
+}
 
-	int lSize1 = cString::ToInt(pControllerRootElem->Attribute("Size"), 0);
-
-	apColladaControllerVec->clear();
-	apColladaControllerVec->resize(lSize1);
-
-	int lCount = 0;
-	TiXmlElement *pControllerElem = pControllerRootElem->FirstChildElement();
-	for (; pControllerElem != NULL; pControllerElem = pControllerElem->NextSiblingElement(), ++lCount) {
-		cColladaController *pController = &(*apColladaControllerVec)[lCount];
-
-		pController->msId = pControllerElem->Attribute("Id");
-		pController->msTarget = pControllerElem->Attribute("Target");
-
-		pController->m_mtxBindShapeMatrix = cString::ToMatrixf(pControllerElem->Attribute("BindShapeMatrix"), cMatrixf::Identity);
-
-		pController->mlJointPairIdx = cString::ToInt(pControllerElem->Attribute("JointPairIdx"), 0);
-		pController->mlWeightPairIdx = cString::ToInt(pControllerElem->Attribute("WeightPairIdx"), 0);
-
-		////////////////////////////
-		// Joints
-		{
-			TiXmlElement *pJointsElem = pControllerElem->FirstChildElement("Joints");
-			int lSize = cString::ToInt(pJointsElem->Attribute("Size"), 0);
-			TiXmlText *pJointsText = pJointsElem->FirstChild()->ToText();
-
-			tString sData = pJointsText->Value();
-			tString sSepp = " ";
-			pController->mvJoints.reserve(lSize);
-			cString::GetStringVec(sData, pController->mvJoints, &sSepp);
-		}
-		////////////////////////////
-		// Weights
-		{
-			TiXmlElement *pWeightsElem = pControllerElem->FirstChildElement("Weights");
-			int lSize = cString::ToInt(pWeightsElem->Attribute("Size"), 0);
-			TiXmlText *pWeightsText = pWeightsElem->FirstChild()->ToText();
-
-			// tString sData = pWeightsText->Value();
-			// tString sSepp = " "; pController->mvWeights.reserve(lSize);
-			// cString::GetFloatVec(sData,pController->mvWeights,&sSepp);
-
-			pController->mvWeights.resize(lSize);
-			cString::FloatStringToArray(&pController->mvWeights[0], pWeightsText->Value(), lSize);
-		}
-		////////////////////////////
-		// Matrices
-		{
-			TiXmlElement *pMatricesElem = pControllerElem->FirstChildElement("Matrices");
-			int lSize = cString::ToInt(pMatricesElem->Attribute("Size"), 0);
-			TiXmlText *pMatricesText = pMatricesElem->FirstChild()->ToText();
-
-			// tString sData = pMatricesText->Value();
-			// tString sSepp = " ";
-			// cString::GetFloatVec(sData,vRawData,&sSepp);
-			tFloatVec vRawData;
-			vRawData.resize(lSize * 16);
-			cString::FloatStringToArray(&vRawData[0], pMatricesText->Value(), lSize * 16);
-
-			float *pData = &vRawData[0];
-			pController->mvMatrices.reserve(lSize);
-			for (int i = 0; i < lSize; ++i) {
-				pController->mvMatrices.push_back(
-					cMatrixf(pData[0], pData[1], pData[2], pData[3],
-							 pData[4], pData[5], pData[6], pData[7],
-							 pData[8], pData[9], pData[10], pData[11],
-							 pData[12], pData[13], pData[14], pData[15]));
-				pData += 16;
-			}
-		}
-		////////////////////////////
-		// Pairs
-		{
-			TiXmlElement *pPairVecElem = pControllerElem->FirstChildElement("PairVec");
-			int lSize = cString::ToInt(pPairVecElem->Attribute("Size"), 0);
-
-			/////////////////////////////////////////
-			// Get number of connections per pair
-			TiXmlElement *pPairNumElem = pPairVecElem->FirstChildElement("PairNum");
-			TiXmlText *pPairNumText = pPairNumElem->FirstChild()->ToText();
-
-			tUIntVec vPairNum;
-			vPairNum.resize(lSize);
-			// tString sData = pPairNumText->Value();
-			// tString sSepp = " ";
-			// cString::GetIntVec(sData,vPairNum,&sSepp);
-			cString::UIntStringToArray(&vPairNum[0], pPairNumText->Value(), lSize);
-
-			/////////////////////////////////////////
-			// Get pairs
-			TiXmlElement *pPairsElem = pPairVecElem->FirstChildElement("Pairs");
-			int lPairSize = cString::ToInt(pPairsElem->Attribute("Size"), 0);
-			TiXmlText *pPairsText = pPairsElem->FirstChild()->ToText();
-
-			tUIntVec vPairs;
-			vPairs.resize(lPairSize * 2);
-			// sData = pPairsText->Value();
-			// cString::GetIntVec(sData,vPairs,&sSepp);
-			cString::UIntStringToArray(&vPairs[0], pPairsText->Value(), lPairSize * 2);
-
-			pController->mvPairs.resize(lSize);
-
-			int lPairCount = 0;
-			for (int i = 0; i < lSize; ++i) {
-				for (unsigned int j = 0; j < vPairNum[i]; ++j) {
-					pController->mvPairs[i].push_back(
-						cColladaJointPair(vPairs[lPairCount], vPairs[lPairCount + 1]));
-					lPairCount += 2;
-				}
-			}
-		}
+static void LoadTextureVec(Common::SeekableReadStream *apStream, tColladaTextureVec *apColladaTextureVec) {
+	apColladaTextureVec->clear();
+	apColladaTextureVec->resize(ReadSize(apStream, 12));
+	for (size_t i = 0; i < apColladaTextureVec->size(); ++i) {
+		cColladaTexture &texture = (*apColladaTextureVec)[i];
+		texture.msId = ReadString(apStream);
+		texture.msName = ReadString(apStream);
+		texture.msImage = ReadString(apStream);
 	}
 }
-//-----------------------------------------------------------------------
-
-static void LoadLightVec(TiXmlElement *apRootElem, tColladaLightVec *apColladaLightVec) {
-	TiXmlElement *pLightRootElem = apRootElem->FirstChildElement("LightRoot");
 
-	int lSize = cString::ToInt(pLightRootElem->Attribute("Size"), 0);
-
-	apColladaLightVec->clear();
-	apColladaLightVec->resize(lSize);
-
-	int lCount = 0;
-	TiXmlElement *pLightElem = pLightRootElem->FirstChildElement();
-	for (; pLightElem != NULL; pLightElem = pLightElem->NextSiblingElement(), ++lCount) {
-		cColladaLight *pLight = &(*apColladaLightVec)[lCount];
-
-		pLight->msId = pLightElem->Attribute("Id");
-		pLight->msName = pLightElem->Attribute("Name");
-		pLight->msType = pLightElem->Attribute("Type");
-		pLight->mfAngle = cString::ToFloat(pLightElem->Attribute("Angle"), 0);
-		pLight->mDiffuseColor = cString::ToColor(pLightElem->Attribute("Color"), cColor(0, 0));
+static void LoadMaterialVec(Common::SeekableReadStream *apStream, tColladaMaterialVec *apColladaMaterialVec) {
+	apColladaMaterialVec->clear();
+	apColladaMaterialVec->resize(ReadSize(apStream, 28));
+	for (size_t i = 0; i < apColladaMaterialVec->size(); ++i) {
+		cColladaMaterial &material = (*apColladaMaterialVec)[i];
+		material.msId = ReadString(apStream);
+		material.msName = ReadString(apStream);
+		material.msTexture = ReadString(apStream);
+		material.mDiffuseColor = ReadColor(apStream);
 	}
 }
 
-//-----------------------------------------------------------------------
-
-static void LoadAnimationVec(TiXmlElement *apRootElem, tColladaAnimationVec *apColladaAnimationVec) {
-	TiXmlElement *pAnimationRootElem = apRootElem->FirstChildElement("AnimationRoot");
-	if (pAnimationRootElem == NULL) {
-		Warning("Could not find root element 'AnimationRoot' for animation!\n");
-		return;
+static void LoadLightVec(Common::SeekableReadStream *apStream, tColladaLightVec *apColladaLightVec) {
+	apColladaLightVec->clear();
+	apColladaLightVec->resize(ReadSize(apStream, 32));
+	for (size_t i = 0; i < apColladaLightVec->size(); ++i) {
+		cColladaLight &light = (*apColladaLightVec)[i];
+		light.msId = ReadString(apStream);
+		light.msName = ReadString(apStream);
+		light.msType = ReadString(apStream);
+		light.mDiffuseColor = ReadColor(apStream);
+		light.mfAngle = apStream->readFloatLE();
 	}
+}
 
-	int lSize1 = cString::ToInt(pAnimationRootElem->Attribute("Size"), 0);
-
+static void LoadAnimationVec(Common::SeekableReadStream *apStream, tColladaAnimationVec *apColladaAnimationVec) {
 	apColladaAnimationVec->clear();
-	apColladaAnimationVec->resize(lSize1);
-
-	int lCount = 0;
-	TiXmlElement *pAnimationElem = pAnimationRootElem->FirstChildElement();
-	for (; pAnimationElem != NULL; pAnimationElem = pAnimationElem->NextSiblingElement(), ++lCount) {
-		cColladaAnimation *pAnimation = &(*apColladaAnimationVec)[lCount];
-
-		pAnimation->msId = pAnimationElem->Attribute("Id");
-		pAnimation->msTargetNode = pAnimationElem->Attribute("TargetNode");
-
-		/////////////////////////////////////
-		// Channels
-		{
-			TiXmlElement *pChannelVecElem = pAnimationElem->FirstChildElement("ChannelVec");
-			int lSize = cString::ToInt(pChannelVecElem->Attribute("Size"), 0);
-			pAnimation->mvChannels.resize(lSize);
-
-			int idx = 0;
-			TiXmlElement *pChannelElem = pChannelVecElem->FirstChildElement("Channel");
-			for (; pChannelElem != NULL; pChannelElem = pChannelElem->NextSiblingElement("Channel"), ++idx) {
-				cColladaChannel *pChannel = &pAnimation->mvChannels[idx];
-
-				pChannel->msId = pChannelElem->Attribute("Id");
-				pChannel->msTarget = pChannelElem->Attribute("Target");
-				pChannel->msSource = pChannelElem->Attribute("Source");
-			}
+	apColladaAnimationVec->resize(ReadSize(apStream, 20));
+	for (size_t i = 0; i < apColladaAnimationVec->size(); ++i) {
+		cColladaAnimation &anim = (*apColladaAnimationVec)[i];
+		anim.msId = ReadString(apStream);
+		anim.msTargetNode = ReadString(apStream);
+
+		anim.mvChannels.resize(ReadSize(apStream, 12));
+		for (size_t j = 0; j < anim.mvChannels.size(); ++j) {
+			anim.mvChannels[j].msId = ReadString(apStream);
+			anim.mvChannels[j].msTarget = ReadString(apStream);
+			anim.mvChannels[j].msSource = ReadString(apStream);
 		}
 
-		/////////////////////////////////////
-		// Samplers
-		{
-			TiXmlElement *pSamplerVecElem = pAnimationElem->FirstChildElement("SamplerVec");
-			int lSize = cString::ToInt(pSamplerVecElem->Attribute("Size"), 0);
-			pAnimation->mvSamplers.resize(lSize);
-
-			int idx = 0;
-			TiXmlElement *pSamplerElem = pSamplerVecElem->FirstChildElement("Sampler");
-			for (; pSamplerElem != NULL; pSamplerElem = pSamplerElem->NextSiblingElement("Sampler"), ++idx) {
-				cColladaSampler *pSampler = &pAnimation->mvSamplers[idx];
-
-				pSampler->msId = pSamplerElem->Attribute("Id");
-				pSampler->msTarget = pSamplerElem->Attribute("Target");
-				pSampler->msTimeArray = pSamplerElem->Attribute("TimeArray");
-				pSampler->msValueArray = pSamplerElem->Attribute("ValueArray");
-			}
+		anim.mvSamplers.resize(ReadSize(apStream, 16));
+		for (size_t j = 0; j < anim.mvSamplers.size(); ++j) {
+			anim.mvSamplers[j].msId = ReadString(apStream);
+			anim.mvSamplers[j].msTimeArray = ReadString(apStream);
+			anim.mvSamplers[j].msValueArray = ReadString(apStream);
+			anim.mvSamplers[j].msTarget = ReadString(apStream);
 		}
 
-		/////////////////////////////////////
-		// Sources
-		{
-			TiXmlElement *pSourceVecElem = pAnimationElem->FirstChildElement("SourceVec");
-			int lSize = cString::ToInt(pSourceVecElem->Attribute("Size"), 0);
-			pAnimation->mvSources.resize(lSize);
-
-			int idx = 0;
-			TiXmlElement *pSourceElem = pSourceVecElem->FirstChildElement("Source");
-			for (; pSourceElem != NULL; pSourceElem = pSourceElem->NextSiblingElement("Source"), ++idx) {
-				cColladaAnimSource *pSource = &pAnimation->mvSources[idx];
-
-				pSource->msId = pSourceElem->Attribute("Id");
-				tString sData = pSourceElem->Attribute("Values");
-				tString sSepp = " ";
-				pSource->mvValues.reserve(3);
-
-				cString::GetFloatVec(sData, pSource->mvValues, &sSepp);
-			}
+		anim.mvSources.resize(ReadSize(apStream, 8));
+		for (size_t j = 0; j < anim.mvSources.size(); ++j) {
+			anim.mvSources[j].msId = ReadString(apStream);
+			ReadFloatVec(apStream, anim.mvSources[j].mvValues);
 		}
 	}
 }
 
-//-----------------------------------------------------------------------
-
-static void LoadGeometryVec(TiXmlElement *apRootElem, tColladaGeometryVec *apColladaGeometryVec) {
-	TiXmlElement *pGeometryRootElem = apRootElem->FirstChildElement("GeometryRoot");
-
-	int lSize1 = cString::ToInt(pGeometryRootElem->Attribute("Size"), 0);
-
-	apColladaGeometryVec->clear();
-	apColladaGeometryVec->resize(lSize1);
-
-	int lCount = 0;
-	TiXmlElement *pGeometryElem = pGeometryRootElem->FirstChildElement();
-	for (; pGeometryElem != NULL; pGeometryElem = pGeometryElem->NextSiblingElement(), ++lCount) {
-		cColladaGeometry *pGeometry = &(*apColladaGeometryVec)[lCount];
-
-		pGeometry->msId = pGeometryElem->Attribute("Id");
-		pGeometry->msName = pGeometryElem->Attribute("Name");
-		pGeometry->msMaterial = pGeometryElem->Attribute("Material");
-
-		/////////////////////////////////
-		// Index Vec
-		{
-			TiXmlElement *pIndexVecElem = pGeometryElem->FirstChildElement("IndexVec");
-			int lSize = cString::ToInt(pIndexVecElem->Attribute("Size"), 0);
-
-			if (lSize > 0) {
-				TiXmlElement *pIndicesDataElem = pIndexVecElem->FirstChildElement("Indices");
-				TiXmlText *pVecText = pIndicesDataElem->FirstChild()->ToText();
-
-				pGeometry->mvIndexVec.resize(lSize);
-
-				cString::UIntStringToArray(&pGeometry->mvIndexVec[0], pVecText->Value(), lSize);
-
-				// tString sData = pVecText->Value();
-				// tString sSepp = " ";
-				// cString::GetUIntVec(sData,pGeometry->mvIndexVec,&sSepp);
+static void LoadControllerVec(Common::SeekableReadStream *apStream, tColladaControllerVec *apColladaControllerVec) {
+	apColladaControllerVec->clear();
+	apColladaControllerVec->resize(ReadSize(apStream, 96));
+	for (size_t i = 0; i < apColladaControllerVec->size(); ++i) {
+		cColladaController &controller = (*apColladaControllerVec)[i];
+		controller.msTarget = ReadString(apStream);
+		controller.msId = ReadString(apStream);
+		controller.m_mtxBindShapeMatrix = ReadMatrix(apStream);
+		controller.mlJointPairIdx = apStream->readSint32LE();
+		controller.mlWeightPairIdx = apStream->readSint32LE();
+
+		controller.mvJoints.resize(ReadSize(apStream, 4));
+		for (size_t j = 0; j < controller.mvJoints.size(); ++j)
+			controller.mvJoints[j] = ReadString(apStream);
+
+		ReadFloatVec(apStream, controller.mvWeights);
+
+		uint32 lMatrices = ReadSize(apStream, 64);
+		controller.mvMatrices.reserve(lMatrices);
+		for (uint32 j = 0; j < lMatrices; ++j)
+			controller.mvMatrices.push_back(ReadMatrix(apStream));
+
+		controller.mvPairs.resize(ReadSize(apStream, 4));
+		for (size_t j = 0; j < controller.mvPairs.size(); ++j) {
+			uint32 lPairs = ReadSize(apStream, 8);
+			for (uint32 k = 0; k < lPairs; ++k) {
+				int lJoint = apStream->readSint32LE();
+				int lWeight = apStream->readSint32LE();
+				controller.mvPairs[j].push_back(cColladaJointPair(lJoint, lWeight));
 			}
 		}
+	}
+}
 
-		/////////////////////////////////
-		// Vertex vec
-		{
-			TiXmlElement *pVertexVecElem = pGeometryElem->FirstChildElement("VertexVec");
-			int lSize = cString::ToInt(pVertexVecElem->Attribute("Size"), 0);
-
-			if (lSize > 0) {
-				pGeometry->mvVertexVec.resize(lSize);
-
-				tFloatVec vRawData;
-				vRawData.resize(lSize * 3);
-
-				/////////////////////////////////
-				// Positions
-				{
-					TiXmlElement *pDataElem = pVertexVecElem->FirstChildElement("Positions");
-					TiXmlText *pVecText = pDataElem->FirstChild()->ToText();
-
-					// tString sData = pVecText->Value();
-					// tString sSepp = " ";
-					// tFloatVec vRawData; vRawData.reserve(lSize * 3);
-					// cString::GetFloatVec(sData,vRawData,&sSepp);
-
-					cString::FloatStringToArray(&vRawData[0], pVecText->Value(), lSize * 3);
-
-					float *pData = &vRawData[0];
-					for (int i = 0; i < lSize; ++i) {
-						cVector3f &vPos = pGeometry->mvVertexVec[i].pos;
-						vPos.x = pData[0];
-						vPos.y = pData[1];
-						vPos.z = pData[2];
-						pData += 3;
-					}
-				}
-
-				/////////////////////////////////
-				// Normals
-				{
-					TiXmlElement *pDataElem = pVertexVecElem->FirstChildElement("Normals");
-					TiXmlText *pVecText = pDataElem->FirstChild()->ToText();
-
-					// tString sData = pVecText->Value();
-					// tString sSepp = " ";
-					// tFloatVec vRawData; vRawData.reserve(lSize * 3);
-					// cString::GetFloatVec(sData,vRawData,&sSepp);
-
-					cString::FloatStringToArray(&vRawData[0], pVecText->Value(), lSize * 3);
-
-					float *pData = &vRawData[0];
-					for (int i = 0; i < lSize; ++i) {
-						cVector3f &vPos = pGeometry->mvVertexVec[i].norm;
-						vPos.x = pData[0];
-						vPos.y = pData[1];
-						vPos.z = pData[2];
-						pData += 3;
-					}
-				}
-
-				/////////////////////////////////
-				// UVs
-				{
-					TiXmlElement *pDataElem = pVertexVecElem->FirstChildElement("UV");
-					TiXmlText *pVecText = pDataElem->FirstChild()->ToText();
-
-					// tString sData = pVecText->Value();
-					// tString sSepp = " ";
-					// tFloatVec vRawData; vRawData.reserve(lSize * 3);
-					// cString::GetFloatVec(sData,vRawData,&sSepp);
-
-					cString::FloatStringToArray(&vRawData[0], pVecText->Value(), lSize * 3);
-
-					float *pData = &vRawData[0];
-					for (int i = 0; i < lSize; ++i) {
-						cVector3f &vPos = pGeometry->mvVertexVec[i].tex;
-						vPos.x = pData[0];
-						vPos.y = pData[1];
-						vPos.z = pData[2];
-						pData += 3;
-					}
-				}
-
-				/////////////////////////////////
-				// Tangents
-				{
-					TiXmlElement *pDataElem = pVertexVecElem->FirstChildElement("Tangents");
-					TiXmlText *pVecText = pDataElem->FirstChild()->ToText();
-
-					// tString sData = pVecText->Value();
-					// tString sSepp = " ";
-					// tFloatVec vRawData; vRawData.reserve(lSize * 3);
-					// cString::GetFloatVec(sData,vRawData,&sSepp);
-
-					pGeometry->mvTangents.resize(lSize * 4);
-					cString::FloatStringToArray(&pGeometry->mvTangents[0], pVecText->Value(), lSize * 4);
-				}
-			}
+static void LoadGeometryVec(Common::SeekableReadStream *apStream, tColladaGeometryVec *apColladaGeometryVec) {
+	apColladaGeometryVec->clear();
+	apColladaGeometryVec->resize(ReadSize(apStream, 28));
+	for (size_t i = 0; i < apColladaGeometryVec->size(); ++i) {
+		cColladaGeometry &geom = (*apColladaGeometryVec)[i];
+		geom.msId = ReadString(apStream);
+		geom.msName = ReadString(apStream);
+		geom.msMaterial = ReadString(apStream);
+
+		geom.mvVertexVec.resize(ReadSize(apStream, 64));
+		for (size_t j = 0; j < geom.mvVertexVec.size(); ++j) {
+			cVertex &vtx = geom.mvVertexVec[j];
+			vtx.pos = ReadVector3f(apStream);
+			vtx.tex = ReadVector3f(apStream);
+			vtx.tan = ReadVector3f(apStream);
+			vtx.norm = ReadVector3f(apStream);
+			vtx.col = ReadColor(apStream);
 		}
 
-		/////////////////////////////////
-		// Extra vertex vec
-		{
-			TiXmlElement *pVertexVecElem = pGeometryElem->FirstChildElement("ExtraVertexVec");
-			int lSize = cString::ToInt(pVertexVecElem->Attribute("Size"), 0);
-
-			if (lSize > 0) {
-				pGeometry->mvExtraVtxVec.resize(lSize);
-				tUIntVec mvExtraNum;
-				mvExtraNum.resize(lSize);
-				tUIntVec mvExtraVtx;
-
-				//////////////////////////////////////////////
-				// Extra num
-				{
-					TiXmlElement *pExtraNumElem = pVertexVecElem->FirstChildElement("ExtraNum");
-					TiXmlText *pExtraNumText = pExtraNumElem->FirstChild()->ToText();
-
-					cString::UIntStringToArray(&mvExtraNum[0], pExtraNumText->Value(), lSize);
-				}
-
-				//////////////////////////////////////////////
-				// Extra vertex
-				{
-					TiXmlElement *pExtraVertexElem = pVertexVecElem->FirstChildElement("ExtraVertex");
-					TiXmlText *pExtraVertexText = pExtraVertexElem->FirstChild()->ToText();
-					int lExtraVtxSize = cString::ToInt(pExtraVertexElem->Attribute("Size"), 0);
-					mvExtraVtx.resize(lExtraVtxSize * 4);
-
-					cString::UIntStringToArray(&mvExtraVtx[0], pExtraVertexText->Value(), lExtraVtxSize * 4);
-				}
-
-				unsigned int *pData = &mvExtraVtx[0];
-				for (int idx = 0; idx < lSize; ++idx) {
-					tColladaExtraVtxList *pList = &pGeometry->mvExtraVtxVec[idx];
-
-					for (unsigned int j = 0; j < mvExtraNum[idx]; ++j) {
-						pList->push_back(cColladaExtraVtx(pData[0], pData[1], pData[2], pData[3]));
-						pData += 4;
-					}
-				}
+		geom.mvIndexVec.resize(ReadSize(apStream, 4));
+		for (size_t j = 0; j < geom.mvIndexVec.size(); ++j)
+			geom.mvIndexVec[j] = apStream->readUint32LE();
+
+		ReadFloatVec(apStream, geom.mvTangents);
+
+		geom.mvExtraVtxVec.resize(ReadSize(apStream, 4));
+		for (size_t j = 0; j < geom.mvExtraVtxVec.size(); ++j) {
+			uint32 lExtra = ReadSize(apStream, 16);
+			for (uint32 k = 0; k < lExtra; ++k) {
+				int lVtx = apStream->readSint32LE();
+				int lNorm = apStream->readSint32LE();
+				int lTex = apStream->readSint32LE();
+				int lNewVtx = apStream->readSint32LE();
+				geom.mvExtraVtxVec[j].push_back(cColladaExtraVtx(lVtx, lNorm, lTex, lNewVtx));
 			}
 		}
 	}
 }
 
-//-----------------------------------------------------------------------
-
-static void LoadIterativeNode(TiXmlElement *apNodeElem, cColladaNode *apParentNode, cColladaScene *apColladaScene) {
-	cColladaNode *pNode = apParentNode->CreateChild();
-	apColladaScene->mlstNodes.push_back(pNode);
-
-	pNode->msId = apNodeElem->Attribute("Id");
-	pNode->msName = apNodeElem->Attribute("Name");
-	pNode->msType = apNodeElem->Attribute("Type");
-
-	pNode->msSource = apNodeElem->Attribute("Source");
-	pNode->mbSourceIsFile = cString::ToBool(apNodeElem->Attribute("SourceIsFile"), false);
-
-	pNode->m_mtxTransform = cString::ToMatrixf(apNodeElem->Attribute("Transform"), cMatrixf::Identity);
-	pNode->m_mtxWorldTransform = cString::ToMatrixf(apNodeElem->Attribute("WorldTransform"), cMatrixf::Identity);
-
-	pNode->mvScale = cString::ToVector3f(apNodeElem->Attribute("Scale"), 1);
-	pNode->mlCount = cString::ToInt(apNodeElem->Attribute("Count"), 1);
-
-	TiXmlElement *pTransformRootElem = apNodeElem->FirstChildElement("TransformRoot");
-	TiXmlElement *pTransformElem = pTransformRootElem->FirstChildElement("Transform");
-	for (; pTransformElem != NULL; pTransformElem = pTransformElem->NextSiblingElement("Transform")) {
-		pNode->mlstTransforms.push_back(cColladaTransform());
-		cColladaTransform &transform = pNode->mlstTransforms.back();
-
-		transform.msSid = pTransformElem->Attribute("Sid");
-		transform.msType = pTransformElem->Attribute("Type");
+static void LoadIterativeNode(Common::SeekableReadStream *apStream, cColladaNode *apParentNode, cColladaScene *apColladaScene) {
+	uint32 lChildren = ReadSize(apStream, 165);
+	for (uint32 i = 0; i < lChildren; ++i) {
+		cColladaNode *pNode = apParentNode->CreateChild();
+		apColladaScene->mlstNodes.push_back(pNode);
+
+		pNode->msId = ReadString(apStream);
+		pNode->msName = ReadString(apStream);
+		pNode->msType = ReadString(apStream);
+		pNode->msSource = ReadString(apStream);
+		pNode->mbSourceIsFile = apStream->readByte() != 0;
+		pNode->m_mtxTransform = ReadMatrix(apStream);
+		pNode->m_mtxWorldTransform = ReadMatrix(apStream);
+		pNode->mvScale = ReadVector3f(apStream);
+		pNode->mlCount = apStream->readSint32LE();
+
+		uint32 lTransforms = ReadSize(apStream, 12);
+		for (uint32 j = 0; j < lTransforms; ++j) {
+			pNode->mlstTransforms.push_back(cColladaTransform());
+			cColladaTransform &transform = pNode->mlstTransforms.back();
+			transform.msSid = ReadString(apStream);
+			transform.msType = ReadString(apStream);
+			ReadFloatVec(apStream, transform.mvValues);
+		}
 
-		tString sData = pTransformElem->Attribute("Values");
-		tString sSepp = " ";
-		cString::GetFloatVec(sData, transform.mvValues, &sSepp);
+		LoadIterativeNode(apStream, pNode, apColladaScene);
 	}
+}
 
-	TiXmlElement *pChildElem = apNodeElem->FirstChildElement("Node");
-	for (; pChildElem != NULL; pChildElem = pChildElem->NextSiblingElement("Node")) {
-		LoadIterativeNode(pChildElem, pNode, apColladaScene);
-	}
+static void LoadScene(Common::SeekableReadStream *apStream, cColladaScene *apColladaScene) {
+	// Delete all nodes.
+	apColladaScene->ResetNodes();
+
+	apColladaScene->mfStartTime = apStream->readFloatLE();
+	apColladaScene->mfEndTime = apStream->readFloatLE();
+	apColladaScene->mfDeltaTime = apStream->readFloatLE();
+	LoadIterativeNode(apStream, &apColladaScene->mRoot, apColladaScene);
 }
 
 //-----------------------------------------------------------------------
 
-static void LoadScene(TiXmlElement *apRootElem, cColladaScene *apColladaScene) {
-	TiXmlElement *pSceneElem = apRootElem->FirstChildElement("Scene");
+bool cMeshLoaderCollada::LoadStructures(const tString &asFile, uint32 alSourceSize, uint32 alSourceChecksum,
+										tColladaImageVec *apColladaImageVec,
+										tColladaTextureVec *apColladaTextureVec,
+										tColladaMaterialVec *apColladaMaterialVec,
+										tColladaLightVec *apColladaLightVec,
+										tColladaGeometryVec *apColladaGeometryVec,
+										tColladaControllerVec *apColladaControllerVec,
+										tColladaAnimationVec *apColladaAnimVec,
+										cColladaScene *apColladaScene) {
+	Common::ScopedPtr<Common::InSaveFile> pCacheFile(g_engine->getSaveFileManager()->openForLoading(asFile));
+	if (!pCacheFile)
+		return false;
+
+	// Read the whole cache at once, the structures are then filled from memory
+	Common::ScopedPtr<Common::SeekableReadStream> pStream(pCacheFile->readStream(pCacheFile->size()));
+	pCacheFile.reset();
+	if (!pStream || pStream->size() < 21)
+		return false;
 
-	// Delete all nodes.
-	apColladaScene->ResetNodes();
+	uint32 lSections = GetCacheSections(apColladaImageVec, apColladaTextureVec, apColladaMaterialVec,
+										apColladaLightVec, apColladaGeometryVec, apColladaControllerVec,
+										apColladaAnimVec, apColladaScene);
+	if (pStream->readUint32BE() != COLLADA_CACHE_TAG ||
+		pStream->readUint32LE() != kColladaCacheVersion ||
+		pStream->readUint32LE() != alSourceSize ||
+		pStream->readUint32LE() != alSourceChecksum ||
+		pStream->readUint32LE() != lSections) {
+		return false;
+	}
+	mbZToY = pStream->readByte() != 0;
 
-	apColladaScene->mfStartTime = cString::ToFloat(pSceneElem->Attribute("StartTime"), 0);
-	apColladaScene->mfEndTime = cString::ToFloat(pSceneElem->Attribute("EndTime"), 0);
-	apColladaScene->mfDeltaTime = cString::ToFloat(pSceneElem->Attribute("DeltaTime"), 0);
+	if (apColladaImageVec)
+		LoadImageVec(pStream.get(), apColladaImageVec);
+	if (apColladaTextureVec)
+		LoadTextureVec(pStream.get(), apColladaTextureVec);
+	if (apColladaMaterialVec)
+		LoadMaterialVec(pStream.get(), apColladaMaterialVec);
+	if (apColladaLightVec)
+		LoadLightVec(pStream.get(), apColladaLightVec);
+	if (apColladaAnimVec)
+		LoadAnimationVec(pStream.get(), apColladaAnimVec);
+	if (apColladaControllerVec)
+		LoadControllerVec(pStream.get(), apColladaControllerVec);
+	if (apColladaGeometryVec)
+		LoadGeometryVec(pStream.get(), apColladaGeometryVec);
+	if (apColladaScene)
+		LoadScene(pStream.get(), apColladaScene);
 
-	TiXmlElement *pSceneRootElem = pSceneElem->FirstChildElement("Root");
-	TiXmlElement *pNodeElem = pSceneRootElem->FirstChildElement("Node");
-	for (; pNodeElem != NULL; pNodeElem = pNodeElem->NextSiblingElement("Node")) {
-		LoadIterativeNode(pNodeElem, &apColladaScene->mRoot, apColladaScene);
+	if (pStream->err() || pStream->eos() || pStream->pos() != pStream->size()) {
+		Hpl1::logWarning(Hpl1::kDebugResourceLoading, "collada cache file '%s' is corrupt\n", asFile.c_str());
+		return false;
 	}
+	return true;
 }
 
 //-----------------------------------------------------------------------
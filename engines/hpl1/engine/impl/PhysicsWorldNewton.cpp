@@ -50,8 +50,14 @@
 #include "hpl1/engine/math/Math.h"
 #include "hpl1/engine/system/low_level_system.h"
 
+#include "common/system.h"
+
 namespace hpl {
 
+static unsigned GetPhysicsTicks() {
+	return g_system->getMillis();
+}
+
 //////////////////////////////////////////////////////////////////////////
 // CONSTRUCTORS
 //////////////////////////////////////////////////////////////////////////
@@ -74,6 +80,14 @@ cPhysicsWorldNewton::cPhysicsWorldNewton()
 	mvGravity = cVector3f(0, -9.81f, 0);
 	mfMaxTimeStep = 1.0f / 60.0f;
 
+	NewtonSetPerformanceClock(mpNewtonWorld, GetPhysicsTicks);
+	mlTicksTotal = 0;
+	mlTicksCollision = 0;
+	mlTicksDynamics = 0;
+	mlSteps = 0;
+	mlSimulateCount = 0;
+	mlStepTimesStart = GetApplicationTime();
+
 	/////////////////////////////////
 	// Create default material.
 	int lDefaultMatId = 0; // NewtonMaterialGetDefaultGroupID(mpNewtonWorld);
@@ -113,10 +127,10 @@ void cPhysicsWorldNewton::Simulate(float afTimeStep) {
 	// if(lUpdate % 30==0)
 	{
 		while (afTimeStep > mfMaxTimeStep) {
-			NewtonUpdate(mpNewtonWorld, mfMaxTimeStep);
+			UpdateNewton(mfMaxTimeStep);
 			afTimeStep -= mfMaxTimeStep;
 		}
-		NewtonUpdate(mpNewtonWorld, afTimeStep);
+		UpdateNewton(afTimeStep);
 	}
 	// lUpdate++;
 	// cPhysicsBodyNewton::SetUseCallback(true);
@@ -126,6 +140,36 @@ void cPhysicsWorldNewton::Simulate(float afTimeStep) {
 		cPhysicsBodyNewton *pBody = static_cast<cPhysicsBodyNewton *>(*it);
 		pBody->ClearForces();
 	}
+
+	// The clock only counts milliseconds, which is about as long as a step
+	// takes, so average the times over a second
+	mlSimulateCount++;
+	unsigned long lTime = GetApplicationTime();
+	if (lTime - mlStepTimesStart >= 1000) {
+		float fCount = static_cast<float>(mlSimulateCount);
+		mStepTimes.mfTotal = mlTicksTotal / fCount;
+		mStepTimes.mfCollision = mlTicksCollision / fCount;
+		mStepTimes.mfDynamics = mlTicksDynamics / fCount;
+		mStepTimes.mfSteps = mlSteps / fCount;
+
+		mlTicksTotal = 0;
+		mlTicksCollision = 0;
+		mlTicksDynamics = 0;
+		mlSteps = 0;
+		mlSimulateCount = 0;
+		mlStepTimesStart = lTime;
+	}
+}
+
+//-----------------------------------------------------------------------
+
+void cPhysicsWorldNewton::UpdateNewton(float afTimeStep) {
+	NewtonUpdate(mpNewtonWorld, afTimeStep);
+
+	mlTicksTotal += NewtonReadPerformanceTicks(mpNewtonWorld, NEWTON_PROFILER_WORLD_UPDATE);
+	mlTicksCollision += NewtonReadPerformanceTicks(mpNewtonWorld, NEWTON_PROFILER_COLLISION_UPDATE);
+	mlTicksDynamics += NewtonReadPerformanceTicks(mpNewtonWorld, NEWTON_PROFILER_DYNAMICS_UPDATE);
+	mlSteps++;
 }
 
 //-----------------------------------------------------------------------
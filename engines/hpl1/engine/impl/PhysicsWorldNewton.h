@@ -53,6 +53,8 @@ public:
 	void SetAccuracyLevel(ePhysicsAccuracy aAccuracy);
 	ePhysicsAccuracy GetAccuracyLevel();
 
+	const cPhysicsStepTimes &GetStepTimes() { return mStepTimes; }
+
 	iCollideShape *CreateNullShape();
 	iCollideShape *CreateBoxShape(const cVector3f &avSize, cMatrixf *apOffsetMtx);
 	iCollideShape *CreateSphereShape(const cVector3f &avRadii, cMatrixf *apOffsetMtx);
@@ -95,6 +97,8 @@ public:
 	NewtonWorld *GetNewtonWorld() { return mpNewtonWorld; }
 
 private:
+	void UpdateNewton(float afTimeStep);
+
 	NewtonWorld *mpNewtonWorld;
 
 	float *mpTempPoints;
@@ -107,6 +111,15 @@ private:
 	float mfMaxTimeStep;
 
 	ePhysicsAccuracy mAccuracy;
+
+	// Performance ticks summed up until they are averaged into mStepTimes
+	unsigned int mlTicksTotal;
+	unsigned int mlTicksCollision;
+	unsigned int mlTicksDynamics;
+	int mlSteps;
+	int mlSimulateCount;
+	unsigned long mlStepTimesStart;
+	cPhysicsStepTimes mStepTimes;
 };
 
 } // namespace hpl
@@ -89,6 +89,17 @@ enum ePhysicsAccuracy {
 
 //----------------------------------------------------
 
+// Milliseconds spent per call to Simulate() and Newton updates per call,
+// averaged over the last second
+struct cPhysicsStepTimes {
+	float mfTotal = 0;
+	float mfCollision = 0;
+	float mfDynamics = 0;
+	float mfSteps = 0;
+};
+
+//----------------------------------------------------
+
 struct cPhysicsRayParams {
 	constexpr cPhysicsRayParams() {}
 	float mfT = 0;
@@ -137,6 +148,8 @@ public:
 
 	virtual void SetAccuracyLevel(ePhysicsAccuracy aAccuracy) = 0;
 	virtual ePhysicsAccuracy GetAccuracyLevel() = 0;
+
+	virtual const cPhysicsStepTimes &GetStepTimes() = 0;
 	//! @}
 
 	//########################################################################################
@@ -69,6 +69,7 @@ cPlayer::cPlayer(cInit *apInit) : iUpdateable("Player") {
 	// Get Debug variables
 	mbShowHealth = mpInit->mpConfig->GetBool("Debug", "ShowHealth", false);
 	mbShowSoundsPlaying = mpInit->mpConfig->GetBool("Debug", "ShowSoundsPlaying", false);
+	mbShowPhysicsTime = mpInit->mpConfig->GetBool("Debug", "ShowPhysicsTime", false);
 
 	mvSize.x = mpInit->mpGameConfig->GetFloat("Player", "Width", 1);
 	mvSize.y = mpInit->mpGameConfig->GetFloat("Player", "Height", 1);
@@ -247,6 +248,7 @@ cPlayer::~cPlayer(void) {
 
 	mpInit->mpConfig->SetBool("Debug", "ShowHealth", mbShowHealth);
 	mpInit->mpConfig->SetBool("Debug", "ShowSoundsPlaying", mbShowSoundsPlaying);
+	mpInit->mpConfig->SetBool("Debug", "ShowPhysicsTime", mbShowPhysicsTime);
 
 	STLDeleteAll(mvMoveStates);
 	STLDeleteAll(mvStates);
@@ -1377,6 +1379,19 @@ void cPlayer::OnDraw() {
 		mpFont->draw(cVector3f(5, 5, 0), 12, cColor(1, 1, 1, 1), eFontAlign_Left, Common::U32String::format("Health: %.0f", mfHealth));
 	}
 
+	// DEBUG: physics
+	if (mbShowPhysicsTime) {
+		cWorld3D *pWorld = mpInit->mpGame->GetScene()->GetWorld3D();
+		iPhysicsWorld *pPhysicsWorld = pWorld ? pWorld->GetPhysicsWorld() : NULL;
+		if (pPhysicsWorld) {
+			const cPhysicsStepTimes &stepTimes = pPhysicsWorld->GetStepTimes();
+			mpFont->draw(cVector3f(5, 585, 0), 10, cColor(1, 1, 1, 1), eFontAlign_Left,
+						 Common::U32String::format("Physics: %.2f ms (collision %.2f, dynamics %.2f) steps: %.1f",
+												   stepTimes.mfTotal, stepTimes.mfCollision, stepTimes.mfDynamics,
+												   stepTimes.mfSteps));
+		}
+	}
+
 	// DEBUG: misc
 	// mpFont->Draw(cVector3f(5,20,0),12,cColor(1,1,1,1),eFontAlign_Left,
 	//			_W("Ground: %d Speed: %f ForceSpeed: %f"),
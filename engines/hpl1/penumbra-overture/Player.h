@@ -480,6 +480,7 @@ private:
 	// Debug
 	bool mbShowHealth;
 	bool mbShowSoundsPlaying;
+	bool mbShowPhysicsTime;
 
 	tGameCollideScriptMap m_mapCollideCallbacks;
 };
@@ -0,0 +1,193 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "engines/myst3/facecache.h"
+#include "engines/myst3/database.h"
+#include "engines/myst3/myst3.h"
+#include "engines/myst3/state.h"
+
+#include "common/algorithm.h"
+#include "common/debug.h"
+
+namespace Myst3 {
+
+FaceCache::FaceCache(Myst3Engine *vm, uint capacity) :
+		_vm(vm),
+		_capacity(capacity),
+		_useCounter(0),
+		_hits(0),
+		_misses(0),
+		_prefetched(0) {
+}
+
+FaceCache::~FaceCache() {
+	clear();
+}
+
+void FaceCache::clear() {
+	for (uint i = 0; i < _entries.size(); i++) {
+		_entries[i].surface->free();
+		delete _entries[i].surface;
+	}
+
+	_entries.clear();
+	_queue.clear();
+}
+
+Common::String FaceCache::getCurrentRoomName() const {
+	return _vm->_db->getRoomName(_vm->_state->getLocationRoom(), _vm->_state->getLocationAge());
+}
+
+int FaceCache::findEntry(const Common::String &room, uint16 node, uint16 face) const {
+	for (uint i = 0; i < _entries.size(); i++) {
+		const Entry &entry = _entries[i];
+		if (entry.node == node && entry.face == face && entry.room == room)
+			return i;
+	}
+
+	return -1;
+}
+
+FaceCache::Entry &FaceCache::decodeFace(const Common::String &room, uint16 node, uint16 face) {
+	ResourceDescription jpegDesc = _vm->getFileDescription(room, node, face + 1, Archive::kCubeFace);
+	if (!jpegDesc.isValid())
+		error("Face %d does not exist", node);
+
+	// Evict the least recently used face
+	if (_entries.size() >= _capacity) {
+		uint oldest = 0;
+		for (uint i = 1; i < _entries.size(); i++) {
+			if (_entries[i].lastUse < _entries[oldest].lastUse)
+				oldest = i;
+		}
+
+		_entries[oldest].surface->free();
+		delete _entries[oldest].surface;
+		_entries.remove_at(oldest);
+	}
+
+	Entry entry;
+	entry.room = room;
+	entry.node = node;
+	entry.face = face;
+	entry.lastUse = ++_useCounter;
+	entry.surface = Myst3Engine::decodeJpeg(&jpegDesc);
+	_entries.push_back(entry);
+
+	return _entries.back();
+}
+
+Graphics::Surface *FaceCache::getFace(uint16 nodeID, uint16 face) {
+	Common::String room = getCurrentRoomName();
+
+	int index = findEntry(room, nodeID, face);
+	if (index >= 0) {
+		_hits++;
+		_entries[index].lastUse = ++_useCounter;
+	} else {
+		_misses++;
+		decodeFace(room, nodeID, face);
+		index = _entries.size() - 1;
+	}
+
+	// The spot items are drawn on the face bitmap, so the cached face is left untouched
+	Graphics::Surface *surface = new Graphics::Surface();
+	surface->copyFrom(*_entries[index].surface);
+	return surface;
+}
+
+void FaceCache::prefetchNeighbours(uint16 nodeID) {
+	_queue.clear();
+
+	NodePtr nodeData = _vm->_db->getNodeData(nodeID, _vm->_state->getLocationRoom(), _vm->_state->getLocationAge());
+	if (!nodeData)
+		return;
+
+	Common::String room = getCurrentRoomName();
+
+	// Keep room for the faces of the current node
+	uint maxNodes = _capacity / 6 - 1;
+	Common::Array<uint16> nodes;
+
+	for (uint i = 0; i < nodeData->hotspots.size() && nodes.size() < maxNodes; i++) {
+		HotSpot &hotspot = nodeData->hotspots[i];
+		if (hotspot.condition == -1 || !hotspot.isEnabled(_vm->_state))
+			continue;
+
+		for (uint j = 0; j < hotspot.script.size(); j++) {
+			const Opcode &opcode = hotspot.script[j];
+
+			// Only the opcodes moving to another node of the same room are looked at
+			bool goToNode = opcode.op == 136 || opcode.op == 137 || opcode.op == 138 || opcode.op == 140;
+			if (!goToNode || opcode.args.empty())
+				continue;
+
+			int32 target = _vm->_state->valueOrVarValue(opcode.args[0]);
+			if (target <= 0 || target == nodeID || Common::find(nodes.begin(), nodes.end(), target) != nodes.end())
+				continue;
+
+			// Frame nodes do not have cube faces
+			if (!_vm->getFileDescription(room, target, 1, Archive::kCubeFace).isValid())
+				continue;
+
+			nodes.push_back(target);
+			break;
+		}
+	}
+
+	for (uint i = 0; i < nodes.size(); i++) {
+		for (uint16 face = 0; face < 6; face++) {
+			if (findEntry(room, nodes[i], face) >= 0)
+				continue;
+
+			Request request;
+			request.room = room;
+			request.node = nodes[i];
+			request.face = face;
+			_queue.push_back(request);
+		}
+	}
+
+	debugC(kDebugNode, "Prefetching %d faces for %d nodes reachable from node %d", _queue.size(), nodes.size(), nodeID);
+}
+
+bool FaceCache::prefetchStep() {
+	while (!_queue.empty()) {
+		Request request = _queue.front();
+		_queue.remove_at(0);
+
+		// The node archive only holds the current room
+		if (request.room != getCurrentRoomName())
+			continue;
+
+		int index = findEntry(request.room, request.node, request.face);
+		if (index >= 0)
+			continue;
+
+		decodeFace(request.room, request.node, request.face);
+		_prefetched++;
+		return true;
+	}
+
+	return false;
+}
+
+} // End of namespace Myst3
@@ -0,0 +1,99 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef FACECACHE_H_
+#define FACECACHE_H_
+
+#include "common/array.h"
+#include "common/str.h"
+
+#include "graphics/surface.h"
+
+namespace Myst3 {
+
+class Myst3Engine;
+
+/**
+ * Keeps the most recently used decoded cube faces, so that going back and
+ * forth between nodes does not decode the same JPEGs again.
+ *
+ * The faces of the nodes that can be reached from the current node are
+ * decoded ahead of time, one face per frame, while the player looks around.
+ */
+class FaceCache {
+public:
+	FaceCache(Myst3Engine *vm, uint capacity);
+	~FaceCache();
+
+	/**
+	 * Get a copy of a face of a cube node of the current room
+	 *
+	 * The face is decoded if it is not in the cache. The caller owns the returned surface.
+	 */
+	Graphics::Surface *getFace(uint16 nodeID, uint16 face);
+
+	/** Queue the faces of the nodes the hotspots of a node of the current room lead to */
+	void prefetchNeighbours(uint16 nodeID);
+
+	/** Decode the next queued face, if any. Returns false when the queue is empty. */
+	bool prefetchStep();
+
+	/** Drop all the cached faces and the queued prefetches */
+	void clear();
+
+	uint32 getHits() const { return _hits; }
+	uint32 getMisses() const { return _misses; }
+	uint32 getPrefetched() const { return _prefetched; }
+
+private:
+	struct Entry {
+		Common::String room;
+		uint16 node;
+		uint16 face;
+		uint32 lastUse;
+		Graphics::Surface *surface;
+	};
+
+	struct Request {
+		Common::String room;
+		uint16 node;
+		uint16 face;
+	};
+
+	Myst3Engine *_vm;
+	uint _capacity;
+	uint32 _useCounter;
+
+	Common::Array<Entry> _entries;
+	Common::Array<Request> _queue;
+
+	uint32 _hits;
+	uint32 _misses;
+	uint32 _prefetched;
+
+	Common::String getCurrentRoomName() const;
+	int findEntry(const Common::String &room, uint16 node, uint16 face) const;
+	Entry &decodeFace(const Common::String &room, uint16 node, uint16 face);
+};
+
+} // End of namespace Myst3
+
+#endif // FACECACHE_H_
@@ -37,6 +37,7 @@
 #include "engines/myst3/console.h"
 #include "engines/myst3/database.h"
 #include "engines/myst3/effects.h"
+#include "engines/myst3/facecache.h"
 #include "engines/myst3/myst3.h"
 #include "engines/myst3/nodecube.h"
 #include "engines/myst3/nodeframe.h"
@@ -66,7 +67,7 @@ Myst3Engine::Myst3Engine(OSystem *syst, const Myst3GameDescription *version) :
 		_db(nullptr), _scriptEngine(nullptr),
 		_state(nullptr), _node(nullptr), _scene(nullptr), _archiveNode(nullptr),
 		_cursor(nullptr), _inventory(nullptr), _gfx(nullptr), _menu(nullptr),
-		_rnd(nullptr), _sound(nullptr), _ambient(nullptr),
+		_rnd(nullptr), _sound(nullptr), _ambient(nullptr), _faceCache(nullptr),
 		_inputSpacePressed(false), _inputEnterPressed(false),
 		_inputEscapePressed(false), _inputTildePressed(false),
 		_inputEscapePressedNotConsumed(false),
@@ -112,6 +113,7 @@ Myst3Engine::~Myst3Engine() {
 	delete _inventory;
 	delete _cursor;
 	delete _scene;
+	delete _faceCache;
 	delete _archiveNode;
 	delete _db;
 	delete _scriptEngine;
@@ -177,6 +179,7 @@ Common::Error Myst3Engine::run() {
 		_menu = new PagingMenu(this);
 	}
 	_archiveNode = new Archive();
+	_faceCache = new FaceCache(this, 24);
 
 	_system->showMouse(false);
 
@@ -220,6 +223,9 @@ Common::Error Myst3Engine::run() {
 		}
 
 		drawFrame();
+
+		// Decode the faces of the next nodes while the player is looking around
+		_faceCache->prefetchStep();
 	}
 
 	unloadNode();
@@ -883,6 +889,8 @@ void Myst3Engine::goToNode(uint16 nodeID, TransitionType transitionType) {
 }
 
 void Myst3Engine::loadNode(uint16 nodeID, uint32 roomID, uint32 ageID) {
+	uint32 startTime = _system->getMillis();
+
 	unloadNode();
 
 	_scriptEngine->run(&_db->getNodeInitScript());
@@ -928,6 +936,13 @@ void Myst3Engine::loadNode(uint16 nodeID, uint32 roomID, uint32 ageID) {
 	// Releeshan to the player when he is trapped between both shields.
 	if (nodeID == 9 && roomID == kRoomNarayan)
 		_state->setVar(39, 0);
+
+	debugC(kDebugNode, "Node %d loaded in %d ms (face cache hits: %d, misses: %d, prefetched: %d)",
+	       _state->getLocationNode(), _system->getMillis() - startTime,
+	       _faceCache->getHits(), _faceCache->getMisses(), _faceCache->getPrefetched());
+
+	if (_state->getViewType() == kCube)
+		_faceCache->prefetchNeighbours(_state->getLocationNode());
 }
 
 void Myst3Engine::unloadNode() {
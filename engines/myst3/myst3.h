@@ -79,6 +79,7 @@ class ScriptedMovie;
 class ShakeEffect;
 class RotationEffect;
 class Transition;
+class FaceCache;
 struct NodeData;
 struct Myst3GameDescription;
 
@@ -102,6 +103,7 @@ public:
 	Database *_db;
 	Sound *_sound;
 	Ambient *_ambient;
+	FaceCache *_faceCache;
 
 	Common::RandomSource *_rnd;
 
@@ -33,7 +33,11 @@
 namespace Myst3 {
 
 void Face::setTextureFromJPEG(const ResourceDescription *jpegDesc) {
-	_bitmap = Myst3Engine::decodeJpeg(jpegDesc);
+	setTexture(Myst3Engine::decodeJpeg(jpegDesc));
+}
+
+void Face::setTexture(Graphics::Surface *bitmap) {
+	_bitmap = bitmap;
 	if (_is3D) {
 		_texture = _vm->_gfx->createTexture3D(_bitmap);
 	} else {
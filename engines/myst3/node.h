@@ -47,6 +47,8 @@ public:
 	~Face();
 
 	void setTextureFromJPEG(const ResourceDescription *jpegDesc);
+	/** Use a decoded image as the face bitmap. The face takes ownership of the surface. */
+	void setTexture(Graphics::Surface *bitmap);
 
 	void addTextureDirtyRect(const Common::Rect &rect);
 	bool isTextureDirty() { return _textureDirty; }
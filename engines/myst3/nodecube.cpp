@@ -20,6 +20,7 @@
  */
 
 #include "engines/myst3/archive.h"
+#include "engines/myst3/facecache.h"
 #include "engines/myst3/nodecube.h"
 #include "engines/myst3/myst3.h"
 
@@ -38,7 +39,7 @@ NodeCube::NodeCube(Myst3Engine *vm, uint16 id) :
 			error("Face %d does not exist", id);
 
 		_faces[i] = new Face(_vm, true);
-		_faces[i]->setTextureFromJPEG(&jpegDesc);
+		_faces[i]->setTexture(_vm->_faceCache->getFace(id, i));
 	}
 }
 
@@ -30,20 +30,12 @@ IContainedObject::IContainedObject(IContainedObject &sourceContainedObject) {
 
 int Node::_nodeCount = 0;
 
-Node::Node() {
+Node::Node(NodePool *pool) {
 	_parent = nullptr;
 	_depth = 0;
 	_nodeCount++;
 	_contents = nullptr;
-}
-
-Node::Node(Node *sourceNode) {
-	_parent = nullptr;
-	_children = sourceNode->getChildren();
-
-	_depth = sourceNode->getDepth();
-
-	_contents = sourceNode->getContainedObject()->duplicate();
+	_pool = pool;
 }
 
 Node::~Node() {
@@ -55,6 +47,27 @@ Node::~Node() {
 	_nodeCount--;
 }
 
+Node *Node::create(NodePool *pool) {
+	if (pool)
+		return new (*pool) Node(pool);
+	return new Node;
+}
+
+void Node::destroy(Node *node) {
+	if (node->_pool)
+		node->_pool->deleteChunk(node);
+	else
+		delete node;
+}
+
+Node *Node::createChild() {
+	Node *tempNode = create(_pool);
+	_children.push_back(tempNode);
+	tempNode->setParent(this);
+	tempNode->setDepth(_depth + 1);
+	return tempNode;
+}
+
 int Node::generateChildren() {
 	int numChildren = _contents->numChildrenToGen();
 
@@ -63,10 +76,7 @@ int Node::generateChildren() {
 	static int i = 0;
 
 	while (i < numChildren) {
-		Node *tempNode = new Node;
-		_children.push_back(tempNode);
-		tempNode->setParent(this);
-		tempNode->setDepth(_depth + 1);
+		Node *tempNode = createChild();
 
 		int completionFlag;
 
@@ -75,7 +85,7 @@ int Node::generateChildren() {
 
 		if (!completionFlag) {
 			_children.pop_back();
-			delete tempNode;
+			destroy(tempNode);
 			return 0;
 		}
 
@@ -85,7 +95,7 @@ int Node::generateChildren() {
 			tempNode->setContainedObject(thisContObj);
 		} else {
 			_children.pop_back();
-			delete tempNode;
+			destroy(tempNode);
 			numChildrenGenerated--;
 		}
 	}
@@ -104,10 +114,7 @@ int Node::generateNextChild() {
 
 	static int i = 0;
 
-	Node *tempNode = new Node;
-	_children.push_back(tempNode);
-	tempNode->setParent(this);
-	tempNode->setDepth(_depth + 1);
+	Node *tempNode = createChild();
 
 	int compFlag;
 	IContainedObject *thisContObj = _contents->createChildObj(i, compFlag);
@@ -116,7 +123,7 @@ int Node::generateNextChild() {
 		tempNode->setContainedObject(thisContObj);
 	} else {
 		_children.pop_back();
-		delete tempNode;
+		destroy(tempNode);
 	}
 
 	++i;
@@ -23,6 +23,7 @@
 #define SCUMM_HE_MOONBASE_AI_NODE_H
 
 #include "common/array.h"
+#include "common/memorypool.h"
 
 namespace Scumm {
 
@@ -61,6 +62,15 @@ public:
 	float returnG() const { return getG(); }
 };
 
+class Node;
+
+/**
+ * Arena for the nodes of a single search tree. All nodes of a tree are
+ * allocated from the pool of its base node, and the whole pool is released
+ * together with the tree.
+ */
+typedef Common::ObjectPool<Node, 64> NodePool;
+
 class Node {
 private:
 	Node *_parent;
@@ -71,11 +81,17 @@ private:
 
 	IContainedObject *_contents;
 
+	NodePool *_pool;
+
+	Node *createChild();
+
 public:
-	Node();
-	Node(Node *sourceNode);
+	Node(NodePool *pool = nullptr);
 	~Node();
 
+	static Node *create(NodePool *pool);
+	static void destroy(Node *node);
+
 	void setParent(Node *parentPtr) { _parent = parentPtr; }
 	Node *getParent() const { return _parent; }
 
@@ -87,7 +103,7 @@ public:
 	void setContainedObject(IContainedObject *value) { _contents = value; }
 	IContainedObject *getContainedObject() { return _contents; }
 
-	Common::Array<Node *> getChildren() const { return _children; }
+	const Common::Array<Node *> &getChildren() const { return _children; }
 	int generateChildren();
 	int generateNextChild();
 	Node *popChild();
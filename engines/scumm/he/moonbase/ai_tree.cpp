@@ -37,72 +37,36 @@ static int compareTreeNodes(const void *a, const void *b) {
 }
 
 Tree::Tree(AI *ai) : _ai(ai) {
-	pBaseNode = new Node;
-	_maxDepth = MAX_DEPTH;
-	_maxNodes = MAX_NODES;
-	_currentNode = nullptr;
-	_currentChildIndex = 0;
-
-	_currentMap = new Common::SortedArray<TreeNode *>(compareTreeNodes);
+	init(nullptr, MAX_DEPTH, MAX_NODES);
 }
 
 Tree::Tree(IContainedObject *contents, AI *ai) : _ai(ai) {
-	pBaseNode = new Node;
-	pBaseNode->setContainedObject(contents);
-	_maxDepth = MAX_DEPTH;
-	_maxNodes = MAX_NODES;
-	_currentNode = nullptr;
-	_currentChildIndex = 0;
-
-	_currentMap = new Common::SortedArray<TreeNode *>(compareTreeNodes);
+	init(contents, MAX_DEPTH, MAX_NODES);
 }
 
 Tree::Tree(IContainedObject *contents, int maxDepth, AI *ai) : _ai(ai) {
-	pBaseNode = new Node;
-	pBaseNode->setContainedObject(contents);
-	_maxDepth = maxDepth;
-	_maxNodes = MAX_NODES;
-	_currentNode = nullptr;
-	_currentChildIndex = 0;
-
-	_currentMap = new Common::SortedArray<TreeNode *>(compareTreeNodes);
+	init(contents, maxDepth, MAX_NODES);
 }
 
 Tree::Tree(IContainedObject *contents, int maxDepth, int maxNodes, AI *ai) : _ai(ai) {
-	pBaseNode = new Node;
+	init(contents, maxDepth, maxNodes);
+}
+
+void Tree::init(IContainedObject *contents, int maxDepth, int maxNodes) {
+	pBaseNode = Node::create(&_nodePool);
 	pBaseNode->setContainedObject(contents);
 	_maxDepth = maxDepth;
 	_maxNodes = maxNodes;
 	_currentNode = nullptr;
 	_currentChildIndex = 0;
+	_numExpanded = 0;
 
 	_currentMap = new Common::SortedArray<TreeNode *>(compareTreeNodes);
 }
 
-void Tree::duplicateTree(Node *sourceNode, Node *destNode) {
-	Common::Array<Node *> vUnvisited = sourceNode->getChildren();
-
-	while (vUnvisited.size()) {
-		Node *newNode = new Node(*(vUnvisited.end()));
-		newNode->setParent(destNode);
-		(destNode->getChildren()).push_back(newNode);
-		duplicateTree(*(vUnvisited.end()), newNode);
-		vUnvisited.pop_back();
-	}
-}
-
-Tree::Tree(const Tree *sourceTree, AI *ai) : _ai(ai) {
-	pBaseNode = new Node(sourceTree->getBaseNode());
-	_maxDepth = sourceTree->getMaxDepth();
-	_maxNodes = sourceTree->getMaxNodes();
-	_currentMap = new Common::SortedArray<TreeNode *>(compareTreeNodes);
-	_currentNode = nullptr;
-	_currentChildIndex = 0;
-
-	duplicateTree(sourceTree->getBaseNode(), pBaseNode);
-}
-
 Tree::~Tree() {
+	debugC(DEBUG_MOONBASE_AI, "Search tree expanded %d nodes", _numExpanded);
+
 	// Delete all nodes
 	Node *pNodeItr = pBaseNode;
 
@@ -115,14 +79,26 @@ Tree::~Tree() {
 			// Delete this node, and move up to the parent for further processing
 			Node *pTemp = pNodeItr;
 			pNodeItr = pNodeItr->getParent();
-			delete pTemp;
+			Node::destroy(pTemp);
 			pTemp = nullptr;
 		}
 	}
 
+	// The open list entries themselves are owned by _treeNodePool
 	delete _currentMap;
 }
 
+Node *Tree::popOpenNode(Common::SortedArray<TreeNode *> &openList) {
+	TreeNode *front = openList.front();
+	Node *node = front->node;
+
+	openList.erase(openList.begin());
+	_treeNodePool.deleteChunk(front);
+	_numExpanded++;
+
+	return node;
+}
+
 Node *Tree::aStarSearch() {
 	Common::SortedArray<TreeNode *> mmfpOpen(compareTreeNodes);
 
@@ -134,24 +110,23 @@ Node *Tree::aStarSearch() {
 	float temp = pBaseNode->getContainedObject()->calcT();
 
 	if (static_cast<int>(temp) != SUCCESS) {
-		mmfpOpen.insert(new TreeNode(pBaseNode->getObjectT(), pBaseNode));
+		mmfpOpen.insert(createTreeNode(pBaseNode->getObjectT(), pBaseNode));
 
 		while (mmfpOpen.size() && (retNode == nullptr)) {
-			currentNode = mmfpOpen.front()->node;
-			mmfpOpen.erase(mmfpOpen.begin());
+			currentNode = popOpenNode(mmfpOpen);
 
 			if ((currentNode->getDepth() < _maxDepth) && (Node::getNodeCount() < _maxNodes)) {
 				// Generate nodes
-				Common::Array<Node *> vChildren = currentNode->getChildren();
+				const Common::Array<Node *> &vChildren = currentNode->getChildren();
 
-				for (Common::Array<Node *>::iterator i = vChildren.begin(); i != vChildren.end(); i++) {
+				for (Common::Array<Node *>::const_iterator i = vChildren.begin(); i != vChildren.end(); i++) {
 					IContainedObject *pTemp = (*i)->getContainedObject();
 					currentT = pTemp->calcT();
 
 					if (currentT == SUCCESS)
 						retNode = *i;
 					else
-						mmfpOpen.insert(new TreeNode(currentT, (*i)));
+						mmfpOpen.insert(createTreeNode(currentT, (*i)));
 				}
 			} else {
 				retNode = currentNode;
@@ -173,7 +148,7 @@ Node *Tree::aStarSearch_singlePassInit() {
 	float temp = pBaseNode->getContainedObject()->calcT();
 
 	if (static_cast<int>(temp) != SUCCESS) {
-		_currentMap->insert(new TreeNode(pBaseNode->getObjectT(), pBaseNode));
+		_currentMap->insert(createTreeNode(pBaseNode->getObjectT(), pBaseNode));
 	} else {
 		retNode = pBaseNode;
 	}
@@ -197,8 +172,7 @@ Node *Tree::aStarSearch_singlePass() {
 			return retNode;
 		}
 
-		_currentNode = _currentMap->front()->node;
-		_currentMap->erase(_currentMap->begin());
+		_currentNode = popOpenNode(*_currentMap);
 	}
 
 	if ((_currentNode->getDepth() < _maxDepth) && (Node::getNodeCount() < _maxNodes) && ((!maxTime) || (_ai->getTimerValue(3) < maxTime))) {
@@ -206,14 +180,14 @@ Node *Tree::aStarSearch_singlePass() {
 		_currentChildIndex = _currentNode->generateChildren();
 
 		if (_currentChildIndex) {
-			Common::Array<Node *> vChildren = _currentNode->getChildren();
+			const Common::Array<Node *> &vChildren = _currentNode->getChildren();
 
 			if (!vChildren.size() && !_currentMap->size()) {
 				_currentChildIndex = 0;
 				retNode = _currentNode;
 			}
 
-			for (Common::Array<Node *>::iterator i = vChildren.begin(); i != vChildren.end(); i++) {
+			for (Common::Array<Node *>::const_iterator i = vChildren.begin(); i != vChildren.end(); i++) {
 				IContainedObject *pTemp = (*i)->getContainedObject();
 				currentT = pTemp->calcT();
 
@@ -221,7 +195,7 @@ Node *Tree::aStarSearch_singlePass() {
 					retNode = *i;
 					i = vChildren.end() - 1;
 				} else {
-					_currentMap->insert(new TreeNode(currentT, (*i)));
+					_currentMap->insert(createTreeNode(currentT, (*i)));
 				}
 			}
 
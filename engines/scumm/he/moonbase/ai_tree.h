@@ -41,6 +41,11 @@ struct TreeNode {
 
 class Tree {
 private:
+	// Arenas for this tree's nodes and open list entries. They are
+	// released in one go when the tree (i.e. the search) is destroyed.
+	NodePool _nodePool;
+	Common::ObjectPool<TreeNode, 64> _treeNodePool;
+
 	Node *pBaseNode;
 
 	int _maxDepth;
@@ -53,16 +58,19 @@ private:
 
 	AI *_ai;
 
+	int _numExpanded;
+
+	void init(IContainedObject *contents, int maxDepth, int maxNodes);
+	TreeNode *createTreeNode(float value, Node *node) { return new (_treeNodePool) TreeNode(value, node); }
+	Node *popOpenNode(Common::SortedArray<TreeNode *> &openList);
+
 public:
 	Tree(AI *ai);
 	Tree(IContainedObject *contents, AI *ai);
 	Tree(IContainedObject *contents, int maxDepth, AI *ai);
 	Tree(IContainedObject *contents, int maxDepth, int maxNodes, AI *ai);
-	Tree(const Tree *sourceTree, AI *ai);
 	~Tree();
 
-	void duplicateTree(Node *sourceNode, Node *destNode);
-
 	Node *getBaseNode() const { return pBaseNode; }
 	void setMaxDepth(int maxDepth) { _maxDepth = maxDepth; }
 	int getMaxDepth() const { return _maxDepth; }
@@ -94,6 +94,7 @@ IMuseDigital::IMuseDigital(ScummEngine_v7 *scumm, int sampleRate, Audio::Mixer *
 
 	_emptyMarker[0] = '\0';
 	_internalMixer = new IMuseDigiInternalMixer(mixer, _internalSampleRate, _isEarlyDiMUSE, _lowLatencyMode);
+	_internalMixer->enableSIMD();
 	_groupsHandler = new IMuseDigiGroupsHandler(this, mutex);
 	_fadesHandler = new IMuseDigiFadesHandler(this, mutex);
 	_triggersHandler = new IMuseDigiTriggersHandler(this, mutex);
@@ -22,6 +22,7 @@
 #include "common/scummsys.h"
 #include "common/mutex.h"
 #include "common/serializer.h"
+#include "common/system.h"
 #include "common/textconsole.h"
 #include "common/util.h"
 
@@ -187,6 +188,18 @@ void IMuseDigiInternalMixer::clearRadioChatter() {
 	_radioChatter = 0;
 }
 
+void IMuseDigiInternalMixer::enableSIMD() {
+	// Pick the vectorized mix paths if the CPU supports them
+#ifdef SCUMMVM_NEON
+	if (g_system->hasFeature(OSystem::kFeatureCpuNEON))
+		_mixBlockFunc = mixBlockNEON;
+#endif
+#ifdef SCUMMVM_SSE2
+	if (g_system->hasFeature(OSystem::kFeatureCpuSSE2))
+		_mixBlockFunc = mixBlockSSE2;
+#endif
+}
+
 int IMuseDigiInternalMixer::clearMixerBuffer() {
 	if (!_mixBuf)
 		return -1;
@@ -221,7 +234,9 @@ void IMuseDigiInternalMixer::mix(uint8 *srcBuf, int32 inFrameCount, int wordSize
 					// Linear volume quantization from the lookup table
 					rightChannelVolume = _stereoVolumeTable[17 * channelVolume + channelPan];
 					leftChannelVolume = _stereoVolumeTable[17 * channelVolume - channelPan];
-					if (wordSize == 8) {
+					if (mixBlock(srcBuf, inFrameCount, wordSize, channelCount, feedSize, mixBufStartIndex, leftChannelVolume, rightChannelVolume, ftIs11025Hz)) {
+						return;
+					} else if (wordSize == 8) {
 						mixBits8ConvertToStereo(
 							srcBuf,
 							inFrameCount,
@@ -259,7 +274,9 @@ void IMuseDigiInternalMixer::mix(uint8 *srcBuf, int32 inFrameCount, int wordSize
 					else
 						ampTable = &_amp12Table[channelVolume * 2048];
 
-					if (_outChannelCount == 1) {
+					if (mixBlock(srcBuf, inFrameCount, wordSize, channelCount, feedSize, mixBufStartIndex, channelVolume, channelVolume, ftIs11025Hz)) {
+						return;
+					} else if (_outChannelCount == 1) {
 						if (channelCount == 1) {
 							if (wordSize == 8) {
 								mixBits8Mono(srcBuf, inFrameCount, feedSize, mixBufStartIndex, ampTable, ftIs11025Hz);
@@ -371,6 +388,89 @@ Audio::QueuingAudioStream *IMuseDigiInternalMixer::getStream(int idx) {
 	}
 }
 
+bool IMuseDigiInternalMixer::mixBlock(uint8 *srcBuf, int32 inFrameCount, int wordSize, int channelCount, int feedSize, int32 mixBufStartIndex, int leftVolume, int rightVolume, bool ftIs11025Hz) {
+	MixBlockArgs args;
+	int32 numSamples, dstOffset;
+
+	if (!_mixBlockFunc)
+		return false;
+
+	// Radio chatter and 12-bit data with an odd number of samples
+	// are rare enough to be left to the regular mix paths
+	if ((wordSize == 8 && _radioChatter && !_isEarlyDiMUSE) || (wordSize == 12 && (inFrameCount & 1)))
+		return false;
+
+	// Only plain and doubled sample rates are handled, in the same way as the
+	// regular mix paths; early DiMUSE decides about doubling 8-bit data by itself.
+	if (wordSize == 8 && _isEarlyDiMUSE && channelCount == 1) {
+		args.upsample = ftIs11025Hz;
+	} else if (feedSize == inFrameCount) {
+		args.upsample = false;
+	} else if (2 * inFrameCount == feedSize) {
+		args.upsample = true;
+	} else {
+		return false;
+	}
+
+	if (_outChannelCount == 1 && channelCount == 1) {
+		args.toStereo = false;
+		numSamples = inFrameCount;
+		dstOffset = 2 * mixBufStartIndex;
+	} else if (_outChannelCount == 2 && channelCount == 1) {
+		args.toStereo = true;
+		numSamples = inFrameCount;
+		dstOffset = (wordSize == 16 ? 2 : 4) * mixBufStartIndex;
+	} else if (_outChannelCount == 2 && channelCount == 2 && !args.upsample) {
+		// Both channels use the same volume, so this is a plain mono mix of
+		// the interleaved samples
+		args.toStereo = false;
+		numSamples = 2 * inFrameCount;
+		dstOffset = 4 * mixBufStartIndex;
+	} else {
+		return false;
+	}
+
+	args.leftAmp = leftVolume ? leftVolume * 8 - 1 : 0;
+	args.rightAmp = rightVolume ? rightVolume * 8 - 1 : 0;
+
+	// Convert the samples to signed 12-bit values in chunks, and mix those
+	const int32 chunkSize = 512;
+	int16 buf[chunkSize + 1];
+	uint16 *dst = (uint16 *)&_mixBuf[dstOffset];
+	const int dstStep = (args.toStereo ? 2 : 1) * (args.upsample ? 2 : 1);
+
+	for (int32 pos = 0; pos < numSamples; pos += chunkSize) {
+		int32 len = MIN<int32>(chunkSize, numSamples - pos);
+		int32 decodeLen = MIN<int32>(len + (args.upsample ? 1 : 0), numSamples - pos);
+
+		for (int32 i = 0; i < decodeLen; i++) {
+			int32 idx = pos + i;
+			if (wordSize == 8) {
+				buf[i] = (srcBuf[idx] - 128) * 16;
+			} else if (wordSize == 12) {
+				const uint8 *pair = &srcBuf[(idx >> 1) * 3];
+				if (idx & 1)
+					buf[i] = (pair[2] | ((pair[1] & 0xF0) << 4)) - 2048;
+				else
+					buf[i] = (pair[0] | ((pair[1] & 0x0F) << 8)) - 2048;
+			} else {
+				buf[i] = ((int16 *)srcBuf)[idx] >> 4;
+			}
+		}
+
+		// The last sample of a stream is repeated instead of interpolated
+		if (decodeLen == len)
+			buf[len] = buf[len - 1];
+
+		args.dst = dst + pos * dstStep;
+		args.src = buf;
+		args.count = len;
+		_mixBlockFunc(args);
+	}
+
+	return true;
+}
+
 void IMuseDigiInternalMixer::mixBits8Mono(uint8 *srcBuf, int32 inFrameCount, int feedSize, int32 mixBufStartIndex, int32 *ampTable, bool ftIs11025Hz) {
 	uint16 *mixBufCurCell;
 	uint8 *srcBuf_ptr;
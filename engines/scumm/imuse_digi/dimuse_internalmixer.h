@@ -40,11 +40,43 @@ class Mixer;
 class QueuingAudioStream;
 }
 
+class IMuseDigiInternalMixerTestSuite;
+
 namespace Scumm {
 
 class IMuseDigiInternalMixer {
+	friend class ::IMuseDigiInternalMixerTestSuite;
 
 private:
+	/**
+	 * Arguments for the vectorized mix paths.
+	 *
+	 * The amplitude tables hold trunc(amp * x / 127), where x is the sample
+	 * converted to a signed 12-bit value; the vectorized paths compute this
+	 * directly instead of going through the tables.
+	 */
+	struct MixBlockArgs {
+		uint16 *dst;       ///< Mix buffer position
+		const int16 *src;  ///< Signed 12-bit samples; one extra sample when upsampling
+		int32 count;       ///< Number of source samples
+		int leftAmp;       ///< Amplitude (0-127) of the left (or only) channel
+		int rightAmp;      ///< Amplitude (0-127) of the right channel, if toStereo
+		bool toStereo;     ///< Mix each sample into both channels of a stereo buffer
+		bool upsample;     ///< Double the sample rate, interpolating linearly
+	};
+
+	typedef void (*MixBlockFunc)(const MixBlockArgs &args);
+	MixBlockFunc _mixBlockFunc = nullptr;
+
+#ifdef SCUMMVM_NEON
+	static void mixBlockNEON(const MixBlockArgs &args);
+#endif
+#ifdef SCUMMVM_SSE2
+	static void mixBlockSSE2(const MixBlockArgs &args);
+#endif
+
+	bool mixBlock(uint8 *srcBuf, int32 inFrameCount, int wordSize, int channelCount, int feedSize, int32 mixBufStartIndex, int leftVolume, int rightVolume, bool ftIs11025Hz);
+
 	int32 *_amp8Table = nullptr;
 	int32 *_amp12Table = nullptr;
 	int32 *_softLMID = nullptr;
@@ -86,6 +118,7 @@ public:
 	void setRadioChatter();
 	void clearRadioChatter();
 	int  clearMixerBuffer();
+	void enableSIMD();
 
 	void mix(uint8 *srcBuf, int32 inFrameCount, int wordSize, int channelCount, int feedSize, int32 mixBufStartIndex, int volume, int pan, bool ftIs11025Hz);
 	int  loop(uint8 **destBuffer, int len);
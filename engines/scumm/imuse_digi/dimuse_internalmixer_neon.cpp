@@ -0,0 +1,149 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+// Without this ifdef the iOS backend breaks
+#ifdef SCUMMVM_NEON
+
+#include "scumm/imuse_digi/dimuse_engine.h"
+#include "scumm/imuse_digi/dimuse_internalmixer.h"
+
+#include <arm_neon.h>
+
+#if !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("neon"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("fpu=neon")
+#endif
+
+#endif // !defined(__aarch64__) && !defined(__ARM_NEON)
+
+namespace Scumm {
+
+// See ampSSE2() for how this matches the amplitude tables
+static inline float32x4_t ampQuotientNEON(int16x4_t x, float amp) {
+	const uint32x4_t signMask = vdupq_n_u32(0x80000000);
+	const uint32x4_t bias = vreinterpretq_u32_f32(vdupq_n_f32(1.0f / 1024.0f));
+
+	float32x4_t q = vmulq_n_f32(vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(x)), amp), 1.0f / 127.0f);
+	uint32x4_t signedBias = vorrq_u32(bias, vandq_u32(vreinterpretq_u32_f32(q), signMask));
+	return vaddq_f32(q, vreinterpretq_f32_u32(signedBias));
+}
+
+static inline int16x8_t ampNEON(int16x8_t x, float amp) {
+	int32x4_t lo = vcvtq_s32_f32(ampQuotientNEON(vget_low_s16(x), amp));
+	int32x4_t hi = vcvtq_s32_f32(ampQuotientNEON(vget_high_s16(x), amp));
+	return vcombine_s16(vmovn_s32(lo), vmovn_s32(hi));
+}
+
+static inline void accumulateNEON(uint16 *dst, int16x8_t value) {
+	vst1q_u16(dst, vaddq_u16(vld1q_u16(dst), vreinterpretq_u16_s16(value)));
+}
+
+template<bool toStereo, bool upsample>
+static void mixBlockNEONImpl(uint16 *dst, const int16 *src, int32 count, int leftAmp, int rightAmp) {
+	int32 i = 0;
+
+	for (; i + 8 <= count; i += 8) {
+		int16x8_t x = vld1q_s16(&src[i]);
+		int16x8_t left = ampNEON(x, (float)leftAmp);
+
+		if (!toStereo && !upsample) {
+			accumulateNEON(dst, left);
+			dst += 8;
+		} else if (!toStereo) {
+			int16x8_t next = ampNEON(vld1q_s16(&src[i + 1]), (float)leftAmp);
+			int16x8x2_t out = vzipq_s16(left, vshrq_n_s16(vaddq_s16(left, next), 1));
+			accumulateNEON(dst, out.val[0]);
+			accumulateNEON(dst + 8, out.val[1]);
+			dst += 16;
+		} else {
+			int16x8_t right = ampNEON(x, (float)rightAmp);
+
+			if (!upsample) {
+				int16x8x2_t out = vzipq_s16(left, right);
+				accumulateNEON(dst, out.val[0]);
+				accumulateNEON(dst + 8, out.val[1]);
+				dst += 16;
+			} else {
+				int16x8_t next = vld1q_s16(&src[i + 1]);
+				int16x8_t avgLeft = vshrq_n_s16(vaddq_s16(left, ampNEON(next, (float)leftAmp)), 1);
+				int16x8_t avgRight = vshrq_n_s16(vaddq_s16(right, ampNEON(next, (float)rightAmp)), 1);
+				int16x8x2_t frames = vzipq_s16(left, right);
+				int16x8x2_t avgFrames = vzipq_s16(avgLeft, avgRight);
+				int32x4x2_t lo = vzipq_s32(vreinterpretq_s32_s16(frames.val[0]), vreinterpretq_s32_s16(avgFrames.val[0]));
+				int32x4x2_t hi = vzipq_s32(vreinterpretq_s32_s16(frames.val[1]), vreinterpretq_s32_s16(avgFrames.val[1]));
+				accumulateNEON(dst, vreinterpretq_s16_s32(lo.val[0]));
+				accumulateNEON(dst + 8, vreinterpretq_s16_s32(lo.val[1]));
+				accumulateNEON(dst + 16, vreinterpretq_s16_s32(hi.val[0]));
+				accumulateNEON(dst + 24, vreinterpretq_s16_s32(hi.val[1]));
+				dst += 32;
+			}
+		}
+	}
+
+	for (; i < count; i++) {
+		int left = leftAmp * src[i] / 127;
+		int right = rightAmp * src[i] / 127;
+
+		*dst++ += left;
+		if (toStereo)
+			*dst++ += right;
+
+		if (upsample) {
+			*dst++ += (left + leftAmp * src[i + 1] / 127) >> 1;
+			if (toStereo)
+				*dst++ += (right + rightAmp * src[i + 1] / 127) >> 1;
+		}
+	}
+}
+
+void IMuseDigiInternalMixer::mixBlockNEON(const MixBlockArgs &args) {
+	if (args.toStereo) {
+		if (args.upsample)
+			mixBlockNEONImpl<true, true>(args.dst, args.src, args.count, args.leftAmp, args.rightAmp);
+		else
+			mixBlockNEONImpl<true, false>(args.dst, args.src, args.count, args.leftAmp, args.rightAmp);
+	} else {
+		if (args.upsample)
+			mixBlockNEONImpl<false, true>(args.dst, args.src, args.count, args.leftAmp, args.rightAmp);
+		else
+			mixBlockNEONImpl<false, false>(args.dst, args.src, args.count, args.leftAmp, args.rightAmp);
+	}
+}
+
+} // End of namespace Scumm
+
+#if !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#endif // SCUMMVM_NEON
@@ -0,0 +1,147 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#include "scumm/imuse_digi/dimuse_engine.h"
+#include "scumm/imuse_digi/dimuse_internalmixer.h"
+
+#include <emmintrin.h>
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("sse2"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("sse2")
+#endif
+
+#endif // !defined(__x86_64__)
+
+namespace Scumm {
+
+// Computes trunc(amp * x / 127) like the amplitude tables do. The product is
+// exact in single precision, and the quotient is nudged away from zero by
+// less than the distance of any non-integer result to the next integer, so
+// that truncating it gives the same result as the integer division.
+static inline __m128i ampSSE2(__m128i x, __m128 amp) {
+	const __m128 scale = _mm_set1_ps(1.0f / 127.0f);
+	const __m128 bias = _mm_set1_ps(1.0f / 1024.0f);
+	const __m128 signMask = _mm_set1_ps(-0.0f);
+
+	__m128 lo = _mm_mul_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(x, x), 16)), amp), scale);
+	__m128 hi = _mm_mul_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(x, x), 16)), amp), scale);
+
+	lo = _mm_add_ps(lo, _mm_or_ps(bias, _mm_and_ps(lo, signMask)));
+	hi = _mm_add_ps(hi, _mm_or_ps(bias, _mm_and_ps(hi, signMask)));
+
+	return _mm_packs_epi32(_mm_cvttps_epi32(lo), _mm_cvttps_epi32(hi));
+}
+
+static inline void accumulateSSE2(uint16 *dst, __m128i value) {
+	_mm_storeu_si128((__m128i *)dst, _mm_add_epi16(_mm_loadu_si128((const __m128i *)dst), value));
+}
+
+template<bool toStereo, bool upsample>
+static void mixBlockSSE2Impl(uint16 *dst, const int16 *src, int32 count, int leftAmp, int rightAmp) {
+	const __m128 leftAmpVec = _mm_set1_ps((float)leftAmp);
+	const __m128 rightAmpVec = _mm_set1_ps((float)rightAmp);
+	int32 i = 0;
+
+	for (; i + 8 <= count; i += 8) {
+		__m128i x = _mm_loadu_si128((const __m128i *)&src[i]);
+		__m128i left = ampSSE2(x, leftAmpVec);
+
+		if (!toStereo && !upsample) {
+			accumulateSSE2(dst, left);
+			dst += 8;
+		} else if (!toStereo) {
+			__m128i next = ampSSE2(_mm_loadu_si128((const __m128i *)&src[i + 1]), leftAmpVec);
+			__m128i avg = _mm_srai_epi16(_mm_add_epi16(left, next), 1);
+			accumulateSSE2(dst, _mm_unpacklo_epi16(left, avg));
+			accumulateSSE2(dst + 8, _mm_unpackhi_epi16(left, avg));
+			dst += 16;
+		} else {
+			__m128i right = ampSSE2(x, rightAmpVec);
+			__m128i lo = _mm_unpacklo_epi16(left, right);
+			__m128i hi = _mm_unpackhi_epi16(left, right);
+
+			if (!upsample) {
+				accumulateSSE2(dst, lo);
+				accumulateSSE2(dst + 8, hi);
+				dst += 16;
+			} else {
+				__m128i next = _mm_loadu_si128((const __m128i *)&src[i + 1]);
+				__m128i avgLeft = _mm_srai_epi16(_mm_add_epi16(left, ampSSE2(next, leftAmpVec)), 1);
+				__m128i avgRight = _mm_srai_epi16(_mm_add_epi16(right, ampSSE2(next, rightAmpVec)), 1);
+				__m128i avgLo = _mm_unpacklo_epi16(avgLeft, avgRight);
+				__m128i avgHi = _mm_unpackhi_epi16(avgLeft, avgRight);
+				accumulateSSE2(dst, _mm_unpacklo_epi32(lo, avgLo));
+				accumulateSSE2(dst + 8, _mm_unpackhi_epi32(lo, avgLo));
+				accumulateSSE2(dst + 16, _mm_unpacklo_epi32(hi, avgHi));
+				accumulateSSE2(dst + 24, _mm_unpackhi_epi32(hi, avgHi));
+				dst += 32;
+			}
+		}
+	}
+
+	for (; i < count; i++) {
+		int left = leftAmp * src[i] / 127;
+		int right = rightAmp * src[i] / 127;
+
+		*dst++ += left;
+		if (toStereo)
+			*dst++ += right;
+
+		if (upsample) {
+			*dst++ += (left + leftAmp * src[i + 1] / 127) >> 1;
+			if (toStereo)
+				*dst++ += (right + rightAmp * src[i + 1] / 127) >> 1;
+		}
+	}
+}
+
+void IMuseDigiInternalMixer::mixBlockSSE2(const MixBlockArgs &args) {
+	if (args.toStereo) {
+		if (args.upsample)
+			mixBlockSSE2Impl<true, true>(args.dst, args.src, args.count, args.leftAmp, args.rightAmp);
+		else
+			mixBlockSSE2Impl<true, false>(args.dst, args.src, args.count, args.leftAmp, args.rightAmp);
+	} else {
+		if (args.upsample)
+			mixBlockSSE2Impl<false, true>(args.dst, args.src, args.count, args.leftAmp, args.rightAmp);
+		else
+			mixBlockSSE2Impl<false, false>(args.dst, args.src, args.count, args.leftAmp, args.rightAmp);
+	}
+}
+
+} // End of namespace Scumm
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__x86_64__)
@@ -48,6 +48,8 @@ enum {
 	RF_USAGE = 0x7F,
 	RF_USAGE_MAX = RF_USAGE,
 
+	RS_EXPIRED = 0x01,
+	RS_LRU_LINKED = 0x02,
 	RS_MODIFIED = 0x10,
 	RF_OFFHEAP = 0x40
 };
@@ -548,6 +550,8 @@ void ResourceManager::allocResTypeData(ResType type, uint32 tag, int num, ResTyp
 
 	// If there was data in there, let's clear it out completely. This is important
 	// in case we are restarting the game.
+	for (ResId idx = 0; idx < _types[type].size(); idx++)
+		unlinkLRU(type, idx);
 	_types[type].clear();
 	_types[type].resize(num);
 
@@ -816,32 +820,91 @@ void ResourceManager::increaseExpireCounter() {
 }
 
 void ResourceManager::increaseResourceCounters() {
-	for (ResType type = rtFirst; type <= rtLast; type = ResType(type + 1)) {
-		ResId idx = _types[type].size();
-		while (idx-- > 0) {
-			_mutex->lock();
-			byte counter = _types[type][idx].getResourceCounter();
-			_mutex->unlock();
-
-			if (counter && counter < RF_USAGE_MAX) {
-				setResourceCounter(type, idx, counter + 1);
-			}
-		}
+	// Counters are derived from the usage clock, so advancing it ages all
+	// loaded resources at once.
+	Common::StackLock lock(*_mutex);
+	++_usageClock;
+
+	// The resources last used RF_USAGE_MAX - 1 ticks ago just saturated, so
+	// append their list to the saturated one
+	LRUList &list = _lru[(_usageClock - (RF_USAGE_MAX - 1)) % kLRUClockLists];
+	if (list.head) {
+		LRUList &saturated = _lru[kLRUSaturatedList];
+		getLRUResource(list.head)._lruPrev = saturated.tail;
+		if (saturated.tail)
+			getLRUResource(saturated.tail)._lruNext = list.head;
+		else
+			saturated.head = list.head;
+		saturated.tail = list.tail;
+		list.head = list.tail = 0;
 	}
 }
 
 void ResourceManager::setResourceCounter(ResType type, ResId idx, byte counter) {
 	Common::StackLock lock(*_mutex);
-	_types[type][idx].setResourceCounter(counter);
+	Resource &res = _types[type][idx];
+
+	if (counter < 1)
+		counter = 1;
+	else if (counter > RF_USAGE_MAX)
+		counter = RF_USAGE_MAX;
+
+	// The LRU list a resource is in depends on its counter
+	const bool linked = (res._status & RS_LRU_LINKED) != 0;
+	unlinkLRU(type, idx);
+	res._lastUsed = _usageClock - (counter - 1);
+	if (linked)
+		linkLRU(type, idx);
 }
 
-void ResourceManager::Resource::setResourceCounter(byte counter) {
-	_flags &= RF_LOCK;	// Clear lower 7 bits, preserve the lock bit.
-	_flags |= counter;	// Update the usage counter
+ResourceManager::LRUList &ResourceManager::getLRUList(const Resource &res) {
+	static_assert((int)RF_USAGE_MAX <= (int)kLRUClockLists, "Not enough LRU lists for all unsaturated counters");
+
+	// Resources are moved to the saturated list as the clock advances, see
+	// increaseResourceCounters()
+	if (_usageClock - res._lastUsed + 1 >= RF_USAGE_MAX)
+		return _lru[kLRUSaturatedList];
+	return _lru[res._lastUsed % kLRUClockLists];
 }
 
-byte ResourceManager::Resource::getResourceCounter() const {
-	return _flags & RF_USAGE;
+void ResourceManager::linkLRU(ResType type, ResId idx) {
+	Resource &res = _types[type][idx];
+	const uint32 handle = makeLRUHandle(type, idx);
+
+	if ((res._status & RS_LRU_LINKED) || !res._address || res.isLocked() || _types[type]._mode == kDynamicResTypeMode)
+		return;
+
+	res._status |= RS_LRU_LINKED;
+
+	LRUList &list = getLRUList(res);
+	res._lruPrev = list.tail;
+	res._lruNext = 0;
+	if (list.tail)
+		getLRUResource(list.tail)._lruNext = handle;
+	else
+		list.head = handle;
+	list.tail = handle;
+}
+
+void ResourceManager::unlinkLRU(ResType type, ResId idx) {
+	Resource &res = _types[type][idx];
+
+	if (!(res._status & RS_LRU_LINKED))
+		return;
+
+	LRUList &list = getLRUList(res);
+	if (res._lruPrev)
+		getLRUResource(res._lruPrev)._lruNext = res._lruNext;
+	else
+		list.head = res._lruNext;
+
+	if (res._lruNext)
+		getLRUResource(res._lruNext)._lruPrev = res._lruPrev;
+	else
+		list.tail = res._lruPrev;
+
+	res._lruPrev = res._lruNext = 0;
+	res._status &= ~RS_LRU_LINKED;
 }
 
 byte *ResourceManager::createResource(ResType type, ResId idx, uint32 size) {
@@ -892,11 +955,22 @@ byte *ResourceManager::createResource(ResType type, ResId idx, uint32 size) {
 		error("createResource(%s,%d): Out of memory while allocating %d", nameOfResType(type), idx, size);
 	}
 
+	Common::StackLock lock(*_mutex);
 	_allocatedSize += size;
 
-	_types[type][idx]._address = ptr;
-	_types[type][idx]._size = size;
+	Resource &res = _types[type][idx];
+	if (res._status & RS_EXPIRED) {
+		// We threw this one out earlier and now have to read it back in
+		res._status &= ~RS_EXPIRED;
+		_statReloads++;
+		_statBytesReloaded += size;
+		debugC(DEBUG_RESOURCE, "createResource(%s,%d): Reloading expired resource", nameOfResType(type), idx);
+	}
+
+	res._address = ptr;
+	res._size = size;
 	setResourceCounter(type, idx, 1);
+	linkLRU(type, idx);
 
 	_vm->_insideCreateResource--;
 
@@ -908,6 +982,9 @@ ResourceManager::Resource::Resource() {
 	_size = 0;
 	_flags = 0;
 	_status = 0;
+	_lastUsed = 0;
+	_lruPrev = 0;
+	_lruNext = 0;
 	_roomno = 0;
 	_roomoffs = 0;
 }
@@ -939,6 +1016,12 @@ ResourceManager::ResourceManager(ScummEngine *vm) : _vm(vm) {
 	_maxHeapThreshold = 0;
 	_minHeapThreshold = 0;
 	_expireCounter = 0;
+	_usageClock = 0;
+	for (int i = 0; i <= kLRUSaturatedList; i++)
+		_lru[i].head = _lru[i].tail = 0;
+	_statEvictions = 0;
+	_statReloads = 0;
+	_statBytesReloaded = 0;
 }
 
 ResourceManager::~ResourceManager() {
@@ -966,6 +1049,7 @@ void ResourceManager::nukeResource(ResType type, ResId idx) {
 	if (ptr != nullptr) {
 		debugC(DEBUG_RESOURCE, "nukeResource(%s,%d)", nameOfResType(type), idx);
 		_allocatedSize -= _types[type][idx]._size;
+		unlinkLRU(type, idx);
 		_types[type][idx].nuke();
 	}
 }
@@ -999,6 +1083,8 @@ void ResourceManager::lock(ResType type, ResId idx) {
 	Common::StackLock lock(*_mutex);
 	if (!validateResource("Locking", type, idx))
 		return;
+	// Locked resources can't be expired, so keep them out of the LRU list
+	unlinkLRU(type, idx);
 	_types[type][idx].lock();
 }
 
@@ -1007,6 +1093,7 @@ void ResourceManager::unlock(ResType type, ResId idx) {
 	if (!validateResource("Unlocking", type, idx))
 		return;
 	_types[type][idx].unlock();
+	linkLRU(type, idx);
 }
 
 bool ResourceManager::isLocked(ResType type, ResId idx) const {
@@ -1110,10 +1197,7 @@ void ResourceManager::Resource::setOnHeap() {
 }
 
 void ResourceManager::expireResources(uint32 size) {
-	byte best_counter;
-	ResType best_type;
-	int best_res = 0;
-	uint32 oldAllocatedSize;
+	uint32 oldAllocatedSize, numExpired = 0;
 
 	if (_expireCounter != 0xFF) {
 		_expireCounter = 0xFF;
@@ -1125,35 +1209,33 @@ void ResourceManager::expireResources(uint32 size) {
 
 	oldAllocatedSize = _allocatedSize;
 
-	do {
-		best_type = rtInvalid;
-		best_counter = 2;
-
-		for (ResType type = rtFirst; type <= rtLast; type = ResType(type + 1)) {
-			if (_types[type]._mode != kDynamicResTypeMode) {
-				// Resources of this type can be reloaded from the data files,
-				// so we can potentially unload them to free memory.
-				ResId idx = _types[type].size();
-				while (idx-- > 0) {
-					Resource &tmp = _types[type][idx];
-					byte counter = tmp.getResourceCounter();
-					if (!tmp.isLocked() && counter >= best_counter && tmp._address && !_vm->isResourceInUse(type, idx) && !tmp.isOffHeap()) {
-						best_counter = counter;
-						best_type = type;
-						best_res = idx;
-					}
-				}
-			}
-		}
+	// The LRU lists only contain unlocked resources which can be reloaded
+	// from the data files. Walk them oldest first, starting with the saturated
+	// ones, until we either freed enough memory or reach the resources which
+	// were used just now.
+	for (uint32 age = RF_USAGE_MAX; age >= 2 && size + _allocatedSize > _minHeapThreshold; age--) {
+		const LRUList &list = (age == RF_USAGE_MAX) ? _lru[kLRUSaturatedList] : _lru[(_usageClock - (age - 1)) % kLRUClockLists];
+
+		uint32 handle = list.head;
+		while (handle && size + _allocatedSize > _minHeapThreshold) {
+			const ResType type = ResType(handle >> 16);
+			const ResId idx = handle & 0xFFFF;
+			Resource &tmp = _types[type][idx];
 
-		if (!best_type)
-			break;
-		nukeResource(best_type, best_res);
-	} while (size + _allocatedSize > _minHeapThreshold);
+			handle = tmp._lruNext;
+			if (_vm->isResourceInUse(type, idx) || tmp.isOffHeap())
+				continue;
+
+			nukeResource(type, idx);
+			tmp._status |= RS_EXPIRED;
+			numExpired++;
+		}
+	}
+	_statEvictions += numExpired;
 
 	increaseResourceCounters();
 
-	debugC(DEBUG_RESOURCE, "Expired resources, mem %d -> %d", oldAllocatedSize, _allocatedSize);
+	debugC(DEBUG_RESOURCE, "Expired %d resources, mem %d -> %d", numExpired, oldAllocatedSize, _allocatedSize);
 }
 
 void ResourceManager::freeResources() {
@@ -1233,6 +1315,8 @@ void ResourceManager::resourceStats() {
 	}
 
 	debug("Total allocated size=%d, locked=%d(%d)", _allocatedSize, lockedSize, lockedNum);
+	debug("Heap threshold=%d..%d, evictions=%d, reloads=%d, bytes reloaded=%d",
+		_minHeapThreshold, _maxHeapThreshold, _statEvictions, _statReloads, _statBytesReloaded);
 }
 
 void ScummEngine_v5::readMAXS(int blockSize) {
@@ -98,23 +98,38 @@ public:
 		uint32 _size;
 
 	protected:
+		friend class ResourceManager;
+
 		/**
 		 * The uppermost bit indicates whether the resources is locked.
-		 * The lower 7 bits contain a counter. This counter measures roughly
-		 * how old the resource is; it starts out with a count of 1 and can go
-		 * as high as 127. When memory falls low resp. when the engine decides
-		 * that it should throw out some unused stuff, then it begins by
-		 * removing the resources with the highest counter (excluding locked
-		 * resources and resources that are known to be in use).
+		 * The remaining bits are unused.
 		 */
 		byte _flags;
 
 		/**
-		 * The status of the resource. Currently only one bit is used, which
-		 * indicates whether the resource is modified.
+		 * The status of the resource. This indicates whether the resource is
+		 * modified, kept off the heap, was expired to free memory, or is
+		 * currently queued in the LRU list of the resource manager.
 		 */
 		byte _status;
 
+		/**
+		 * Value of the resource manager's usage clock when this resource was
+		 * last used. The difference to the current clock (plus one) is the
+		 * "counter" of the original engine, which measures roughly how old
+		 * the resource is. When memory falls low resp. when the engine decides
+		 * that it should throw out some unused stuff, then it begins by
+		 * removing the oldest resources (excluding locked resources and
+		 * resources that are known to be in use).
+		 */
+		uint32 _lastUsed;
+
+		/**
+		 * Handles (see ResourceManager::makeLRUHandle) of the neighbours of
+		 * this resource in the LRU list, or 0 if there is none.
+		 */
+		uint32 _lruPrev, _lruNext;
+
 	public:
 		/**
 		 * The id of the room (resp. the disk) the resource is contained in.
@@ -137,9 +152,6 @@ public:
 
 		void nuke();
 
-		inline void setResourceCounter(byte counter);
-		inline byte getResourceCounter() const;
-
 		void lock();
 		void unlock();
 		bool isLocked() const;
@@ -181,6 +193,33 @@ protected:
 	uint32 _maxHeapThreshold, _minHeapThreshold;
 	byte _expireCounter;
 
+	/**
+	 * Usage clock, advanced by increaseResourceCounters(). Resources store
+	 * the clock value of their last use, so aging all of them is O(1).
+	 */
+	uint32 _usageClock;
+
+	/**
+	 * Intrusive doubly linked lists of all loaded, unlocked resources which
+	 * can be reloaded from the game data files. There is one list per usage
+	 * clock value, indexed by _lastUsed modulo kLRUClockLists, plus one list
+	 * for all resources with a saturated counter, as these compare equal.
+	 * Scripts may set arbitrary counters, so this keeps every update O(1)
+	 * without sorting, while expireResources() still visits the resources
+	 * oldest first.
+	 */
+	enum {
+		kLRUClockLists = 128,
+		kLRUSaturatedList = kLRUClockLists
+	};
+	struct LRUList {
+		uint32 head, tail;
+	};
+	LRUList _lru[kLRUClockLists + 1];
+
+	/** Statistics, see resourceStats(). */
+	uint32 _statEvictions, _statReloads, _statBytesReloaded;
+
 public:
 	ResourceManager(ScummEngine *vm);
 	~ResourceManager();
@@ -223,8 +262,8 @@ public:
 	void setResourceCounter(ResType type, ResId idx, byte counter);
 
 	/**
-	 * Increment the counter of all unlocked loaded resources.
-	 * The maximal count is 255.
+	 * Increment the counter of all loaded resources.
+	 * The maximal count is 127.
 	 * This is called by increaseExpireCounter and expireResources,
 	 * but also by ScummEngine::startScene.
 	 */
@@ -236,6 +275,12 @@ public:
 	bool validateResource(const char *str, ResType type, ResId idx) const;
 protected:
 	void expireResources(uint32 size);
+
+	static uint32 makeLRUHandle(ResType type, ResId idx) { return ((uint32)type << 16) | idx; }
+	Resource &getLRUResource(uint32 handle) { return _types[handle >> 16][handle & 0xFFFF]; }
+	LRUList &getLRUList(const Resource &res);
+	void linkLRU(ResType type, ResId idx);
+	void unlinkLRU(ResType type, ResId idx);
 };
 
 } // End of namespace Scumm
@@ -1768,6 +1768,19 @@ void ScummEngine::setupScumm(const Common::Path &macResourceFile) {
 	_res->setHeapThreshold(16 * 1024 * 1024, 32 * 1024 * 1024);
 #endif
 
+	// Allow overriding the resource heap budget (in KB), e.g. for HE games with
+	// thousands of resources which would otherwise be constantly reloaded.
+	if (ConfMan.hasKey("resource_heap_size", _targetName)) {
+		int heapSize = ConfMan.getInt("resource_heap_size", _targetName);
+		if (heapSize > 0) {
+			// Limit it to 1 GB, so that the size in bytes fits in an int
+			heapSize = MIN(heapSize, 1024 * 1024);
+			// Expire resources down to three quarters of the budget, so
+			// that not every allocation past it has to expire some
+			_res->setHeapThreshold(heapSize / 4 * 3 * 1024, heapSize * 1024);
+		}
+	}
+
 	free(_compositeBuf);
 	_compositeBuf = (byte *)malloc(_screenWidth * _textSurfaceMultiplier * _screenHeight * _textSurfaceMultiplier * _outputPixelFormat.bytesPerPixel);
 
@@ -19,6 +19,8 @@
  *
  */
 
+#include "common/system.h"
+
 #include "ultima/ultima.h"
 #include "ultima/ultima8/gumps/game_map_gump.h"
 #include "ultima/ultima8/gumps/gump_notify_process.h"
@@ -49,14 +51,14 @@ int GameMapGump::_gridlines = 0;
 
 GameMapGump::GameMapGump() :
 	Gump(), _displayDragging(false), _displayList(0), _draggingShape(0),
-		_draggingFrame(0), _draggingFlags(0) {
+		_draggingFrame(0), _draggingFlags(0), _paintZLimit(0), _paintLerpFactor(0) {
 	_displayList = new ItemSorter(2048);
 }
 
 GameMapGump::GameMapGump(int x, int y, int width, int height) :
 		Gump(x, y, width, height, 0, FLAG_DONT_SAVE | FLAG_CORE_GUMP, LAYER_GAMEMAP),
 		_displayList(0), _displayDragging(false), _draggingShape(0), _draggingFrame(0),
-		_draggingFlags(0) {
+		_draggingFlags(0), _paintZLimit(0), _paintLerpFactor(0) {
 	// Offset the gump. We want 0,0 to be the centre
 	_dims.moveTo(-_dims.width() / 2, -_dims.height() / 2);
 
@@ -106,6 +108,25 @@ void GameMapGump::PaintThis(RenderSurface *surf, int32 lerp_factor, bool scaled)
 	}
 
 	Common::Rect32 clipWindow = surf->getClippingRect();
+	BuildDisplayList(clipWindow, loc, zlimit, lerp_factor);
+
+	// Kept to restore this display list after a benchmark
+	_paintClipWindow = clipWindow;
+	_paintLoc = loc;
+	_paintZLimit = zlimit;
+	_paintLerpFactor = lerp_factor;
+
+	int gridlines = _gridlines;
+	if (gridlines < 0) {
+		gridlines = map->getChunkSize();
+	}
+
+	_displayList->PaintDisplayList(surf, _highlightItems, _showFootpads, gridlines);
+}
+
+void GameMapGump::BuildDisplayList(const Common::Rect32 &clipWindow, const Point3 &loc, int zlimit, int32 lerp_factor) {
+	CurrentMap *map = World::get_instance()->getCurrentMap();
+
 	_displayList->BeginDisplayList(clipWindow, loc);
 
 	uint32 gametick = Kernel::get_instance()->getFrameNum();
@@ -158,13 +179,27 @@ void GameMapGump::PaintThis(RenderSurface *surf, int32 lerp_factor, bool scaled)
 		_displayList->AddItem(_draggingPos, _draggingShape, _draggingFrame,
 		                      _draggingFlags, Item::EXT_TRANSPARENT);
 	}
+}
 
-	int gridlines = _gridlines;
-	if (gridlines < 0) {
-		gridlines = map->getChunkSize();
+bool GameMapGump::BenchmarkDisplayList(const Common::Array<Point3> &cameras, int iterations, uint32 &elapsed) {
+	World *world = World::get_instance();
+	if (!world || !world->getCurrentMap() || cameras.empty() || _paintClipWindow.isEmpty())
+		return false;
+
+	// Roofs are not hidden, as they are when painting
+	uint32 start = g_system->getMillis();
+	for (int i = 0; i < iterations; i++) {
+		for (const auto &loc : cameras) {
+			BuildDisplayList(_paintClipWindow, loc, 1 << 16, 256);
+			_displayList->SortDisplayList();
+		}
 	}
+	elapsed = g_system->getMillis() - start;
 
-	_displayList->PaintDisplayList(surf, _highlightItems, _showFootpads, gridlines);
+	// Tracing clicks uses the display list, so put back the painted one
+	BuildDisplayList(_paintClipWindow, _paintLoc, _paintZLimit, _paintLerpFactor);
+
+	return true;
 }
 
 // Trace a click, and return ObjId
@@ -76,6 +76,11 @@ public:
 
 	void IncSortOrder(int count);
 
+	// Build and sort the display list as seen from each of the cameras, the
+	// given number of times, with the clipping of the last paint. Sets the
+	// time taken in milliseconds, returns false if nothing was painted yet.
+	bool BenchmarkDisplayList(const Common::Array<Point3> &cameras, int iterations, uint32 &elapsed);
+
 	bool loadData(Common::ReadStream *rs, uint32 version);
 	void saveData(Common::WriteStream *ws) override;
 
@@ -101,12 +106,20 @@ public:
 	void        RenderSurfaceChanged() override;
 
 protected:
+	void BuildDisplayList(const Common::Rect32 &clipWindow, const Point3 &loc, int zlimit, int32 lerp_factor);
+
 	bool _displayDragging;
 	uint32 _draggingShape;
 	uint32 _draggingFrame;
 	uint32 _draggingFlags;
 	Point3 _draggingPos;
 
+	// Parameters of the display list built by the last PaintThis()
+	Common::Rect32 _paintClipWindow;
+	Point3 _paintLoc;
+	int _paintZLimit;
+	int32 _paintLerpFactor;
+
 	static bool _highlightItems;
 	static bool _showFootpads;
 	static int _gridlines;
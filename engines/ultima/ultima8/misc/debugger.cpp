@@ -99,6 +99,7 @@ Debugger::Debugger() : GUI::Debugger() {
 	registerCmd("GameMapGump::dumpAllMaps", WRAP_METHOD(Debugger, cmdDumpAllMaps));
 	registerCmd("GameMapGump::incrementSortOrder", WRAP_METHOD(Debugger, cmdIncrementSortOrder));
 	registerCmd("GameMapGump::decrementSortOrder", WRAP_METHOD(Debugger, cmdDecrementSortOrder));
+	registerCmd("GameMapGump::benchmarkSort", WRAP_METHOD(Debugger, cmdBenchmarkSort));
 
 	registerCmd("Kernel::processTypes", WRAP_METHOD(Debugger, cmdProcessTypes));
 	registerCmd("Kernel::processInfo", WRAP_METHOD(Debugger, cmdProcessInfo));
@@ -901,6 +902,57 @@ bool Debugger::cmdDecrementSortOrder(int argc, const char **argv) {
 	return false;
 }
 
+bool Debugger::cmdBenchmarkSort(int argc, const char **argv) {
+	GameMapGump *gump = Ultima8Engine::get_instance()->getGameMapGump();
+	if (!gump) {
+		debugPrintf("No game map\n");
+		return true;
+	}
+
+	int iterations = argc > 1 ? strtol(argv[1], 0, 0) : 100;
+	if (iterations <= 0) {
+		debugPrintf("Usage: %s [iterations] [mark...]: time building the display list at the named marks, or at the camera\n", argv[0]);
+		return true;
+	}
+
+	// Marks are camera positions saved with MainActor::mark. Only the ones
+	// on the current map can be used, and only items in the fast area are seen.
+	MainActor *av = getMainActor();
+	if (!av) {
+		debugPrintf("No main actor\n");
+		return true;
+	}
+	int curmap = av->getMapNum();
+	Common::Array<Point3> cameras;
+	for (int i = 2; i < argc; i++) {
+		Common::String key = Common::String::format("mark_%s", argv[i]);
+		int t[4];
+		if (!ConfMan.hasKey(key) || sscanf(ConfMan.get(key).c_str(), "%d%d%d%d", &t[0], &t[1], &t[2], &t[3]) != 4) {
+			debugPrintf("No such mark: %s\n", argv[i]);
+			continue;
+		}
+		if (t[0] != curmap) {
+			debugPrintf("Mark %s is not on the current map\n", argv[i]);
+			continue;
+		}
+		cameras.push_back(Point3(t[1], t[2], t[3]));
+	}
+	if (argc <= 2)
+		cameras.push_back(gump->GetCameraLocation());
+	if (cameras.empty())
+		return true;
+
+	uint32 elapsed;
+	if (!gump->BenchmarkDisplayList(cameras, iterations, elapsed)) {
+		debugPrintf("The game map has not been painted yet\n");
+		return true;
+	}
+	uint32 frames = iterations * cameras.size();
+	debugPrintf("Built and sorted %u display lists in %u ms, %u.%03u ms per frame\n",
+				frames, elapsed, elapsed / frames, (elapsed * 1000 / frames) % 1000);
+	return true;
+}
+
 
 bool Debugger::cmdProcessTypes(int argc, const char **argv) {
 	Kernel::get_instance()->processTypes();
@@ -2082,6 +2082,12 @@ bool Actor::loadData(Common::ReadStream *rs, uint32 version) {
 	_actorFlags = rs->readUint32LE();
 	_unkByte = rs->readByte();
 
+	// The item was added to the map before the kneeling flag was known
+	if (_actorFlags & ACT_KNEELING) {
+		_cachedShapeInfo = nullptr;
+		updateMapEntry(_x, _y);
+	}
+
 	if (GAME_IS_CRUSADER) {
 		_defaultActivity[0] = rs->readUint16LE();
 		_defaultActivity[1] = rs->readUint16LE();
@@ -137,13 +137,17 @@ public:
 	}
 	void setActorFlag(uint32 mask) {
 		_actorFlags |= mask;
-		if (mask & ACT_KNEELING)
+		if (mask & ACT_KNEELING) {
 			_cachedShapeInfo = nullptr;
+			updateMapEntry(_x, _y);
+		}
 	}
 	void clearActorFlag(uint32 mask) {
 		_actorFlags &= ~mask;
-		if (mask & ACT_KNEELING)
+		if (mask & ACT_KNEELING) {
 			_cachedShapeInfo = nullptr;
+			updateMapEntry(_x, _y);
+		}
 	}
 
 	void setCombatTactic(int no) {
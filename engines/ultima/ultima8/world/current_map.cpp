@@ -82,6 +82,7 @@ void CurrentMap::clear() {
 			for (auto *item : _items[i][j])
 				delete item;
 			_items[i][j].clear();
+			_chunkItems[i][j].clear();
 		}
 		memset(_fast[i], false, sizeof(uint32)*MAP_NUM_CHUNKS / 32);
 	}
@@ -147,6 +148,7 @@ void CurrentMap::writeback() {
 				}
 			}
 			_items[i][j].clear();
+			_chunkItems[i][j].clear();
 		}
 	}
 
@@ -251,6 +253,10 @@ void CurrentMap::addItem(Item *item) {
 	_items[cx][cy].push_front(item);
 	item->setExtFlag(Item::EXT_INCURMAP);
 
+	ChunkItem entry;
+	entry.set(item);
+	_chunkItems[cx][cy].insert_at(0, entry);
+
 	Egg *egg = dynamic_cast<Egg *>(item);
 	if (egg) {
 		EggHatcherProcess *ehp = dynamic_cast<EggHatcherProcess *>(Kernel::get_instance()->getProcess(_eggHatcher));
@@ -286,6 +292,10 @@ void CurrentMap::addItemToEnd(Item *item) {
 	_items[cx][cy].push_back(item);
 	item->setExtFlag(Item::EXT_INCURMAP);
 
+	ChunkItem entry;
+	entry.set(item);
+	_chunkItems[cx][cy].push_back(entry);
+
 	Egg *egg = dynamic_cast<Egg *>(item);
 	if (egg) {
 		EggHatcherProcess *ehp = dynamic_cast<EggHatcherProcess *>(Kernel::get_instance()->getProcess(_eggHatcher));
@@ -396,6 +406,59 @@ void CurrentMap::removeItemFromList(Item *item, int32 oldx, int32 oldy) {
 
 	_items[cx][cy].remove(item);
 	item->clearExtFlag(Item::EXT_INCURMAP);
+
+	Common::Array<ChunkItem> &entries = _chunkItems[cx][cy];
+	for (uint i = entries.size(); i-- > 0; ) {
+		if (entries[i]._item == item)
+			entries.remove_at(i);
+	}
+}
+
+void CurrentMap::ChunkItem::set(Item *item) {
+	Point3 pt = item->getLocation();
+	_x = pt.x;
+	_y = pt.y;
+	_z = pt.z;
+
+	const ShapeInfo *si = item->getShapeInfo();
+	if (si) {
+		si->getFootpadWorld(_xd, _yd, _zd, item->getFlags() & Item::FLG_FLIPPED);
+		_shapeFlags = si->_flags;
+	} else {
+		_xd = _yd = _zd = 0;
+		_shapeFlags = 0;
+	}
+
+	_objId = item->getObjId();
+	_sprite = item->hasExtFlags(Item::EXT_SPRITE);
+	_item = item;
+}
+
+CurrentMap::ChunkItem *CurrentMap::findChunkItem(const Item *item, int32 cx, int32 cy) {
+	if (cx < 0 || cy < 0 || cx >= MAP_NUM_CHUNKS || cy >= MAP_NUM_CHUNKS)
+		return nullptr;
+
+	for (auto &entry : _chunkItems[cx][cy]) {
+		if (entry._item == item)
+			return &entry;
+	}
+	return nullptr;
+}
+
+void CurrentMap::updateItem(Item *item, int32 oldx, int32 oldy) {
+	// The item is still listed in the chunk it was in before the change,
+	// unless it was moved with setLocation and then moved back.
+	ChunkItem *entry = nullptr;
+	if (oldx >= 0 && oldy >= 0)
+		entry = findChunkItem(item, oldx / _mapChunkSize, oldy / _mapChunkSize);
+	if (!entry) {
+		Point3 pt = item->getLocation();
+		if (pt.x >= 0 && pt.y >= 0)
+			entry = findChunkItem(item, pt.x / _mapChunkSize, pt.y / _mapChunkSize);
+	}
+
+	if (entry)
+		entry->set(item);
 }
 
 // Check to see if the chunk is on the screen
@@ -579,13 +642,14 @@ void CurrentMap::areaSearch(UCList *itemlist, const uint8 *loopscript,
 	//
 	for (int cy = miny; cy <= maxy; cy++) {
 		for (int cx = minx; cx <= maxx; cx++) {
-			for (const auto *item : _items[cx][cy]) {
-				if (item->hasExtFlags(Item::EXT_SPRITE))
+			for (const auto &entry : _chunkItems[cx][cy]) {
+				if (entry._sprite)
 					continue;
 
 				// check if item is in range
-				Point3 pt = item->getLocation();
-				if (searchrange.containsXY(pt.x, pt.y)) {
+				if (searchrange.containsXY(entry._x, entry._y)) {
+					const Item *item = entry._item;
+
 					// check item against loopscript
 					if (item->checkLoopScript(loopscript, scriptsize)) {
 						assert(itemlist->getElementSize() == 2);
@@ -612,6 +676,7 @@ void CurrentMap::surfaceSearch(UCList *itemlist, const uint8 *loopscript,
 	Point3 pt = check->getLocationAbsolute();
 	check->getFootpadWorld(xd, yd, zd);
 	const Box searchrange(pt.x, pt.y, pt.z, xd, yd, zd);
+	const ObjId checkId = check->getObjId();
 
 	int minx = ((pt.x - xd) / _mapChunkSize) - 1;
 	int maxx = (pt.x / _mapChunkSize) + 1;
@@ -621,15 +686,16 @@ void CurrentMap::surfaceSearch(UCList *itemlist, const uint8 *loopscript,
 
 	for (int cy = miny; cy <= maxy; cy++) {
 		for (int cx = minx; cx <= maxx; cx++) {
-			for (const auto *item : _items[cx][cy]) {
-				if (item->getObjId() == check->getObjId())
+			for (const auto &entry : _chunkItems[cx][cy]) {
+				if (entry._objId == checkId)
 					continue;
-				if (item->hasExtFlags(Item::EXT_SPRITE))
+				if (entry._sprite)
 					continue;
 
 				// check if item is in range?
-				const Box ib = item->getWorldBox();
+				const Box ib(entry._x, entry._y, entry._z, entry._xd, entry._yd, entry._zd);
 				if (searchrange.overlapsXY(ib)) {
+					const Item *item = entry._item;
 					bool ok = false;
 
 					if (above && ib._z == (searchrange._z + searchrange._zd)) {
@@ -713,20 +779,21 @@ PositionInfo CurrentMap::getPositionInfo(const Box &target, const Box &start, ui
 
 	for (int cx = minx; cx <= maxx; cx++) {
 		for (int cy = miny; cy <= maxy; cy++) {
-			for (const auto *item : _items[cx][cy]) {
-				if (item->getObjId() == id)
+			for (const auto &entry : _chunkItems[cx][cy]) {
+				if (entry._objId == id)
 					continue;
-				if (item->hasExtFlags(Item::EXT_SPRITE))
+				if (entry._sprite)
 					continue;
 
-				const ShapeInfo *si = item->getShapeInfo();
-				if (!(si->_flags & flagmask))
+				const uint32 siflags = entry._shapeFlags;
+				if (!(siflags & flagmask))
 					continue; // not an interesting item
 
-				Box ib = item->getWorldBox();
+				const Item *item = entry._item;
+				Box ib(entry._x, entry._y, entry._z, entry._xd, entry._yd, entry._zd);
 
 				// check overlap
-				if ((si->_flags & shapeflags & blockmask) &&
+				if ((siflags & shapeflags & blockmask) &&
 					target.overlaps(ib) && !start.overlaps(ib)) {
 					// overlapping an item. Invalid position
 #if 0
@@ -739,12 +806,12 @@ PositionInfo CurrentMap::getPositionInfo(const Box &target, const Box &start, ui
 
 				if (target.overlapsXY(ib)) {
 					// check support
-					if (si->_flags & supportmask && ib._z + ib._zd > supportz && ib._z + ib._zd <= target._z) {
+					if (siflags & supportmask && ib._z + ib._zd > supportz && ib._z + ib._zd <= target._z) {
 						supportz = ib._z + ib._zd;
 					}
 
 					// check roof
-					if (si->is_roof() && ib._z < roofz && ib._z >= target._z + target._zd) {
+					if ((siflags & ShapeInfo::SI_ROOF) && ib._z < roofz && ib._z >= target._z + target._zd) {
 						info.roof = item;
 						roofz = ib._z;
 					}
@@ -753,7 +820,7 @@ PositionInfo CurrentMap::getPositionInfo(const Box &target, const Box &start, ui
 				// check bottom center
 				if (ib.isBelow(midx, midy, target._z)) {
 					// check land
-					if (si->_flags & landmask && ib._z + ib._zd > landz) {
+					if (siflags & landmask && ib._z + ib._zd > landz) {
 						info.land = item;
 						landz = ib._z + ib._zd;
 					}
@@ -824,20 +891,20 @@ bool CurrentMap::scanForValidPosition(int32 x, int32 y, int32 z, const Item *ite
 
 	for (int cx = minx; cx <= maxx; cx++) {
 		for (int cy = miny; cy <= maxy; cy++) {
-			for (const auto *citem : _items[cx][cy]) {
-				if (citem->getObjId() == item->getObjId())
+			for (const auto &entry : _chunkItems[cx][cy]) {
+				if (entry._objId == item->getObjId())
 					continue;
-				if (citem->hasExtFlags(Item::EXT_SPRITE))
+				if (entry._sprite)
 					continue;
 
-				const ShapeInfo *si = citem->getShapeInfo();
 				//!! need to check is_sea() and is_land() maybe?
-				if (!(si->_flags & blockflagmask))
+				if (!(entry._shapeFlags & blockflagmask))
 					continue; // not an interesting item
 
-				int32 ixd, iyd, izd;
-				Point3 pt = citem->getLocation();
-				citem->getFootpadWorld(ixd, iyd, izd);
+				const Point3 pt(entry._x, entry._y, entry._z);
+				const int32 ixd = entry._xd;
+				const int32 iyd = entry._yd;
+				const int32 izd = entry._zd;
 
 				int minv = pt.z - z - zd + 1;
 				int maxv = pt.z + izd - z - 1;
@@ -876,7 +943,7 @@ bool CurrentMap::scanForValidPosition(int32 x, int32 y, int32 z, const Item *ite
 					for (int i = minh; i <= maxh; ++i)
 						validmask[j + scansize] &= ~(1 << (i + scansize));
 
-				if (wantsupport && si->is_solid() &&
+				if (wantsupport && (entry._shapeFlags & ShapeInfo::SI_SOLID) &&
 				        pt.z + izd >= z - scansize && pt.z + izd <= z + scansize) {
 					for (int i = minh; i <= maxh; ++i)
 						supportmask[pt.z + izd - z + scansize] |= (1 << (i + scansize));
@@ -1007,13 +1074,13 @@ bool CurrentMap::sweepTest(const Point3 &start, const Point3 &end,
 
 	for (int cx = minx; cx <= maxx; cx++) {
 		for (int cy = miny; cy <= maxy; cy++) {
-			for (const auto *other_item : _items[cx][cy]) {
-				if (other_item->getObjId() == item)
+			for (const auto &entry : _chunkItems[cx][cy]) {
+				if (entry._objId == item)
 					continue;
-				if (other_item->hasExtFlags(Item::EXT_SPRITE))
+				if (entry._sprite)
 					continue;
 
-				uint32 othershapeflags = other_item->getShapeInfo()->_flags;
+				uint32 othershapeflags = entry._shapeFlags;
 				bool blocking = (othershapeflags & shapeflags &
 				                 blockflagmask) != 0;
 
@@ -1023,11 +1090,12 @@ bool CurrentMap::sweepTest(const Point3 &start, const Point3 &end,
 					continue;
 
 				int32 other[3], oext[3];
-				Point3 opt = other_item->getLocation();
-				other[0] = opt.x;
-				other[1] = opt.y;
-				other[2] = opt.z;
-				other_item->getFootpadWorld(oext[0], oext[1], oext[2]);
+				other[0] = entry._x;
+				other[1] = entry._y;
+				other[2] = entry._z;
+				oext[0] = entry._xd;
+				oext[1] = entry._yd;
+				oext[2] = entry._zd;
 
 				// If the objects overlapped at the start, ignore collision.
 				// The -1 and +1 portions are to still consider collisions
@@ -1168,10 +1236,10 @@ bool CurrentMap::sweepTest(const Point3 &start, const Point3 &end,
 					}
 
 					// Now add it
-					hit->insert(sw_it, SweepItem(other_item->getObjId(), first, last, touch, touch_floor, blocking, dirs));
+					hit->insert(sw_it, SweepItem(entry._objId, first, last, touch, touch_floor, blocking, dirs));
 
 					//debugC(kDebugCollision, "Hit item %u (%d, %d, %d) at first: %d, last: %d",
-					//	   other_item->getObjId(), other[0], other[1], other[2], first, last);
+					//	   entry._objId, other[0], other[1], other[2], first, last);
 					//debugC(kDebugCollision, "hit item time (%d-%d) (%d-%d) (%d-%d)",
 					//	u_0[0], u_1[0], u_0[1], u_1[1], u_0[2], u_1[2]);
 					//debugC(kDebugCollision, "touch: %d, floor: %d, block: %d", touch, touch_floor, blocking);
@@ -22,6 +22,7 @@
 #ifndef ULTIMA8_WORLD_CURRENTMAP_H
 #define ULTIMA8_WORLD_CURRENTMAP_H
 
+#include "common/array.h"
 #include "common/list.h"
 #include "ultima/ultima8/misc/common_types.h"
 #include "ultima/ultima8/misc/direction.h"
@@ -74,6 +75,12 @@ public:
 	void removeItemFromList(Item *item, int32 oldx, int32 oldy);
 	void removeItem(Item *item);
 
+	//! Refresh the collision box kept for an item after its location,
+	//! shape or flags changed without it leaving the map.
+	//! \param oldx x coordinate of the item before the change
+	//! \param oldy y coordinate of the item before the change
+	void updateItem(Item *item, int32 oldx, int32 oldy);
+
 	//! Add an item to the list of possible targets (in Crusader)
 	void addTargetItem(const Item *item);
 	//! Remove an item from the list of possible targets (in Crusader)
@@ -206,6 +213,26 @@ private:
 	// items[x][y]
 	Common::List<Item *> _items[MAP_NUM_CHUNKS][MAP_NUM_CHUNKS];
 
+	//! World box, shape flags and id of an item, as used by the collision
+	//! and search functions. These are kept in arrays in the same order as
+	//! the item lists, so that the items of a chunk can be tested without
+	//! touching the items themselves.
+	struct ChunkItem {
+		int32 _x, _y, _z;
+		int32 _xd, _yd, _zd;
+		uint32 _shapeFlags;
+		ObjId _objId;
+		bool _sprite;
+		Item *_item;
+
+		void set(Item *item);
+	};
+
+	Common::Array<ChunkItem> _chunkItems[MAP_NUM_CHUNKS][MAP_NUM_CHUNKS];
+
+	//! find the entry of an item in the given chunk, or nullptr
+	ChunkItem *findChunkItem(const Item *item, int32 cx, int32 cy);
+
 	ProcId _eggHatcher;
 
 	// Fast area bit masks -> fast[ry][rx/32]&(1<<(rx&31));
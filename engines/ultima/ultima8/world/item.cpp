@@ -147,15 +147,25 @@ const Item *Item::getTopItem() const {
 }
 
 void Item::setLocation(int32 X, int32 Y, int32 Z) {
+	const int32 oldx = _x;
+	const int32 oldy = _y;
 	_x = X;
 	_y = Y;
 	_z = Z;
+	updateMapEntry(oldx, oldy);
 }
 
 void Item::setLocation(const Point3 &pt) {
-	_x = pt.x;
-	_y = pt.y;
-	_z = pt.z;
+	setLocation(pt.x, pt.y, pt.z);
+}
+
+void Item::updateMapEntry(int32 oldx, int32 oldy) {
+	if (!(_extendedFlags & EXT_INCURMAP))
+		return;
+
+	World *world = World::get_instance();
+	if (world && world->getCurrentMap())
+		world->getCurrentMap()->updateItem(this, oldx, oldy);
 }
 
 void Item::move(const Point3 &pt) {
@@ -224,6 +234,9 @@ void Item::move(int32 X, int32 Y, int32 Z) {
 			map->addItemToEnd(this);
 		else
 			map->addItem(this);
+	} else {
+		// Still in the same chunk, only the box needs updating
+		map->updateItem(this, X, Y);
 	}
 
 	// Call just moved
@@ -503,6 +516,8 @@ void Item::setShape(uint32 shape) {
 		_shape = shape;
 		_cachedShapeInfo = nullptr;
 	}
+
+	updateMapEntry(_x, _y);
 }
 
 bool Item::overlaps(const Item &item2) const {
@@ -3018,7 +3033,7 @@ uint32 Item::I_andStatus(const uint8 *args, unsigned int argsize) {
 	ARG_UINT16(mask);
 	if (!item) return 0;
 
-	item->_flags &= mask;
+	item->clearFlag(~mask);
 	return 0;
 }
 
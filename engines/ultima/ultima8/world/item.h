@@ -153,6 +153,8 @@ public:
 	//! Set the flags set in the given mask.
 	void setFlag(uint32 mask) {
 		_flags |= mask;
+		if (mask & FLG_FLIPPED)
+			updateMapEntry(_x, _y);
 	}
 
 	virtual void setFlagRecursively(uint32 mask) {
@@ -162,11 +164,16 @@ public:
 	//! Clear the flags set in the given mask.
 	void clearFlag(uint32 mask) {
 		_flags &= ~mask;
+		if (mask & FLG_FLIPPED)
+			updateMapEntry(_x, _y);
 	}
 
 	//! Set _extendedFlags
 	void setExtFlags(uint32 f) {
+		const uint32 changed = _extendedFlags ^ f;
 		_extendedFlags = f;
+		if (changed & EXT_SPRITE)
+			updateMapEntry(_x, _y);
 	}
 
 	//! Get _extendedFlags
@@ -182,11 +189,15 @@ public:
 	//! Set the _extendedFlags set in the given mask.
 	void setExtFlag(uint32 mask) {
 		_extendedFlags |= mask;
+		if (mask & EXT_SPRITE)
+			updateMapEntry(_x, _y);
 	}
 
 	//! Clear the _extendedFlags set in the given mask.
 	void clearExtFlag(uint32 mask) {
 		_extendedFlags &= ~mask;
+		if (mask & EXT_SPRITE)
+			updateMapEntry(_x, _y);
 	}
 
 	//! Get this Item's shape number
@@ -656,6 +667,10 @@ protected:
 	//! and the type of object this is.
 	int scaleReceivedDamageCru(int damage, uint16 type) const;
 
+	//! Refresh the collision box the CurrentMap keeps for this item, if it
+	//! is in the map. (oldx, oldy) is the location before the change.
+	void updateMapEntry(int32 oldx, int32 oldy);
+
 private:
 
 	//! Call a Usecode Event. Use the separate functions instead!
@@ -45,31 +45,44 @@ namespace Ultima8 {
 static const uint32 TRANSPARENT_COLOR = TEX32_PACK_RGBA(0x7F, 0x00, 0x00, 0x7F);
 static const uint32 HIGHLIGHT_COLOR = TEX32_PACK_RGBA(0xFF, 0xFF, 0x00, 0x1F);
 
+static const uint32 ITEM_BLOCK_SIZE = 256;
+static const int32 BIN_SIZE = 64;
+
 ItemSorter::ItemSorter(int capacity) :
-	_shapes(nullptr), _clipWindow(0, 0, 0, 0), _items(nullptr), _itemsTail(nullptr),
-	_itemsUnused(nullptr), _painted(nullptr), _camSx(0), _camSy(0),
-	_sortLimit(0), _sortLimitChanged(false) {
-	int i = capacity;
-	while (i--) {
-		SortItem *next = _itemsUnused;
-		_itemsUnused = new SortItem();
-		_itemsUnused->_next = next;
-	}
+	_shapes(nullptr), _clipWindow(0, 0, 0, 0), _itemCount(0), _binCols(0), _binRows(0),
+	_items(nullptr), _itemsTail(nullptr), _itemsLinked(true), _painted(nullptr),
+	_camSx(0), _camSy(0), _sortLimit(0), _sortLimitChanged(false) {
+	for (int i = 0; i < capacity; i += ITEM_BLOCK_SIZE)
+		_itemBlocks.push_back(new SortItem[ITEM_BLOCK_SIZE]);
 }
 
 ItemSorter::~ItemSorter() {
-	if (_itemsTail) {
-		_itemsTail->_next = _itemsUnused;
-		_itemsUnused = _items;
-	}
-	_items = nullptr;
-	_itemsTail = nullptr;
+	for (auto *block : _itemBlocks)
+		delete[] block;
+}
 
-	while (_itemsUnused) {
-		SortItem *next = _itemsUnused->_next;
-		delete _itemsUnused;
-		_itemsUnused = next;
-	}
+SortItem *ItemSorter::GetItem(uint32 index) const {
+	return &_itemBlocks[index / ITEM_BLOCK_SIZE][index % ITEM_BLOCK_SIZE];
+}
+
+// Display list order. Items which compare equal stay in the order they were added.
+bool ItemSorter::ListLessThan(uint32 index1, uint32 index2) const {
+	const SortItem *si1 = GetItem(index1);
+	const SortItem *si2 = GetItem(index2);
+	if (si1->listLessThan(*si2))
+		return true;
+	if (si2->listLessThan(*si1))
+		return false;
+	return index1 < index2;
+}
+
+// Bins touched by a screenspace rect. Rects reaching outside the clip window
+// are clamped to the edge bins, so overlaps outside of it are still found.
+void ItemSorter::GetBinRange(const Common::Rect32 &r, int32 &col1, int32 &row1, int32 &col2, int32 &row2) const {
+	col1 = CLIP<int32>((r.left - _clipWindow.left) / BIN_SIZE, 0, _binCols - 1);
+	row1 = CLIP<int32>((r.top - _clipWindow.top) / BIN_SIZE, 0, _binRows - 1);
+	col2 = CLIP<int32>((r.right - 1 - _clipWindow.left) / BIN_SIZE, 0, _binCols - 1);
+	row2 = CLIP<int32>((r.bottom - 1 - _clipWindow.top) / BIN_SIZE, 0, _binRows - 1);
 }
 
 void ItemSorter::BeginDisplayList(const Common::Rect32 &clipWindow, const Point3 &cam) {
@@ -79,15 +92,18 @@ void ItemSorter::BeginDisplayList(const Common::Rect32 &clipWindow, const Point3
 	// Set the clip window, and reset the item list
 	_clipWindow = clipWindow;
 
-	if (_itemsTail) {
-		_itemsTail->_next = _itemsUnused;
-		_itemsUnused = _items;
-	}
-
+	_itemCount = 0;
 	_items = nullptr;
 	_itemsTail = nullptr;
+	_itemsLinked = true;
 	_painted = nullptr;
 
+	_binCols = MAX<int32>(1, (clipWindow.width() + BIN_SIZE - 1) / BIN_SIZE);
+	_binRows = MAX<int32>(1, (clipWindow.height() + BIN_SIZE - 1) / BIN_SIZE);
+	_bins.resize(_binCols * _binRows);
+	for (auto &bin : _bins)
+		bin.clear();
+
 	// Screenspace bounding box bottom x coord (RNB x coord)
 	int32 camSx = (cam.x - cam.y) / 4;
 	// Screenspace bounding box bottom extent  (RNB y coord)
@@ -105,9 +121,9 @@ void ItemSorter::BeginDisplayList(const Common::Rect32 &clipWindow, const Point3
 void ItemSorter::AddItem(const Point3 &pt, uint32 shapeNum, uint32 frame_num, uint32 flags, uint32 ext_flags, uint16 itemNum) {
 
 	// First thing, get a SortItem to use (first of unused)
-	if (!_itemsUnused)
-		_itemsUnused = new SortItem();
-	SortItem *si = _itemsUnused;
+	if (_itemCount == _itemBlocks.size() * ITEM_BLOCK_SIZE)
+		_itemBlocks.push_back(new SortItem[ITEM_BLOCK_SIZE]);
+	SortItem *si = GetItem(_itemCount);
 
 	si->_itemNum = itemNum;
 	si->_shape = _shapes->getShape(shapeNum);
@@ -187,15 +203,29 @@ void ItemSorter::AddItem(const Point3 &pt, uint32 shapeNum, uint32 frame_num, ui
 	// are never deleted
 	si->_depends.clear();
 
-	// Iterate the list and compare _shapes
+	// Only the items sharing a bin with us can overlap us
+	int32 col1, row1, col2, row2;
+	GetBinRange(si->_sr, col1, row1, col2, row2);
+
+	_scratch.clear();
+	for (int32 row = row1; row <= row2; row++) {
+		for (int32 col = col1; col <= col2; col++) {
+			_scratch.push_back(_bins[row * _binCols + col]);
+		}
+	}
 
-	// Ok,
-	SortItem *addpoint = nullptr;
-	for (SortItem *si2 = _items; si2 != nullptr; si2 = si2->_next) {
-		// Get the insert point... which is before the first item that has higher z than us
-		if (!addpoint && si->listLessThan(*si2))
-			addpoint = si2;
+	// Iterate them in display list order and compare _shapes, as we may stop
+	// at the first one found to occlude us
+	Common::sort(_scratch.begin(), _scratch.end(), [this](uint32 a, uint32 b) {
+		return ListLessThan(a, b);
+	});
 
+	for (uint i = 0; i < _scratch.size(); i++) {
+		// Items spanning several bins show up once per bin
+		if (i > 0 && _scratch[i] == _scratch[i - 1])
+			continue;
+
+		SortItem *si2 = GetItem(_scratch[i]);
 		if (si2->_occluded)
 			continue;
 
@@ -243,30 +273,14 @@ void ItemSorter::AddItem(const Point3 &pt, uint32 shapeNum, uint32 frame_num, ui
 		}
 	}
 
-	// Add it to the list
-	_itemsUnused = _itemsUnused->_next;
-
-	// have a position
-	//addpoint = 0;
-	if (addpoint) {
-		si->_next = addpoint;
-		si->_prev = addpoint->_prev;
-		addpoint->_prev = si;
-		if (si->_prev)
-			si->_prev->_next = si;
-		else
-			_items = si;
-	}
-	// Add it to the end of the list
-	else {
-		if (_itemsTail)
-			_itemsTail->_next = si;
-		if (!_items)
-			_items = si;
-		si->_next = nullptr;
-		si->_prev = _itemsTail;
-		_itemsTail = si;
+	// Add it to the list, and to the bins it touches
+	uint32 index = _itemCount++;
+	for (int32 row = row1; row <= row2; row++) {
+		for (int32 col = col1; col <= col2; col++) {
+			_bins[row * _binCols + col].push_back(index);
+		}
 	}
+	_itemsLinked = false;
 }
 
 void ItemSorter::AddItem(const Item *add) {
@@ -274,7 +288,35 @@ void ItemSorter::AddItem(const Item *add) {
 			add->getFlags(), add->getExtFlags(), add->getObjId());
 }
 
+void ItemSorter::LinkDisplayList() {
+	if (_itemsLinked)
+		return;
+
+	_scratch.resize(_itemCount);
+	for (uint32 i = 0; i < _itemCount; i++)
+		_scratch[i] = i;
+	Common::sort(_scratch.begin(), _scratch.end(), [this](uint32 a, uint32 b) {
+		return ListLessThan(a, b);
+	});
+
+	_items = nullptr;
+	_itemsTail = nullptr;
+	for (uint32 i = 0; i < _itemCount; i++) {
+		SortItem *si = GetItem(_scratch[i]);
+		si->_prev = _itemsTail;
+		si->_next = nullptr;
+		if (_itemsTail)
+			_itemsTail->_next = si;
+		else
+			_items = si;
+		_itemsTail = si;
+	}
+	_itemsLinked = true;
+}
+
 void ItemSorter::PaintDisplayList(RenderSurface *surf, bool item_highlight, bool showFootpads, int gridlines) {
+	LinkDisplayList();
+
 	if (_sortLimit) {
 		// Clear the surface when debugging the sorter
 		uint32 color = TEX32_PACK_RGB(0, 0, 0);
@@ -537,20 +579,24 @@ bool ItemSorter::PaintSortItem(RenderSurface *surf, SortItem *si, bool showFootp
 	return false;
 }
 
+void ItemSorter::SortDisplayList() {
+	LinkDisplayList();
+
+	_painted = nullptr;
+	for (SortItem *it = _items; it != nullptr; it = it->_next) {
+		if (it->_order == -1)
+			if (PaintSortItem(nullptr, it, false, 0))
+				break;
+	}
+}
+
 uint16 ItemSorter::Trace(int32 x, int32 y, HitFace *face, bool item_highlight) {
 	SortItem *it;
 	SortItem *selected;
 
+	LinkDisplayList();
 	if (!_painted) { // If no painted item found, we need to sort the items
-		it = _items;
-		_painted = nullptr;
-		while (it != nullptr) {
-			if (it->_order == -1)
-				if (PaintSortItem(nullptr, it, false, 0))
-					break;
-
-			it = it->_next;
-		}
+		SortDisplayList();
 	}
 
 	// Firstly, we check for highlighted _items
@@ -22,6 +22,7 @@
 #ifndef ULTIMA8_WORLD_ITEMSORTER_H
 #define ULTIMA8_WORLD_ITEMSORTER_H
 
+#include "common/array.h"
 #include "common/rect.h"
 
 namespace Ultima {
@@ -37,9 +38,21 @@ class ItemSorter {
 	MainShapeArchive    *_shapes;
 	Common::Rect32      _clipWindow;
 
+	// SortItems are allocated in blocks, and reused from one frame to the next.
+	// The first _itemCount items are the display list, in the order they were added.
+	Common::Array<SortItem *> _itemBlocks;
+	uint32      _itemCount;
+
+	// Screenspace grid over the clip window. Each bin holds the indices of the
+	// items whose shape rect touches it, so only items sharing a bin are compared.
+	Common::Array<Common::Array<uint32> > _bins;
+	int32       _binCols, _binRows;
+	Common::Array<uint32> _scratch;
+
+	// The display list linked in paint order, built once all items were added
 	SortItem    *_items;
 	SortItem    *_itemsTail;
-	SortItem    *_itemsUnused;
+	bool        _itemsLinked;
 	SortItem    *_painted;
 
 	int32       _camSx, _camSy;
@@ -63,6 +76,9 @@ public:
 	// Finishes the display list and Paints
 	void PaintDisplayList(RenderSurface *surf, bool item_highlight = false, bool showFootpads = false, int gridlines = 0);
 
+	// Finishes the display list and works out the paint order, without painting
+	void SortDisplayList();
+
 	// Trace and find an object. Returns objid.
 	// If face is non-NULL, also return the face of the 3d bbox (x,y) is on
 	uint16 Trace(int32 x, int32 y, HitFace *face = 0, bool item_highlight = false);
@@ -70,6 +86,10 @@ public:
 	void IncSortLimit(int count);
 
 private:
+	SortItem *GetItem(uint32 index) const;
+	bool ListLessThan(uint32 index1, uint32 index2) const;
+	void GetBinRange(const Common::Rect32 &r, int32 &col1, int32 &row1, int32 &col2, int32 &row2) const;
+	void LinkDisplayList();
 	bool PaintSortItem(RenderSurface *surf, SortItem *si, bool showFootpad, int gridlines);
 };
 
@@ -35,11 +35,15 @@
 #include "engines/wintermute/base/base_sprite.h"
 #include "engines/util.h"
 
+#include "engines/wintermute/wintermute.h"
+
 #include "common/system.h"
 #include "common/queue.h"
 #include "common/config-manager.h"
 
 #define DIRTY_RECT_LIMIT 800
+// Past this, all dirty rects are merged into one
+#define DIRTY_RECT_MAX_COUNT 16
 
 namespace Wintermute {
 
@@ -50,13 +54,12 @@ BaseRenderer *makeOSystemRenderer(BaseGame *inGame) {
 //////////////////////////////////////////////////////////////////////////
 BaseRenderOSystem::BaseRenderOSystem(BaseGame *inGame) : BaseRenderer(inGame) {
 	_renderSurface = new Graphics::ManagedSurface();
-	_lastFrameIter = _renderQueue.end();
+	_lastFrameIndex = -1;
 	_needsFlip = true;
 	_skipThisFrame = false;
 
 	_borderLeft = _borderRight = _borderTop = _borderBottom = 0;
 	_ratioX = _ratioY = 1.0f;
-	_dirtyRect = nullptr;
 	_disableDirtyRects = false;
 	if (ConfMan.hasKey("dirty_rects")) {
 		_disableDirtyRects = !ConfMan.getBool("dirty_rects");
@@ -67,14 +70,7 @@ BaseRenderOSystem::BaseRenderOSystem(BaseGame *inGame) : BaseRenderer(inGame) {
 
 //////////////////////////////////////////////////////////////////////////
 BaseRenderOSystem::~BaseRenderOSystem() {
-	RenderQueueIterator it = _renderQueue.begin();
-	while (it != _renderQueue.end()) {
-		RenderTicket *ticket = *it;
-		it = _renderQueue.erase(it);
-		delete ticket;
-	}
-
-	delete _dirtyRect;
+	clearRenderQueue();
 
 	_renderSurface->free();
 	delete _renderSurface;
@@ -148,16 +144,14 @@ bool BaseRenderOSystem::forcedFlip() {
 bool BaseRenderOSystem::flip() {
 	if (_skipThisFrame) {
 		_skipThisFrame = false;
-		delete _dirtyRect;
-		_dirtyRect = nullptr;
+		_dirtyRects.clear();
 		g_system->updateScreen();
 		_needsFlip = false;
 
 		// Reset ticketing state
-		_lastFrameIter = _renderQueue.end();
-		RenderQueueIterator it;
-		for (it = _renderQueue.begin(); it != _renderQueue.end(); ++it) {
-			(*it)->_wantsDraw = false;
+		_lastFrameIndex = -1;
+		for (uint i = 0; i < _renderQueue.size(); i++) {
+			_renderQueue[i]->_wantsDraw = false;
 		}
 
 		addDirtyRect(_renderRect);
@@ -167,17 +161,17 @@ bool BaseRenderOSystem::flip() {
 		drawTickets();
 	} else {
 		// Clear the scale-buffered tickets that wasn't reused.
-		RenderQueueIterator it = _renderQueue.begin();
-		while (it != _renderQueue.end()) {
-			if ((*it)->_wantsDraw == false) {
-				RenderTicket *ticket = *it;
-				it = _renderQueue.erase(it);
-				delete ticket;
+		uint kept = 0;
+		for (uint i = 0; i < _renderQueue.size(); i++) {
+			RenderTicket *ticket = _renderQueue[i];
+			if (ticket->_wantsDraw == false) {
+				deleteTicket(ticket);
 			} else {
-				(*it)->_wantsDraw = false;
-				++it;
+				ticket->_wantsDraw = false;
+				_renderQueue[kept++] = ticket;
 			}
 		}
+		_renderQueue.resize(kept);
 	}
 
 	int oldScreenChangeID = _lastScreenChangeID;
@@ -188,11 +182,13 @@ bool BaseRenderOSystem::flip() {
 		if (_disableDirtyRects || screenChanged) {
 			g_system->copyRectToScreen(_renderSurface->getPixels(), _renderSurface->pitch, 0, 0, _renderSurface->w, _renderSurface->h);
 		}
-		delete _dirtyRect;
-		_dirtyRect = nullptr;
+		// drawTickets() has already replaced the drawn rects with the ones
+		// of the removed tickets
+		if (_disableDirtyRects)
+			_dirtyRects.clear();
 		_needsFlip = false;
 	}
-	_lastFrameIter = _renderQueue.end();
+	_lastFrameIndex = -1;
 
 	g_system->updateScreen();
 
@@ -258,7 +254,7 @@ Graphics::PixelFormat BaseRenderOSystem::getPixelFormat() const {
 void BaseRenderOSystem::drawSurface(BaseSurfaceOSystem *owner, const Graphics::Surface *surf,
                                     Common::Rect *srcRect, Common::Rect *dstRect, Graphics::TransformStruct &transform) {
 	if (_disableDirtyRects) {
-		RenderTicket *ticket = new RenderTicket(owner, surf, srcRect, dstRect, transform);
+		RenderTicket *ticket = createTicket(owner, surf, srcRect, dstRect, transform);
 		ticket->_wantsDraw = true;
 		_renderQueue.push_back(ticket);
 		drawFromSurface(ticket);
@@ -272,25 +268,19 @@ void BaseRenderOSystem::drawSurface(BaseSurfaceOSystem *owner, const Graphics::S
 
 	if (owner) { // Fade-tickets are owner-less
 		RenderTicket compare(owner, nullptr, srcRect, dstRect, transform);
-		RenderQueueIterator it = _lastFrameIter;
-		++it;
-		// Avoid calling end() and operator* every time, when potentially going through
-		// LOTS of tickets.
-		RenderQueueIterator endIterator = _renderQueue.end();
-		RenderTicket *compareTicket = nullptr;
-		for (; it != endIterator; ++it) {
-			compareTicket = *it;
+		for (uint i = _lastFrameIndex + 1; i < _renderQueue.size(); i++) {
+			RenderTicket *compareTicket = _renderQueue[i];
 			if (*(compareTicket) == compare && compareTicket->_isValid) {
 				if (_disableDirtyRects) {
 					drawFromSurface(compareTicket);
 				} else {
-					drawFromQueuedTicket(it);
+					drawFromQueuedTicket(i);
 				}
 				return;
 			}
 		}
 	}
-	RenderTicket *ticket = new RenderTicket(owner, surf, srcRect, dstRect, transform);
+	RenderTicket *ticket = createTicket(owner, surf, srcRect, dstRect, transform);
 	if (!_disableDirtyRects) {
 		drawFromTicket(ticket);
 	} else {
@@ -307,10 +297,9 @@ void BaseRenderOSystem::invalidateTicket(RenderTicket *renderTicket) {
 }
 
 void BaseRenderOSystem::invalidateTicketsFromSurface(BaseSurfaceOSystem *surf) {
-	RenderQueueIterator it;
-	for (it = _renderQueue.begin(); it != _renderQueue.end(); ++it) {
-		if ((*it)->_owner == surf) {
-			invalidateTicket(*it);
+	for (uint i = 0; i < _renderQueue.size(); i++) {
+		if (_renderQueue[i]->_owner == surf) {
+			invalidateTicket(_renderQueue[i]);
 		}
 	}
 }
@@ -318,97 +307,143 @@ void BaseRenderOSystem::invalidateTicketsFromSurface(BaseSurfaceOSystem *surf) {
 void BaseRenderOSystem::drawFromTicket(RenderTicket *renderTicket) {
 	renderTicket->_wantsDraw = true;
 
-	++_lastFrameIter;
-	// In-order
-	if (_renderQueue.empty() || _lastFrameIter == _renderQueue.end()) {
-		_lastFrameIter--;
-		_renderQueue.push_back(renderTicket);
-		++_lastFrameIter;
-		addDirtyRect(renderTicket->_dstRect);
-	} else {
-		// Before something
-		RenderQueueIterator pos = _lastFrameIter;
-		_renderQueue.insert(pos, renderTicket);
-		--_lastFrameIter;
-		addDirtyRect(renderTicket->_dstRect);
-	}
+	// Goes right after the last ticket drawn this frame, which is the end
+	// of the queue when drawing in-order
+	_lastFrameIndex++;
+	_renderQueue.insert_at(_lastFrameIndex, renderTicket);
+	addDirtyRect(renderTicket->_dstRect);
 }
 
-void BaseRenderOSystem::drawFromQueuedTicket(const RenderQueueIterator &ticket) {
-	RenderTicket *renderTicket = *ticket;
+void BaseRenderOSystem::drawFromQueuedTicket(uint index) {
+	RenderTicket *renderTicket = _renderQueue[index];
 	assert(!renderTicket->_wantsDraw);
 	renderTicket->_wantsDraw = true;
 
-	++_lastFrameIter;
 	// Not in the same order?
-	if (*_lastFrameIter != renderTicket) {
-		--_lastFrameIter;
-		// Remove the ticket from the list
-		assert(*_lastFrameIter != renderTicket);
-		_renderQueue.erase(ticket);
+	if ((int)index != _lastFrameIndex + 1) {
+		// Remove the ticket from the queue
+		_renderQueue.remove_at(index);
 		// Is not in order, so readd it as if it was a new ticket
 		drawFromTicket(renderTicket);
+	} else {
+		_lastFrameIndex++;
 	}
 }
 
 void BaseRenderOSystem::addDirtyRect(const Common::Rect &rect) {
-	if (!_dirtyRect) {
-		_dirtyRect = new Common::Rect(rect);
-	} else {
-		_dirtyRect->extend(rect);
+	Common::Rect dirty(rect);
+	dirty.clip(_renderRect);
+	if (dirty.isEmpty()) {
+		return;
+	}
+
+	// Merge with the rects it overlaps, or which are close enough that redrawing
+	// their bounding box is not more work. A merged rect can grow into its
+	// neighbours, so repeat until nothing changes.
+	bool merged = true;
+	while (merged) {
+		merged = false;
+		for (uint i = 0; i < _dirtyRects.size(); i++) {
+			Common::Rect box(dirty);
+			box.extend(_dirtyRects[i]);
+			uint32 area = (uint32)dirty.width() * dirty.height() + (uint32)_dirtyRects[i].width() * _dirtyRects[i].height();
+			if (dirty.intersects(_dirtyRects[i]) || (uint32)box.width() * box.height() <= area) {
+				dirty = box;
+				_dirtyRects.remove_at(i);
+				merged = true;
+				break;
+			}
+		}
+	}
+	_dirtyRects.push_back(dirty);
+
+	if (_dirtyRects.size() > DIRTY_RECT_MAX_COUNT) {
+		for (uint i = 1; i < _dirtyRects.size(); i++) {
+			_dirtyRects[0].extend(_dirtyRects[i]);
+		}
+		_dirtyRects.resize(1);
+	}
+}
+
+int BaseRenderOSystem::findOccludingTicket(const Common::Rect &rect) const {
+	for (int i = (int)_renderQueue.size() - 1; i >= 0; i--) {
+		const RenderTicket *ticket = _renderQueue[i];
+		if (ticket->_dstRect.contains(rect) && ticket->isOpaque()) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+RenderTicket *BaseRenderOSystem::createTicket(BaseSurfaceOSystem *owner, const Graphics::Surface *surf, Common::Rect *srcRect, Common::Rect *dstRect, Graphics::TransformStruct &transform) {
+	return new (_ticketPool) RenderTicket(owner, surf, srcRect, dstRect, transform);
+}
+
+void BaseRenderOSystem::deleteTicket(RenderTicket *ticket) {
+	_ticketPool.deleteChunk(ticket);
+}
+
+void BaseRenderOSystem::clearRenderQueue() {
+	for (uint i = 0; i < _renderQueue.size(); i++) {
+		deleteTicket(_renderQueue[i]);
 	}
-	_dirtyRect->clip(_renderRect);
+	_renderQueue.clear();
+	_lastFrameIndex = -1;
 }
 
 void BaseRenderOSystem::drawTickets() {
-	RenderQueueIterator it = _renderQueue.begin();
 	// Clean out the old tickets
 	// Note: We draw invalid tickets too, otherwise we wouldn't be honoring
 	// the draw request they obviously made BEFORE becoming invalid, either way
 	// we have a copy of their data, so their invalidness won't affect us.
-	while (it != _renderQueue.end()) {
-		if ((*it)->_wantsDraw == false) {
-			RenderTicket *ticket = *it;
-			addDirtyRect((*it)->_dstRect);
-			it = _renderQueue.erase(it);
-			delete ticket;
+	uint kept = 0;
+	for (uint i = 0; i < _renderQueue.size(); i++) {
+		RenderTicket *ticket = _renderQueue[i];
+		if (ticket->_wantsDraw == false) {
+			addDirtyRect(ticket->_dstRect);
+			deleteTicket(ticket);
 		} else {
-			++it;
+			_renderQueue[kept++] = ticket;
 		}
 	}
-	if (!_dirtyRect || _dirtyRect->width() == 0 || _dirtyRect->height() == 0) {
-		it = _renderQueue.begin();
-		while (it != _renderQueue.end()) {
-			RenderTicket *ticket = *it;
-			ticket->_wantsDraw = false;
-			++it;
+	_renderQueue.resize(kept);
+
+	if (_dirtyRects.empty()) {
+		for (uint i = 0; i < _renderQueue.size(); i++) {
+			_renderQueue[i]->_wantsDraw = false;
 		}
 		return;
 	}
 
-	it = _renderQueue.begin();
-	_lastFrameIter = _renderQueue.end();
-	// A special case: If the screen has one giant OPAQUE rect to be drawn, then we skip filling
-	// the background color. Typical use-case: Fullscreen FMVs.
-	// Caveat: The FPS-counter will invalidate this.
-	if (it != _lastFrameIter && _renderQueue.front() == _renderQueue.back() && (*it)->_transform._alphaDisable == true) {
-		// If our single opaque rect fills the dirty rect, we can skip filling.
-		if (*_dirtyRect != (*it)->_dstRect) {
+	_lastFrameIndex = -1;
+	_renderStats = RenderStats();
+
+	for (uint d = 0; d < _dirtyRects.size(); d++) {
+		const Common::Rect &dirtyRect = _dirtyRects[d];
+
+		// Everything below an opaque ticket covering the whole dirty rect is
+		// hidden, and there is no need to apply the clear-color either.
+		// Typical use-case: Fullscreen FMVs and room backgrounds.
+		int first = findOccludingTicket(dirtyRect);
+		if (first < 0) {
+			first = 0;
 			// Apply the clear-color to the dirty rect.
-			_renderSurface->fillRect(*_dirtyRect, _clearColor);
+			_renderSurface->fillRect(dirtyRect, _clearColor);
 		}
-		// Otherwise Do NOT fill.
-	} else {
-		// Apply the clear-color to the dirty rect.
-		_renderSurface->fillRect(*_dirtyRect, _clearColor);
-	}
-	for (; it != _renderQueue.end(); ++it) {
-		RenderTicket *ticket = *it;
-		if (ticket->_dstRect.intersects(*_dirtyRect)) {
+
+		for (uint i = 0; i < _renderQueue.size(); i++) {
+			RenderTicket *ticket = _renderQueue[i];
+			if (!ticket->_dstRect.intersects(dirtyRect)) {
+				continue;
+			}
+			if ((int)i < first) {
+				_renderStats.ticketsSkipped++;
+				continue;
+			}
 			// dstClip is the area we want redrawn.
 			Common::Rect dstClip(ticket->_dstRect);
 			// reduce it to the dirty rect
-			dstClip.clip(*_dirtyRect);
+			dstClip.clip(dirtyRect);
 			// we need to keep track of the position to redraw the dirty rect
 			Common::Rect pos(dstClip);
 			int16 offsetX = ticket->_dstRect.left;
@@ -418,25 +453,34 @@ void BaseRenderOSystem::drawTickets() {
 
 			drawFromSurface(ticket, &pos, &dstClip);
 			_needsFlip = true;
+
+			_renderStats.ticketsDrawn++;
+			_renderStats.pixelsDrawn += (uint32)pos.width() * pos.height();
 		}
-		// Some tickets want redraw but don't actually clip the dirty area (typically the ones that shouldn't become clear-color)
-		ticket->_wantsDraw = false;
+		g_system->copyRectToScreen(_renderSurface->getBasePtr(dirtyRect.left, dirtyRect.top), _renderSurface->pitch, dirtyRect.left, dirtyRect.top, dirtyRect.width(), dirtyRect.height());
 	}
-	g_system->copyRectToScreen(_renderSurface->getBasePtr(_dirtyRect->left, _dirtyRect->top), _renderSurface->pitch, _dirtyRect->left, _dirtyRect->top, _dirtyRect->width(), _dirtyRect->height());
 
-	it = _renderQueue.begin();
-	// Clean out the old tickets
-	while (it != _renderQueue.end()) {
-		if ((*it)->_isValid == false) {
-			RenderTicket *ticket = *it;
-			addDirtyRect((*it)->_dstRect);
-			it = _renderQueue.erase(it);
-			delete ticket;
+	debugC(5, kWintermuteDebugGeneral, "BaseRenderOSystem: %d dirty rects, %d tickets drawn, %d hidden, %d pixels drawn",
+	       _dirtyRects.size(), _renderStats.ticketsDrawn, _renderStats.ticketsSkipped, _renderStats.pixelsDrawn);
+
+	// Some tickets want redraw but don't actually clip the dirty area (typically the ones that shouldn't become clear-color)
+	for (uint i = 0; i < _renderQueue.size(); i++) {
+		_renderQueue[i]->_wantsDraw = false;
+	}
+
+	// Clean out the old tickets. Their area is kept dirty for the next frame.
+	_dirtyRects.clear();
+	kept = 0;
+	for (uint i = 0; i < _renderQueue.size(); i++) {
+		RenderTicket *ticket = _renderQueue[i];
+		if (ticket->_isValid == false) {
+			addDirtyRect(ticket->_dstRect);
+			deleteTicket(ticket);
 		} else {
-			++it;
+			_renderQueue[kept++] = ticket;
 		}
 	}
-
+	_renderQueue.resize(kept);
 }
 
 // Replacement for SDL2's SDL_RenderCopy
@@ -553,16 +597,10 @@ void BaseRenderOSystem::endSaveLoad() {
 	BaseRenderer::endSaveLoad();
 
 	// Clear the scale-buffered tickets as we just loaded.
-	RenderQueueIterator it = _renderQueue.begin();
-	while (it != _renderQueue.end()) {
-		RenderTicket *ticket = *it;
-		it = _renderQueue.erase(it);
-		delete ticket;
-	}
+	clearRenderQueue();
 	// HACK: After a save the buffer will be drawn before the scripts get to update it,
 	// so just skip this single frame.
 	_skipThisFrame = true;
-	_lastFrameIter = _renderQueue.end();
 
 	_renderSurface->fillRect(Common::Rect(0, 0, _renderSurface->w, _renderSurface->h), _renderSurface->format.ARGBToColor(255, 0, 0, 0));
 	g_system->fillScreen(Common::Rect(0, 0, _renderSurface->w, _renderSurface->h), _renderSurface->format.ARGBToColor(255, 0, 0, 0));
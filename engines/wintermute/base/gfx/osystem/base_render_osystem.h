@@ -29,16 +29,17 @@
 #define WINTERMUTE_BASE_RENDERER_SDL_H
 
 #include "engines/wintermute/base/gfx/base_renderer.h"
+#include "engines/wintermute/base/gfx/osystem/render_ticket.h"
 
+#include "common/array.h"
+#include "common/memorypool.h"
 #include "common/rect.h"
-#include "common/list.h"
 
 #include "graphics/managed_surface.h"
 #include "graphics/transform_struct.h"
 
 namespace Wintermute {
 class BaseSurfaceOSystem;
-class RenderTicket;
 /**
  * A 2D-renderer implementation for WME.
  * This renderer makes use of a "ticket"-system, where all draw-calls
@@ -54,6 +55,11 @@ class RenderTicket;
  * being equal, this information is then used to check whether the draw order changed,
  * which will then create a need for redrawing, as we draw with an alpha-channel here.
  *
+ * The screen areas that changed are kept as a small set of dirty rects, so that
+ * changes in distant parts of the screen don't cause everything in between to be
+ * redrawn. Within a dirty rect, the tickets below the topmost opaque ticket covering
+ * it are not drawn at all.
+ *
  * There is also a draw path that draws without tickets, for debugging purposes,
  * as well as to accommodate situations with large enough amounts of draw calls,
  * that there will be too much overhead involved with comparing the generated tickets.
@@ -63,8 +69,6 @@ public:
 	BaseRenderOSystem(BaseGame *inGame);
 	~BaseRenderOSystem() override;
 
-	typedef Common::List<RenderTicket *>::iterator RenderQueueIterator;
-
 	Common::String getName() const override;
 
 	bool initRenderer(int width, int height, bool windowed) override;
@@ -93,9 +97,9 @@ public:
 	/**
 	 * Re-insert an existing ticket into the queue, adding a dirty rect
 	 * out-of-order from last draw from the ticket.
-	 * @param ticket iterator pointing to the ticket to be added.
+	 * @param index position of the ticket in the queue.
 	 */
-	void drawFromQueuedTicket(const RenderQueueIterator &ticket);
+	void drawFromQueuedTicket(uint index);
 
 	bool setViewport(int left, int top, int right, int bottom) override;
 	bool setViewport(Common::Rect32 *rect) override { return BaseRenderer::setViewport(rect); }
@@ -120,6 +124,12 @@ private:
 	 * @param rect the region to be marked as dirty
 	 */
 	void addDirtyRect(const Common::Rect &rect);
+	/**
+	 * Find the topmost ticket which hides everything below it in the rect
+	 * @param rect the region to be checked
+	 * @return queue index of the ticket, or -1 if there is none
+	 */
+	int findOccludingTicket(const Common::Rect &rect) const;
 	/**
 	 * Traverse the tickets that are dirty, and draw them
 	 */
@@ -128,11 +138,25 @@ private:
 	void drawFromSurface(RenderTicket *ticket);
 	// Dirty-rects:
 	void drawFromSurface(RenderTicket *ticket, Common::Rect *dstRect, Common::Rect *clipRect);
-	Common::Rect *_dirtyRect;
-	Common::List<RenderTicket *> _renderQueue;
+	RenderTicket *createTicket(BaseSurfaceOSystem *owner, const Graphics::Surface *surf, Common::Rect *srcRect, Common::Rect *dstRect, Graphics::TransformStruct &transform);
+	void deleteTicket(RenderTicket *ticket);
+	void clearRenderQueue();
+
+	struct RenderStats {
+		uint32 ticketsDrawn;   ///< Tickets redrawn into the dirty rects
+		uint32 ticketsSkipped; ///< Tickets hidden behind an opaque ticket
+		uint32 pixelsDrawn;    ///< Screen pixels written by the redrawn tickets
+
+		RenderStats() : ticketsDrawn(0), ticketsSkipped(0), pixelsDrawn(0) {}
+	};
+
+	Common::Array<Common::Rect> _dirtyRects;
+	Common::Array<RenderTicket *> _renderQueue;
+	Common::ObjectPool<RenderTicket> _ticketPool;
+	RenderStats _renderStats;
 
 	bool _needsFlip;
-	RenderQueueIterator _lastFrameIter;
+	int _lastFrameIndex; // queue index of the last ticket drawn this frame
 	Common::Rect _renderRect;
 	Graphics::ManagedSurface *_renderSurface;
 
@@ -91,6 +91,28 @@ bool RenderTicket::operator==(const RenderTicket &t) const {
 	return true;
 }
 
+bool RenderTicket::isOpaque() const {
+	if (_transform._blendMode != Graphics::BLEND_NORMAL || (_transform._rgbaMod & 0xff) != 0xff) {
+		return false;
+	}
+	// Fade tickets fill their whole rect
+	if (!getSurface()) {
+		return true;
+	}
+	// Tiled, rotated or otherwise resized surfaces might not cover the rect
+	if (_transform._numTimesX * _transform._numTimesY != 1 ||
+		getSurface()->w != _dstRect.width() || getSurface()->h != _dstRect.height()) {
+		return false;
+	}
+	if (!_owner) {
+		return false;
+	}
+	if (_transform._alphaDisable) {
+		return true;
+	}
+	return _transform._angle == Graphics::kDefaultAngle && _owner->getAlphaType() == Graphics::ALPHA_OPAQUE;
+}
+
 // Replacement for SDL2's SDL_RenderCopy
 void RenderTicket::drawToSurface(Graphics::ManagedSurface *_targetSurface) const {
 	if (!getSurface()) {
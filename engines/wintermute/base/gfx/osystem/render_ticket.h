@@ -68,6 +68,10 @@ public:
 
 	BaseSurfaceOSystem *_owner;
 	bool operator==(const RenderTicket &a) const;
+	/**
+	 * Whether drawing the ticket overwrites every pixel of its destination rect
+	 */
+	bool isOpaque() const;
 	const Common::Rect *getSrcRect() const { return &_srcRect; }
 private:
 	Graphics::Surface *_surface;
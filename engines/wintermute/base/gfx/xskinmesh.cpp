@@ -383,72 +383,35 @@ bool DXSkinInfo::create(uint32 vertexCount, uint32 fvf, uint32 boneCount) {
 void DXSkinInfo::destroy() {
 	delete[] _bones;
 	_bones = nullptr;
+	_skinReady = false;
 }
 
 bool DXSkinInfo::updateSkinnedMesh(const DXMatrix *boneTransforms, void *srcVertices, void *dstVertices) {
 	uint32 vertexSize = DXGetFVFVertexSize(_fvf);
 	uint32 normalOffset = sizeof(DXVector3);
+	bool hasNormals = (_fvf & DXFVF_NORMAL) != 0;
 	uint32 i, j;
 
-	for (i = 0; i < _numVertices; i++) {
-		DXVector3 *position = (DXVector3 *)((byte *)dstVertices + vertexSize * i);
-		position->_x = 0.0f;
-		position->_y = 0.0f;
-		position->_z = 0.0f;
-	}
-
-	for (i = 0; i < _numBones; i++) {
-		DXMatrix boneMatrix = boneTransforms[i];
-
-		for (j = 0; j < _bones[i]._numInfluences; j++) {
-			DXVector3 position;
-			DXVector3 *positionSrc = (DXVector3 *)((byte *)srcVertices + vertexSize * _bones[i]._vertices[j]);
-			DXVector3 *positionDst = (DXVector3 *)((byte *)dstVertices + vertexSize * _bones[i]._vertices[j]);
-			float weight = _bones[i]._weights[j];
-
-			DXVec3TransformCoord(&position, positionSrc, &boneMatrix);
-
-			positionDst->_x += weight * position._x;
-			positionDst->_y += weight * position._y;
-			positionDst->_z += weight * position._z;
-		}
-	}
-
-	if (_fvf & DXFVF_NORMAL) {
-		for (i = 0; i < _numVertices; i++) {
-			DXVector3 *normal = (DXVector3 *)((byte *)dstVertices + vertexSize * i + normalOffset);
-			normal->_x = 0.0f;
-			normal->_y = 0.0f;
-			normal->_z = 0.0f;
-		}
-
+	if (!_skinReady) {
+		_skin.setVertices((const float *)srcVertices, hasNormals ? (const float *)((byte *)srcVertices + normalOffset) : nullptr, _numVertices, vertexSize);
 		for (i = 0; i < _numBones; i++) {
-			DXMatrix boneInverse = boneTransforms[i];
-			DXMatrixInverse(&boneInverse, NULL, &boneInverse);
-			DXMatrixTranspose(&boneInverse, &boneInverse);
-
 			for (j = 0; j < _bones[i]._numInfluences; j++) {
-				DXVector3 normal;
-				DXVector3 *normalSrc = (DXVector3 *)((byte *)srcVertices + vertexSize * _bones[i]._vertices[j] + normalOffset);
-				DXVector3 *normalDst = (DXVector3 *)((byte *)dstVertices + vertexSize * _bones[i]._vertices[j] + normalOffset);
-				float weight = _bones[i]._weights[j];
-
-				DXVec3TransformNormal(&normal, normalSrc, &boneInverse);
-
-				normalDst->_x += weight * normal._x;
-				normalDst->_y += weight * normal._y;
-				normalDst->_z += weight * normal._z;
+				_skin.addInfluence(_bones[i]._vertices[j], i, _bones[i]._weights[j]);
 			}
 		}
+		_skin.finalize();
+		_skinMatrices.resize(_numBones);
+		_skinReady = true;
+	}
 
-		for (i = 0; i < _numVertices; i++) {
-			DXVector3 *normalDest = (DXVector3 *)((byte *)dstVertices + (i * vertexSize) + normalOffset);
-			if ((normalDest->_x != 0.0f) && (normalDest->_y != 0.0f) && (normalDest->_z != 0.0f)) {
-				DXVec3Normalize(normalDest, normalDest);
-			}
-		}
+	// DXMatrix transforms row vectors, Math::Matrix4 column vectors
+	for (i = 0; i < _numBones; i++) {
+		_skinMatrices[i].setData(boneTransforms[i]._m4x4);
+		_skinMatrices[i].transpose();
 	}
 
+	_skin.skin(_skinMatrices.data(), _numBones, (float *)dstVertices, hasNormals ? (float *)((byte *)dstVertices + normalOffset) : nullptr, vertexSize, true);
+
 	return true;
 }
 
@@ -490,6 +453,7 @@ bool DXSkinInfo::setBoneInfluence(uint32 boneIdx, uint32 numInfluences, const ui
 	}
 	bone = &_bones[boneIdx];
 	bone->_numInfluences = numInfluences;
+	_skinReady = false;
 	delete[] bone->_vertices;
 	delete[] bone->_weights;
 	bone->_vertices = newVertices;
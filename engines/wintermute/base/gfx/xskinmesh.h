@@ -37,6 +37,8 @@
 #include "engines/wintermute/base/gfx/xfile_loader.h"
 #include "engines/wintermute/base/gfx/xmath.h"
 
+#include "math/skinning.h"
+
 namespace Wintermute {
 
 #define DXFVF_XYZ             0x0002
@@ -109,6 +111,10 @@ class DXSkinInfo {
 	uint32 _numVertices{};
 	uint32 _numBones{};
 	DXBone *_bones{};
+	// Built on first use, from the influences and the source vertices
+	Math::SkinnedMesh _skin;
+	Common::Array<Math::Matrix4> _skinMatrices;
+	bool _skinReady{};
 
 public:
 	~DXSkinInfo() { destroy(); }
@@ -400,30 +400,40 @@ int IVIPlaneDesc::checkImageSize(unsigned int w, unsigned int h, int log_offset)
 
 /*------------------------------------------------------------------------*/
 
-AVFrame::AVFrame() {
+AVFrame::AVFrame() : _width(0), _height(0) {
 	Common::fill(&_data[0], &_data[AV_NUM_DATA_POINTERS], (uint8 *)nullptr);
 	Common::fill(&_linesize[0], &_linesize[AV_NUM_DATA_POINTERS], 0);
 }
 
 int AVFrame::setDimensions(uint16 width, uint16 height) {
+	if (width != _width || height != _height)
+		freeFrame();
+
 	_width = width;
 	_height = height;
-	_linesize[0] = _linesize[1] = _linesize[2] = width;
+	_linesize[0] = width;
+	// The YUV 4:1:0 conversion interpolates each chroma sample with its right
+	// and bottom neighbours, so keep an extra neutral column and row
+	_linesize[1] = _linesize[2] = ((width + 3) >> 2) + 1;
 
 	return 0;
 }
 
 int AVFrame::getBuffer(int flags) {
-	freeFrame();
+	// The planes are fully rewritten by every frame, so keep them
+	// for as long as the dimensions don't change
+	if (_data[0])
+		return 0;
 
 	// Luminance channel
 	_data[0] = (uint8 *)calloc(_width * _height, 1);
 
-	// UV Chroma Channels
-	_data[1] = (uint8 *)malloc(_width * _height);
-	_data[2] = (uint8 *)malloc(_width * _height);
-	Common::fill(_data[1], _data[1] + _width * _height, 0x80);
-	Common::fill(_data[2], _data[2] + _width * _height, 0x80);
+	// UV Chroma Channels, subsampled 4:1 in both directions
+	int uvSize = _linesize[1] * (((_height + 3) >> 2) + 1);
+	_data[1] = (uint8 *)malloc(uvSize);
+	_data[2] = (uint8 *)malloc(uvSize);
+	Common::fill(_data[1], _data[1] + uvSize, 0x80);
+	Common::fill(_data[2], _data[2] + uvSize, 0x80);
 
 	return 0;
 }
@@ -489,8 +499,7 @@ IndeoDecoderBase::~IndeoDecoderBase() {
 
 int IndeoDecoderBase::decodeIndeoFrame() {
 	int result;
-	AVFrame frameData;
-	AVFrame *frame = &frameData;
+	AVFrame *frame = _ctx._pFrame;
 
 	if (!_surface) {
 		_surface = new Graphics::Surface;
@@ -576,7 +585,7 @@ int IndeoDecoderBase::decodeIndeoFrame() {
 	// Merge the planes into the final surface
 	YUVToRGBMan.convert410(_surface, Graphics::YUVToRGBManager::kScaleITU,
 		frame->_data[0], frame->_data[1], frame->_data[2], frame->_width, frame->_height,
-		frame->_width, frame->_width);
+		frame->_linesize[0], frame->_linesize[1]);
 
 	if (_ctx._hasTransp)
 		decodeTransparency();
@@ -604,9 +613,6 @@ int IndeoDecoderBase::decodeIndeoFrame() {
 		}
 	}
 
-	// Free the now un-needed frame data
-	frame->freeFrame();
-
 	return 0;
 }
 
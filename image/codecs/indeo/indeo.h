@@ -354,7 +354,8 @@ struct AVFrame {
 	int setDimensions(uint16 width, uint16 height);
 
 	/**
-	 * Get a buffer for a frame
+	 * Get a buffer for a frame, reusing the current one if the dimensions
+	 * haven't changed
 	 */
 	int getBuffer(int flags);
 
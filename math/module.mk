@@ -20,9 +20,19 @@ MODULE_OBJS := \
 	rect2d.o \
 	sinetables.o \
 	sinewindows.o \
+	skinning.o \
 	vector2d.o \
 	vector3d.o \
 	vector4d.o
 
+ifdef SCUMMVM_NEON
+MODULE_OBJS += \
+	skinning_neon.o
+endif
+ifdef SCUMMVM_SSE2
+MODULE_OBJS += \
+	skinning_sse2.o
+endif
+
 # Include common rules
 include $(srcdir)/rules.mk
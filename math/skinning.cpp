@@ -0,0 +1,303 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/algorithm.h"
+#include "common/hashmap.h"
+#include "common/system.h"
+
+#include "math/skinning.h"
+
+namespace Math {
+
+SkinnedMesh::SkinFunc SkinnedMesh::skinFunc = nullptr;
+
+namespace {
+
+struct InfluenceLess {
+	template<class T>
+	bool operator()(const T &a, const T &b) const {
+		if (a.vertex != b.vertex)
+			return a.vertex < b.vertex;
+		if (a.bone != b.bone)
+			return a.bone < b.bone;
+		return a.weight < b.weight;
+	}
+};
+
+} // end of anonymous namespace
+
+SkinnedMesh::SkinnedMesh() : _hasNormals(false) {
+}
+
+void SkinnedMesh::setVertices(const float *positions, const float *normals, uint count, uint stride) {
+	_srcPositions.resize(count * 3);
+	_srcNormals.resize(normals ? count * 3 : 0);
+	_srcInfluences.clear();
+	_hasNormals = normals != nullptr;
+
+	for (uint i = 0; i < count; i++) {
+		const float *p = (const float *)((const byte *)positions + i * stride);
+		_srcPositions[i * 3 + 0] = p[0];
+		_srcPositions[i * 3 + 1] = p[1];
+		_srcPositions[i * 3 + 2] = p[2];
+		if (normals) {
+			const float *n = (const float *)((const byte *)normals + i * stride);
+			_srcNormals[i * 3 + 0] = n[0];
+			_srcNormals[i * 3 + 1] = n[1];
+			_srcNormals[i * 3 + 2] = n[2];
+		}
+	}
+}
+
+void SkinnedMesh::addInfluence(uint vertex, uint bone, float weight) {
+	assert(vertex < _srcPositions.size() / 3);
+	assert(bone <= 0xffff);
+
+	Influence influence;
+	influence.vertex = vertex;
+	influence.bone = bone;
+	influence.weight = weight;
+	_srcInfluences.push_back(influence);
+}
+
+bool SkinnedMesh::isSameVertex(uint a, uint b) const {
+	// Only called on vertices whose influences were found equal
+	for (uint i = 0; i < 3; i++) {
+		if (_srcPositions[a * 3 + i] != _srcPositions[b * 3 + i])
+			return false;
+		if (_hasNormals && _srcNormals[a * 3 + i] != _srcNormals[b * 3 + i])
+			return false;
+	}
+	return true;
+}
+
+void SkinnedMesh::finalize() {
+	uint count = _srcPositions.size() / 3;
+
+	Common::sort(_srcInfluences.begin(), _srcInfluences.end(), InfluenceLess());
+
+	// Influence range of each source vertex
+	Common::Array<uint32> start;
+	start.resize(count + 1);
+	uint32 next = 0;
+	for (uint v = 0; v <= count; v++) {
+		while (next < _srcInfluences.size() && _srcInfluences[next].vertex < v)
+			next++;
+		start[v] = next;
+	}
+
+	// Identical vertices are looked up by hashing their bind pose and influences
+	Common::HashMap<uint32, Common::Array<uint> > buckets;
+	_remap.resize(count);
+	_x.clear(); _y.clear(); _z.clear();
+	_nx.clear(); _ny.clear(); _nz.clear();
+	_influenceStart.clear();
+	_bones.clear();
+	_weights.clear();
+
+	Common::Array<uint> uniqueSource;
+	for (uint v = 0; v < count; v++) {
+		uint32 hash = start[v + 1] - start[v];
+		for (uint i = 0; i < 3; i++) {
+			uint32 bits;
+			memcpy(&bits, &_srcPositions[v * 3 + i], sizeof(bits));
+			hash = hash * 31 + bits;
+		}
+		for (uint32 k = start[v]; k < start[v + 1]; k++) {
+			hash = hash * 31 + _srcInfluences[k].bone;
+		}
+
+		Common::Array<uint> &bucket = buckets[hash];
+		int found = -1;
+		for (uint i = 0; i < bucket.size() && found < 0; i++) {
+			uint other = uniqueSource[bucket[i]];
+			if (start[other + 1] - start[other] != start[v + 1] - start[v] || !isSameVertex(v, other))
+				continue;
+			bool same = true;
+			for (uint32 k = 0; k < start[v + 1] - start[v] && same; k++) {
+				same = _srcInfluences[start[v] + k].bone == _srcInfluences[start[other] + k].bone &&
+				       _srcInfluences[start[v] + k].weight == _srcInfluences[start[other] + k].weight;
+			}
+			if (same)
+				found = bucket[i];
+		}
+		if (found >= 0) {
+			_remap[v] = found;
+			continue;
+		}
+
+		_remap[v] = uniqueSource.size();
+		bucket.push_back(uniqueSource.size());
+		uniqueSource.push_back(v);
+
+		_x.push_back(_srcPositions[v * 3 + 0]);
+		_y.push_back(_srcPositions[v * 3 + 1]);
+		_z.push_back(_srcPositions[v * 3 + 2]);
+		if (_hasNormals) {
+			_nx.push_back(_srcNormals[v * 3 + 0]);
+			_ny.push_back(_srcNormals[v * 3 + 1]);
+			_nz.push_back(_srcNormals[v * 3 + 2]);
+		}
+		_influenceStart.push_back(_bones.size());
+		for (uint32 k = start[v]; k < start[v + 1]; k++) {
+			_bones.push_back(_srcInfluences[k].bone);
+			_weights.push_back(_srcInfluences[k].weight);
+		}
+	}
+	_influenceStart.push_back(_bones.size());
+	_skinned.resize(_x.size() * 8);
+
+	_srcPositions.clear();
+	_srcNormals.clear();
+	_srcInfluences.clear();
+}
+
+void SkinnedMesh::update(const Matrix4 *bones, uint count, bool inverseTransposeNormals) {
+	// Columns of the matrices, with the fourth row left out
+	_palette.resize(count * 16);
+	_normalPalette.resize(count * 12);
+	for (uint b = 0; b < count; b++) {
+		float *m = &_palette[b * 16];
+		for (int c = 0; c < 4; c++) {
+			for (int r = 0; r < 3; r++)
+				m[c * 4 + r] = bones[b].getValue(r, c);
+			m[c * 4 + 3] = 0.0f;
+		}
+
+		if (!_hasNormals)
+			continue;
+
+		Matrix4 normalMatrix = bones[b];
+		if (inverseTransposeNormals) {
+			normalMatrix.inverse();
+			normalMatrix.transpose();
+		}
+		float *n = &_normalPalette[b * 12];
+		for (int c = 0; c < 3; c++) {
+			for (int r = 0; r < 3; r++)
+				n[c * 4 + r] = normalMatrix.getValue(r, c);
+			n[c * 4 + 3] = 0.0f;
+		}
+	}
+}
+
+void SkinnedMesh::skinRange(uint begin, uint end) {
+	assert(begin <= end && end <= _x.size());
+	if (begin == end)
+		return;
+
+	// If no function has been selected yet, detect and select
+	if (!skinFunc) {
+		skinFunc = skinGeneric;
+#ifdef SCUMMVM_NEON
+		if (g_system->hasFeature(OSystem::kFeatureCpuNEON))
+			skinFunc = skinNEON;
+#endif
+#ifdef SCUMMVM_SSE2
+		if (g_system->hasFeature(OSystem::kFeatureCpuSSE2))
+			skinFunc = skinSSE2;
+#endif
+	}
+
+	Args args;
+	args.x = &_x[0];
+	args.y = &_y[0];
+	args.z = &_z[0];
+	args.nx = _hasNormals ? &_nx[0] : nullptr;
+	args.ny = _hasNormals ? &_ny[0] : nullptr;
+	args.nz = _hasNormals ? &_nz[0] : nullptr;
+	args.influenceStart = &_influenceStart[0];
+	args.bones = _bones.empty() ? nullptr : &_bones[0];
+	args.weights = _weights.empty() ? nullptr : &_weights[0];
+	args.palette = _palette.empty() ? nullptr : &_palette[0];
+	args.normalPalette = _normalPalette.empty() ? nullptr : &_normalPalette[0];
+	args.out = &_skinned[0];
+	args.begin = begin;
+	args.end = end;
+	skinFunc(args);
+
+	if (!_hasNormals)
+		return;
+
+	for (uint v = begin; v < end; v++) {
+		float *n = &_skinned[v * 8 + 4];
+		float length = sqrtf(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+		if (length > 0.0f) {
+			n[0] /= length;
+			n[1] /= length;
+			n[2] /= length;
+		}
+	}
+}
+
+void SkinnedMesh::write(float *positions, float *normals, uint stride) const {
+	for (uint i = 0; i < _remap.size(); i++) {
+		const float *src = &_skinned[_remap[i] * 8];
+		float *p = (float *)((byte *)positions + i * stride);
+		p[0] = src[0];
+		p[1] = src[1];
+		p[2] = src[2];
+		if (normals && _hasNormals) {
+			float *n = (float *)((byte *)normals + i * stride);
+			n[0] = src[4];
+			n[1] = src[5];
+			n[2] = src[6];
+		}
+	}
+}
+
+void SkinnedMesh::skin(const Matrix4 *bones, uint count, float *positions, float *normals, uint stride, bool inverseTransposeNormals) {
+	update(bones, count, inverseTransposeNormals);
+	skinRange(0, _x.size());
+	write(positions, normals, stride);
+}
+
+void SkinnedMesh::skinGeneric(const Args &args) {
+	for (uint v = args.begin; v < args.end; v++) {
+		float p[3] = { 0.0f, 0.0f, 0.0f };
+		float n[3] = { 0.0f, 0.0f, 0.0f };
+
+		for (uint32 k = args.influenceStart[v]; k < args.influenceStart[v + 1]; k++) {
+			const float *m = args.palette + args.bones[k] * 16;
+			const float w = args.weights[k];
+			for (int r = 0; r < 3; r++)
+				p[r] += w * (m[r] * args.x[v] + m[4 + r] * args.y[v] + m[8 + r] * args.z[v] + m[12 + r]);
+
+			if (args.nx) {
+				const float *nm = args.normalPalette + args.bones[k] * 12;
+				for (int r = 0; r < 3; r++)
+					n[r] += w * (nm[r] * args.nx[v] + nm[4 + r] * args.ny[v] + nm[8 + r] * args.nz[v]);
+			}
+		}
+
+		float *out = args.out + v * 8;
+		out[0] = p[0];
+		out[1] = p[1];
+		out[2] = p[2];
+		out[3] = 0.0f;
+		out[4] = n[0];
+		out[5] = n[1];
+		out[6] = n[2];
+		out[7] = 0.0f;
+	}
+}
+
+} // end of namespace Math
@@ -0,0 +1,142 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef MATH_SKINNING_H
+#define MATH_SKINNING_H
+
+#include "common/array.h"
+
+#include "math/matrix4.h"
+
+namespace Math {
+
+/**
+ * Linear blend skinning of a mesh on the CPU.
+ *
+ * The mesh is set up once with its bind pose vertices and the bone influences
+ * on each of them. Vertices sharing the same position, normal and influences,
+ * which is common along texture seams, are merged so that they are skinned
+ * only once. The remaining vertices are stored as structure-of-arrays, with
+ * the influences of each vertex packed next to each other.
+ *
+ * Each frame, update() builds the bone palette, skinRange() transforms a range
+ * of the merged vertices, and write() copies the results out to every vertex.
+ * skin() does all three for the whole mesh. Ranges are independent of each
+ * other, so the work can be split up by the caller.
+ */
+class SkinnedMesh {
+public:
+	/** Arguments of a skinning kernel */
+	struct Args {
+		const float *x, *y, *z;          ///< Bind pose positions
+		const float *nx, *ny, *nz;       ///< Bind pose normals, or nullptr
+		const uint32 *influenceStart;    ///< First influence of each vertex, plus one past the last
+		const uint16 *bones;             ///< Bone of each influence
+		const float *weights;            ///< Weight of each influence
+		const float *palette;            ///< Position matrices, 16 floats per bone
+		const float *normalPalette;      ///< Normal matrices, 12 floats per bone
+		float *out;                      ///< 8 floats per vertex: position, 0, normal, 0
+		uint begin, end;                 ///< Range of vertices to process
+	};
+	typedef void (*SkinFunc)(const Args &);
+
+	SkinnedMesh();
+
+	/**
+	 * Set the bind pose vertices, dropping all previous vertices and influences.
+	 * @param positions  x, y and z of the first vertex
+	 * @param normals    x, y and z of the first normal, or nullptr
+	 * @param count      number of vertices
+	 * @param stride     distance in bytes between two vertices
+	 */
+	void setVertices(const float *positions, const float *normals, uint count, uint stride);
+	/** Add the influence of a bone on a vertex */
+	void addInfluence(uint vertex, uint bone, float weight);
+	/** Merge the vertices and pack the influences. Must be called after the last influence was added. */
+	void finalize();
+
+	/** Number of vertices given to setVertices() */
+	uint getVertexCount() const { return _remap.size(); }
+	/** Number of vertices left after merging the identical ones */
+	uint getUniqueVertexCount() const { return _x.size(); }
+
+	/**
+	 * Set the current pose.
+	 * @param bones  matrices from the bind pose to the current pose, one per bone
+	 * @param count  number of matrices
+	 * @param inverseTransposeNormals  transform the normals by the inverse transpose of
+	 *                                 the matrices, instead of their rotation part
+	 */
+	void update(const Matrix4 *bones, uint count, bool inverseTransposeNormals = false);
+	/** Skin the merged vertices begin to end - 1 */
+	void skinRange(uint begin, uint end);
+	/**
+	 * Write the skinned vertices.
+	 * @param positions  where to write x, y and z of the first vertex
+	 * @param normals    where to write x, y and z of the first normal, or nullptr.
+	 *                   The normals are normalized.
+	 * @param stride     distance in bytes between two vertices
+	 */
+	void write(float *positions, float *normals, uint stride) const;
+	/** Skin and write the whole mesh */
+	void skin(const Matrix4 *bones, uint count, float *positions, float *normals, uint stride, bool inverseTransposeNormals = false);
+
+	static SkinFunc skinFunc;
+	static void skinGeneric(const Args &args);
+#ifdef SCUMMVM_NEON
+	static void skinNEON(const Args &args);
+#endif
+#ifdef SCUMMVM_SSE2
+	static void skinSSE2(const Args &args);
+#endif
+
+private:
+	struct Influence {
+		uint vertex;
+		uint bone;
+		float weight;
+	};
+
+	bool isSameVertex(uint a, uint b) const;
+
+	// Input, before finalize()
+	Common::Array<float> _srcPositions;
+	Common::Array<float> _srcNormals;
+	Common::Array<Influence> _srcInfluences;
+
+	// Merged vertices
+	Common::Array<float> _x, _y, _z;
+	Common::Array<float> _nx, _ny, _nz;
+	Common::Array<uint32> _influenceStart;
+	Common::Array<uint16> _bones;
+	Common::Array<float> _weights;
+	Common::Array<uint> _remap;
+	bool _hasNormals;
+
+	// Per frame data
+	Common::Array<float> _palette;
+	Common::Array<float> _normalPalette;
+	Common::Array<float> _skinned;
+};
+
+} // end of namespace Math
+
+#endif
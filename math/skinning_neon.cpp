@@ -0,0 +1,94 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+// Without this ifdef the iOS backend breaks
+#ifdef SCUMMVM_NEON
+
+#include "math/skinning.h"
+
+#include <arm_neon.h>
+
+#if !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("neon"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("fpu=neon")
+#endif
+
+#endif // !defined(__aarch64__) && !defined(__ARM_NEON)
+
+namespace Math {
+
+// One vertex per iteration, with the x, y and z of the matrix columns in the
+// lanes of a register. The fourth lane stays zero.
+template<bool normals>
+static void skinVerticesNEON(const SkinnedMesh::Args &args) {
+	for (uint v = args.begin; v < args.end; v++) {
+		const float x = args.x[v];
+		const float y = args.y[v];
+		const float z = args.z[v];
+		float32x4_t p = vdupq_n_f32(0.0f);
+		float32x4_t n = vdupq_n_f32(0.0f);
+
+		for (uint32 k = args.influenceStart[v]; k < args.influenceStart[v + 1]; k++) {
+			const float *m = args.palette + args.bones[k] * 16;
+			const float w = args.weights[k];
+			float32x4_t t = vaddq_f32(vmulq_n_f32(vld1q_f32(m), x), vmulq_n_f32(vld1q_f32(m + 4), y));
+			t = vaddq_f32(vaddq_f32(t, vmulq_n_f32(vld1q_f32(m + 8), z)), vld1q_f32(m + 12));
+			p = vaddq_f32(p, vmulq_n_f32(t, w));
+
+			if (normals) {
+				const float *nm = args.normalPalette + args.bones[k] * 12;
+				float32x4_t u = vaddq_f32(vmulq_n_f32(vld1q_f32(nm), args.nx[v]), vmulq_n_f32(vld1q_f32(nm + 4), args.ny[v]));
+				u = vaddq_f32(u, vmulq_n_f32(vld1q_f32(nm + 8), args.nz[v]));
+				n = vaddq_f32(n, vmulq_n_f32(u, w));
+			}
+		}
+
+		vst1q_f32(args.out + v * 8, p);
+		vst1q_f32(args.out + v * 8 + 4, n);
+	}
+}
+
+void SkinnedMesh::skinNEON(const Args &args) {
+	if (args.nx)
+		skinVerticesNEON<true>(args);
+	else
+		skinVerticesNEON<false>(args);
+}
+
+} // End of namespace Math
+
+#if !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#endif // SCUMMVM_NEON
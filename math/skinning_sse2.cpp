@@ -0,0 +1,89 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#include "math/skinning.h"
+
+#include <emmintrin.h>
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("sse2"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("sse2")
+#endif
+
+#endif // !defined(__x86_64__)
+
+namespace Math {
+
+// One vertex per iteration, with the x, y and z of the matrix columns in the
+// lanes of a register. The fourth lane stays zero.
+template<bool normals>
+static void skinVerticesSSE2(const SkinnedMesh::Args &args) {
+	for (uint v = args.begin; v < args.end; v++) {
+		const __m128 x = _mm_set1_ps(args.x[v]);
+		const __m128 y = _mm_set1_ps(args.y[v]);
+		const __m128 z = _mm_set1_ps(args.z[v]);
+		__m128 p = _mm_setzero_ps();
+		__m128 n = _mm_setzero_ps();
+
+		for (uint32 k = args.influenceStart[v]; k < args.influenceStart[v + 1]; k++) {
+			const float *m = args.palette + args.bones[k] * 16;
+			const __m128 w = _mm_set1_ps(args.weights[k]);
+			__m128 t = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(m), x), _mm_mul_ps(_mm_loadu_ps(m + 4), y));
+			t = _mm_add_ps(_mm_add_ps(t, _mm_mul_ps(_mm_loadu_ps(m + 8), z)), _mm_loadu_ps(m + 12));
+			p = _mm_add_ps(p, _mm_mul_ps(w, t));
+
+			if (normals) {
+				const float *nm = args.normalPalette + args.bones[k] * 12;
+				__m128 u = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(nm), _mm_set1_ps(args.nx[v])), _mm_mul_ps(_mm_loadu_ps(nm + 4), _mm_set1_ps(args.ny[v])));
+				u = _mm_add_ps(u, _mm_mul_ps(_mm_loadu_ps(nm + 8), _mm_set1_ps(args.nz[v])));
+				n = _mm_add_ps(n, _mm_mul_ps(w, u));
+			}
+		}
+
+		_mm_storeu_ps(args.out + v * 8, p);
+		_mm_storeu_ps(args.out + v * 8 + 4, n);
+	}
+}
+
+void SkinnedMesh::skinSSE2(const Args &args) {
+	if (args.nx)
+		skinVerticesSSE2<true>(args);
+	else
+		skinVerticesSSE2<false>(args);
+}
+
+} // End of namespace Math
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__x86_64__)
@@ -4,6 +4,8 @@
 
 #include "helper.h"
 
+#include "../system/null_osystem.h"
+
 class AudioStreamTestSuite : public CxxTest::TestSuite
 {
 public:
@@ -205,4 +207,71 @@ public:
 	void test_sub_looping_audio_stream_stereo_22050_end_fixed_iter() {
 		testSubLoopingAudioStreamFixedIter(22050, true, 2, 2);
 	}
+
+private:
+	void testDecodeAheadAudioStream(const int sampleRate, const bool isStereo) {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		const int secondLength = sampleRate * (isStereo ? 2 : 1);
+		const int chunkLength = 1000;
+
+		int16 *sine = 0;
+		Audio::SeekableAudioStream *s = createSineStream<int16>(sampleRate, 1, &sine, false, isStereo);
+		// There is no timer here, so the first 250ms come from the primed
+		// buffer and the rest has to be decoded from readBuffer
+		Audio::DecodeAheadAudioStream *decodeAhead = Audio::makeDecodeAheadStream(s, 250);
+
+		int16 *buffer = new int16[secondLength * 2];
+
+		// Check parameters
+		TS_ASSERT_EQUALS(decodeAhead->isStereo(), isStereo);
+		TS_ASSERT_EQUALS(decodeAhead->getRate(), sampleRate);
+		TS_ASSERT_EQUALS(decodeAhead->getLength().msecs(), 1000);
+		TS_ASSERT_EQUALS(decodeAhead->getBufferedSamples(), decodeAhead->getBufferSize());
+		TS_ASSERT_EQUALS(decodeAhead->getUnderrunCount(), (uint32)0);
+
+		// Read the whole stream in chunks
+		int read = 0;
+		while (read < secondLength) {
+			int samples = decodeAhead->readBuffer(buffer + read, chunkLength);
+			TS_ASSERT_EQUALS(samples, MIN(chunkLength, secondLength - read));
+			read += samples;
+		}
+		TS_ASSERT_EQUALS(memcmp(buffer, sine, secondLength * sizeof(int16)), 0);
+		TS_ASSERT(decodeAhead->getUnderrunCount() > 0);
+		TS_ASSERT_EQUALS(decodeAhead->readBuffer(buffer, chunkLength), 0);
+		TS_ASSERT_EQUALS(decodeAhead->endOfData(), true);
+
+		// Seek into the middle and read what is left
+		TS_ASSERT_EQUALS(decodeAhead->seek(500), true);
+		TS_ASSERT_EQUALS(decodeAhead->endOfData(), false);
+		const int half = Audio::convertTimeToStreamPos(Audio::Timestamp(500, 1000), sampleRate, isStereo).totalNumberOfFrames();
+		TS_ASSERT_EQUALS(decodeAhead->readBuffer(buffer, secondLength), secondLength - half);
+		TS_ASSERT_EQUALS(memcmp(buffer, sine + half, (secondLength - half) * sizeof(int16)), 0);
+		TS_ASSERT_EQUALS(decodeAhead->endOfData(), true);
+
+		// Loop it twice
+		Audio::AudioStream *loop = Audio::makeLoopingAudioStream(decodeAhead, 2);
+		TS_ASSERT_EQUALS(loop->readBuffer(buffer, secondLength * 2), secondLength * 2);
+		TS_ASSERT_EQUALS(memcmp(buffer, sine, secondLength * sizeof(int16)), 0);
+		TS_ASSERT_EQUALS(memcmp(buffer + secondLength, sine, secondLength * sizeof(int16)), 0);
+		TS_ASSERT_EQUALS(loop->endOfData(), true);
+
+		delete loop;
+		delete[] buffer;
+		delete[] sine;
+
+		Common::uninstall_null_g_system();
+#endif
+	}
+
+public:
+	void test_decode_ahead_audio_stream_mono_11025() {
+		testDecodeAheadAudioStream(11025, false);
+	}
+
+	void test_decode_ahead_audio_stream_stereo_22050() {
+		testDecodeAheadAudioStream(22050, true);
+	}
 };
@@ -0,0 +1,260 @@
+#include <cxxtest/TestSuite.h>
+
+#if defined(HAVE_CONFIG_H)
+#include "config.h"
+#endif
+
+#include "common/array.h"
+#include "common/debug.h"
+#include "common/system.h"
+
+#include "audio/softsynth/opl/dbopl.h"
+#include "audio/softsynth/opl/mame.h"
+#include "audio/softsynth/opl/nuked.h"
+
+#include "../system/null_osystem.h"
+
+#if NULL_OSYSTEM_IS_AVAILABLE
+#define BENCHMARK_TIME 1
+#else
+#define BENCHMARK_TIME 0
+#endif
+
+class OPLTestSuite : public CxxTest::TestSuite {
+	struct Write {
+		uint16 reg;
+		uint8 val;
+	};
+
+	// A register dump: writes followed by the number of samples to play until the next step
+	struct Step {
+		Common::Array<Write> writes;
+		uint samples;
+	};
+
+	static void addWrite(Step &step, uint16 reg, uint8 val) {
+		Write w;
+		w.reg = reg;
+		w.val = val;
+		step.writes.push_back(w);
+	}
+
+	/**
+	 * A made up tune going through most of the chip features: all the
+	 * waveforms, feedback and connections, vibrato and tremolo, key scaling,
+	 * rhythm mode and, for OPL3, the second register set and 4-op channels.
+	 */
+	static void makeDump(Common::Array<Step> &dump, bool opl3, uint rate, uint numSteps) {
+		static const uint16 fnums[8] = { 0x157, 0x16b, 0x181, 0x198, 0x1b0, 0x1ca, 0x1e5, 0x202 };
+		const uint numChannels = opl3 ? 18 : 9;
+
+		Step init;
+		addWrite(init, 0x01, 0x20);
+		if (opl3) {
+			addWrite(init, 0x105, 0x01);
+			addWrite(init, 0x104, 0x05);
+		}
+		for (uint c = 0; c < numChannels; c++) {
+			uint16 bank = c < 9 ? 0 : 0x100;
+			uint ch = c % 9;
+			uint op = ch % 3 + (ch / 3) * 8;
+			for (uint o = 0; o < 2; o++) {
+				uint16 reg = bank + op + o * 3;
+				addWrite(init, 0x20 + reg, ((c + o) & 3) << 6 | (c & 1) << 5 | (o << 4) | ((c + o * 3) & 15));
+				addWrite(init, 0x40 + reg, (c & 3) << 6 | (o ? 0x00 : (c * 5) & 0x3f));
+				addWrite(init, 0x60 + reg, (0xf0 - ((c & 7) << 4)) | ((c + o) & 15));
+				addWrite(init, 0x80 + reg, ((c * 3) & 15) << 4 | (5 + (c & 7)));
+				addWrite(init, 0xe0 + reg, (c + o) & (opl3 ? 7 : 3));
+			}
+			addWrite(init, 0xc0 + bank + ch, (opl3 ? 0x30 : 0) | (c % 8) << 1 | (c & 1));
+		}
+		addWrite(init, 0xbd, 0xc0);
+		init.samples = rate / 100;
+		dump.push_back(init);
+
+		for (uint i = 0; i < numSteps; i++) {
+			Step step;
+			for (uint c = 0; c < numChannels; c++) {
+				uint16 bank = c < 9 ? 0 : 0x100;
+				uint ch = c % 9;
+				// Each channel plays a note of its own length
+				uint length = 7 + c;
+				if (i % length == 0) {
+					uint16 fnum = fnums[(i / length + c) & 7];
+					uint block = 2 + (c + i / length) % 4;
+					addWrite(step, 0xa0 + bank + ch, fnum & 0xff);
+					addWrite(step, 0xb0 + bank + ch, 0x20 | block << 2 | fnum >> 8);
+				} else if (i % length == length / 2) {
+					addWrite(step, 0xb0 + bank + ch, 0x10);
+				}
+			}
+			// Rhythm mode on and off, with the drums hit in turn
+			if (i % 64 == 32)
+				addWrite(step, 0xbd, 0x20 | (1 << ((i / 64) % 5)));
+			else if (i % 64 == 48)
+				addWrite(step, 0xbd, 0xc0);
+			step.samples = rate / 100;
+			dump.push_back(step);
+		}
+	}
+
+	static uint dumpLength(const Common::Array<Step> &dump) {
+		uint length = 0;
+		for (uint i = 0; i < dump.size(); i++)
+			length += dump[i].samples;
+		return length;
+	}
+
+public:
+	void test_nuked_block() {
+		Common::Array<Step> dump;
+		makeDump(dump, true, 49716, 300);
+
+		OPL::NUKED::opl3_chip *ref = new OPL::NUKED::opl3_chip;
+		OPL::NUKED::opl3_chip *block = new OPL::NUKED::opl3_chip;
+		OPL::NUKED::OPL3_Reset(ref, 49716);
+		OPL::NUKED::OPL3_Reset(block, 49716);
+
+		Common::Array<int16> refOut, blockOut;
+		refOut.resize(dumpLength(dump) * 4);
+		blockOut.resize(dumpLength(dump) * 4);
+
+		uint pos = 0;
+		for (uint i = 0; i < dump.size(); i++) {
+			for (uint w = 0; w < dump[i].writes.size(); w++) {
+				OPL::NUKED::OPL3_WriteReg(ref, dump[i].writes[w].reg, dump[i].writes[w].val);
+				OPL::NUKED::OPL3_WriteReg(block, dump[i].writes[w].reg, dump[i].writes[w].val);
+			}
+			for (uint s = 0; s < dump[i].samples; s++)
+				OPL::NUKED::OPL3_Generate4Ch(ref, &refOut[(pos + s) * 4]);
+			// Vary the block sizes
+			uint done = 0;
+			while (done < dump[i].samples) {
+				uint count = MIN<uint>(dump[i].samples - done, 1 + (i * 37 + done) % 97);
+				OPL::NUKED::OPL3_Generate4ChBlock(block, &blockOut[(pos + done) * 4], count);
+				done += count;
+			}
+			pos += dump[i].samples;
+		}
+
+		uint firstDifference = refOut.size();
+		for (uint i = 0; i < refOut.size() && firstDifference == refOut.size(); i++) {
+			if (refOut[i] != blockOut[i])
+				firstDifference = i;
+		}
+		TS_ASSERT_EQUALS(firstDifference, refOut.size());
+
+		delete ref;
+		delete block;
+	}
+
+	void test_nuked_stream() {
+		Common::Array<Step> dump;
+		makeDump(dump, true, 44100, 200);
+
+		OPL::NUKED::opl3_chip *ref = new OPL::NUKED::opl3_chip;
+		OPL::NUKED::opl3_chip *stream = new OPL::NUKED::opl3_chip;
+		OPL::NUKED::OPL3_Reset(ref, 44100);
+		OPL::NUKED::OPL3_Reset(stream, 44100);
+
+		Common::Array<int16> refOut, streamOut;
+		refOut.resize(dumpLength(dump) * 2);
+		streamOut.resize(dumpLength(dump) * 2);
+
+		uint pos = 0;
+		for (uint i = 0; i < dump.size(); i++) {
+			for (uint w = 0; w < dump[i].writes.size(); w++) {
+				OPL::NUKED::OPL3_WriteRegBuffered(ref, dump[i].writes[w].reg, dump[i].writes[w].val);
+				OPL::NUKED::OPL3_WriteRegBuffered(stream, dump[i].writes[w].reg, dump[i].writes[w].val);
+			}
+			for (uint s = 0; s < dump[i].samples; s++)
+				OPL::NUKED::OPL3_GenerateResampled(ref, &refOut[(pos + s) * 2]);
+			OPL::NUKED::OPL3_GenerateStream(stream, &streamOut[pos * 2], dump[i].samples);
+			pos += dump[i].samples;
+		}
+
+		TS_ASSERT(refOut == streamOut);
+		TS_ASSERT_EQUALS(ref->samplecnt, stream->samplecnt);
+		TS_ASSERT_EQUALS(ref->writebuf_samplecnt, stream->writebuf_samplecnt);
+
+		delete ref;
+		delete stream;
+	}
+
+	void test_speed() {
+#if BENCHMARK_TIME
+		Common::install_null_g_system();
+
+		const uint rate = 44100;
+		Common::Array<Step> dump;
+#ifdef SLOW_TESTS
+		makeDump(dump, false, rate, 6000);
+#else
+		makeDump(dump, false, rate, 300);
+#endif
+		const uint length = dumpLength(dump);
+		Common::Array<int16> out;
+		out.resize(length * 2);
+
+		// Nuked, one sample at a time
+		OPL::NUKED::opl3_chip *nuked = new OPL::NUKED::opl3_chip;
+		OPL::NUKED::OPL3_Reset(nuked, rate);
+		uint32 start = g_system->getMillis();
+		for (uint i = 0, pos = 0; i < dump.size(); pos += dump[i].samples, i++) {
+			for (uint w = 0; w < dump[i].writes.size(); w++)
+				OPL::NUKED::OPL3_WriteRegBuffered(nuked, dump[i].writes[w].reg, dump[i].writes[w].val);
+			for (uint s = 0; s < dump[i].samples; s++)
+				OPL::NUKED::OPL3_GenerateResampled(nuked, &out[(pos + s) * 2]);
+		}
+		uint32 nukedSampleTime = g_system->getMillis() - start;
+
+		// Nuked, in blocks
+		OPL::NUKED::OPL3_Reset(nuked, rate);
+		start = g_system->getMillis();
+		for (uint i = 0, pos = 0; i < dump.size(); pos += dump[i].samples, i++) {
+			for (uint w = 0; w < dump[i].writes.size(); w++)
+				OPL::NUKED::OPL3_WriteRegBuffered(nuked, dump[i].writes[w].reg, dump[i].writes[w].val);
+			OPL::NUKED::OPL3_GenerateStream(nuked, &out[pos * 2], dump[i].samples);
+		}
+		uint32 nukedBlockTime = g_system->getMillis() - start;
+		delete nuked;
+
+#ifndef DISABLE_DOSBOX_OPL
+		OPL::DOSBox::DBOPL::InitTables();
+		OPL::DOSBox::DBOPL::Chip *dbopl = new OPL::DOSBox::DBOPL::Chip;
+		dbopl->Setup(rate);
+		Common::Array<int32> dboplOut;
+		dboplOut.resize(512);
+		start = g_system->getMillis();
+		for (uint i = 0; i < dump.size(); i++) {
+			for (uint w = 0; w < dump[i].writes.size(); w++)
+				dbopl->WriteReg(dump[i].writes[w].reg, dump[i].writes[w].val);
+			for (uint done = 0; done < dump[i].samples; done += 512)
+				dbopl->GenerateBlock2(MIN<uint>(dump[i].samples - done, 512), &dboplOut[0]);
+		}
+		uint32 dboplTime = g_system->getMillis() - start;
+		delete dbopl;
+#endif
+
+		OPL::MAME::FM_OPL *mame = OPL::MAME::makeAdLibOPL(rate);
+		start = g_system->getMillis();
+		for (uint i = 0, pos = 0; i < dump.size(); pos += dump[i].samples, i++) {
+			for (uint w = 0; w < dump[i].writes.size(); w++)
+				OPL::MAME::OPLWriteReg(mame, dump[i].writes[w].reg, dump[i].writes[w].val);
+			OPL::MAME::YM3812UpdateOne(mame, &out[pos], dump[i].samples);
+		}
+		uint32 mameTime = g_system->getMillis() - start;
+		OPL::MAME::OPLDestroy(mame);
+
+		debug("OPL emulators, time to play %u samples of the same OPL2 register dump (in milliseconds):", length);
+		debug("Nuked, sample by sample: %u", nukedSampleTime);
+		debug("Nuked, in blocks: %u", nukedBlockTime);
+#ifndef DISABLE_DOSBOX_OPL
+		debug("DOSBox: %u", dboplTime);
+#endif
+		debug("MAME: %u", mameTime);
+
+		Common::uninstall_null_g_system();
+#endif
+	}
+};
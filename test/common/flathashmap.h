@@ -0,0 +1,317 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/array.h"
+#include "common/debug.h"
+#include "common/flathashmap.h"
+#include "common/hash-str.h"
+#include "common/system.h"
+
+#include "../system/null_osystem.h"
+
+#if NULL_OSYSTEM_IS_AVAILABLE
+#define BENCHMARK_TIME 1
+#else
+#define BENCHMARK_TIME 0
+#endif
+
+class FlatHashMapTestSuite : public CxxTest::TestSuite
+{
+	typedef Common::FlatHashMap<Common::String, Common::String, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> FlatStringMap;
+
+	template<class Map>
+	static uint32 benchmarkInsert(Map &map, const Common::Array<Common::String> &keys, uint rounds) {
+		uint32 start = g_system->getMillis();
+		for (uint r = 0; r < rounds; r++) {
+			map.clear();
+			for (uint i = 0; i < keys.size(); i++)
+				map[keys[i]] = i;
+		}
+		return g_system->getMillis() - start;
+	}
+
+	template<class Map>
+	static uint32 benchmarkFind(const Map &map, const Common::Array<Common::String> &keys, uint rounds, uint &found) {
+		uint32 start = g_system->getMillis();
+		for (uint r = 0; r < rounds; r++) {
+			for (uint i = 0; i < keys.size(); i++)
+				found += map.contains(keys[i]) ? 1 : 0;
+		}
+		return g_system->getMillis() - start;
+	}
+
+	template<class Map>
+	static uint32 benchmarkIterate(const Map &map, uint rounds, uint &sum) {
+		uint32 start = g_system->getMillis();
+		for (uint r = 0; r < rounds; r++) {
+			for (typename Map::const_iterator i = map.begin(); i != map.end(); ++i)
+				sum += i->_value;
+		}
+		return g_system->getMillis() - start;
+	}
+
+	template<class Map>
+	static uint32 benchmarkErase(Map &map, const Common::Array<Common::String> &keys, uint rounds) {
+		uint32 start = g_system->getMillis();
+		for (uint r = 0; r < rounds; r++) {
+			// Erase every other key and put it back
+			for (uint i = r & 1; i < keys.size(); i += 2)
+				map.erase(keys[i]);
+			for (uint i = r & 1; i < keys.size(); i += 2)
+				map[keys[i]] = i;
+		}
+		return g_system->getMillis() - start;
+	}
+
+	template<class Map>
+	static void benchmark(const char *name, const Common::Array<Common::String> &keys, const Common::Array<Common::String> &missingKeys, uint rounds) {
+		Map map;
+		uint found = 0, sum = 0;
+		uint32 insertTime = benchmarkInsert(map, keys, rounds);
+		uint32 findTime = benchmarkFind(map, keys, rounds, found);
+		uint32 missTime = benchmarkFind(map, missingKeys, rounds, found);
+		uint32 iterateTime = benchmarkIterate(map, rounds, sum);
+		uint32 eraseTime = benchmarkErase(map, keys, rounds);
+		TS_ASSERT_EQUALS(found, keys.size() * rounds);
+		TS_ASSERT_EQUALS(map.size(), keys.size());
+		debug("%-12s %8u %8u %8u %8u %8u", name, insertTime, findTime, missTime, iterateTime, eraseTime);
+	}
+
+	public:
+	void test_empty_clear() {
+		Common::FlatHashMap<int, int> container;
+		TS_ASSERT(container.empty());
+		container[0] = 17;
+		container[1] = 33;
+		TS_ASSERT(!container.empty());
+		container.clear();
+		TS_ASSERT(container.empty());
+
+		FlatStringMap container2;
+		TS_ASSERT(container2.empty());
+		container2["foo"] = "bar";
+		container2["quux"] = "blub";
+		TS_ASSERT(!container2.empty());
+		container2.clear(true);
+		TS_ASSERT(container2.empty());
+	}
+
+	void test_contains() {
+		Common::FlatHashMap<int, int> container;
+		container[0] = 17;
+		container[1] = 33;
+		TS_ASSERT(container.contains(0));
+		TS_ASSERT(container.contains(1));
+		TS_ASSERT(!container.contains(17));
+		TS_ASSERT(!container.contains(-1));
+
+		FlatStringMap container2;
+		container2["foo"] = "bar";
+		container2["quux"] = "blub";
+		TS_ASSERT(container2.contains("foo"));
+		TS_ASSERT(container2.contains("QUUX"));
+		TS_ASSERT(!container2.contains("bar"));
+		TS_ASSERT(!container2.contains(Common::String("asdf")));
+	}
+
+	void test_transparent_lookup() {
+		FlatStringMap container;
+		container["foo"] = "bar";
+		container["Quux"] = "blub";
+
+		const char *key = "QUUX";
+		TS_ASSERT(container.contains(key));
+		TS_ASSERT(container.find(key) != container.end());
+		TS_ASSERT_EQUALS(container.find(key)->_value, "blub");
+		TS_ASSERT_EQUALS(container.getValOrDefault("Foo", Common::String("none")), "bar");
+		TS_ASSERT_EQUALS(container.getValOrDefault("baz", Common::String("none")), "none");
+
+		Common::String out;
+		TS_ASSERT(container.tryGetVal("foo", out));
+		TS_ASSERT_EQUALS(out, "bar");
+		TS_ASSERT(!container.tryGetVal("baz", out));
+	}
+
+	void test_add_remove() {
+		Common::FlatHashMap<int, int> container;
+		container[0] = 17;
+		container[1] = 33;
+		container[2] = 45;
+		container[3] = 12;
+		container[4] = 96;
+		TS_ASSERT(container.contains(1));
+		container.erase(1);
+		TS_ASSERT(!container.contains(1));
+		container[1] = 42;
+		TS_ASSERT(container.contains(1));
+		container.erase(0);
+		TS_ASSERT(!container.empty());
+		container.erase(1);
+		TS_ASSERT(!container.empty());
+		container.erase(2);
+		TS_ASSERT(!container.empty());
+		container.erase(3);
+		TS_ASSERT(!container.empty());
+		container.erase(4);
+		TS_ASSERT(container.empty());
+		container[1] = 33;
+		TS_ASSERT(container.contains(1));
+		TS_ASSERT(!container.empty());
+		container.erase(1);
+		TS_ASSERT(container.empty());
+	}
+
+	void test_add_remove_iterator() {
+		Common::FlatHashMap<int, int> container;
+		container[0] = 17;
+		container[1] = 33;
+		container[2] = 45;
+		container[3] = 12;
+		container[4] = 96;
+		TS_ASSERT(container.contains(1));
+		container.erase(container.find(1));
+		TS_ASSERT(!container.contains(1));
+		container[1] = 42;
+		TS_ASSERT(container.contains(1));
+		container.erase(container.find(0));
+		TS_ASSERT(!container.empty());
+		container.erase(container.find(1));
+		TS_ASSERT(!container.empty());
+		container.erase(container.find(2));
+		TS_ASSERT(!container.empty());
+		container.erase(container.find(3));
+		TS_ASSERT(!container.empty());
+		container.erase(container.find(4));
+		TS_ASSERT(container.empty());
+	}
+
+	void test_lookup_with_default() {
+		Common::FlatHashMap<int, int> container;
+		container[0] = 17;
+		container[1] = -1;
+		container[2] = 45;
+
+		// We take a const ref now to ensure that the map
+		// is not modified by getValOrDefault.
+		const Common::FlatHashMap<int, int> &containerRef = container;
+
+		TS_ASSERT_EQUALS(containerRef[1], -1);
+		TS_ASSERT_EQUALS(containerRef.getValOrDefault(0), 17);
+		TS_ASSERT_EQUALS(containerRef.getValOrDefault(17), 0);
+		TS_ASSERT_EQUALS(containerRef.getValOrDefault(0, -10), 17);
+		TS_ASSERT_EQUALS(containerRef.getValOrDefault(17, -10), -10);
+	}
+
+	void test_iterator() {
+		Common::FlatHashMap<int, int> container;
+
+		// The container is initially empty ...
+		TS_ASSERT_EQUALS(container.begin(), container.end());
+
+		container[0] = 17;
+		container[1] = 33;
+		container[2] = 45;
+		container[3] = 12;
+		container[4] = 96;
+		container.erase(1);
+		container[1] = 42;
+		container.erase(0);
+		container.erase(1);
+
+		int found = 0;
+		Common::FlatHashMap<int, int>::iterator i;
+		for (i = container.begin(); i != container.end(); ++i) {
+			int key = i->_key;
+			TS_ASSERT(key >= 0 && key <= 4);
+			TS_ASSERT(!(found & (1 << key)));
+			found |= 1 << key;
+		}
+		TS_ASSERT(found == 16+8+4);
+
+		found = 0;
+		Common::FlatHashMap<int, int>::const_iterator j;
+		for (j = container.begin(); j != container.end(); ++j) {
+			int key = j->_key;
+			TS_ASSERT(key >= 0 && key <= 4);
+			TS_ASSERT(!(found & (1 << key)));
+			found |= 1 << key;
+		}
+		TS_ASSERT(found == 16+8+4);
+
+		// ... and again empty.
+		container.clear();
+		TS_ASSERT_EQUALS(container.begin(), container.end());
+	}
+
+	void test_copy() {
+		Common::FlatHashMap<int, Common::String> map1, container2;
+		for (int i = 0; i < 100; i++)
+			map1[i] = Common::String::format("%d", i);
+		for (int i = 0; i < 100; i += 3)
+			map1.erase(i);
+
+		container2 = map1;
+		Common::FlatHashMap<int, Common::String> container3(map1);
+		TS_ASSERT_EQUALS(container2.size(), map1.size());
+		TS_ASSERT_EQUALS(container3.size(), map1.size());
+		for (int i = 0; i < 100; i++) {
+			TS_ASSERT_EQUALS(container2.contains(i), i % 3 != 0);
+			TS_ASSERT_EQUALS(container3.getValOrDefault(i), i % 3 ? Common::String::format("%d", i) : Common::String());
+		}
+	}
+
+	void test_growth_and_churn() {
+		// Enough elements to grow the table several times, with keys which
+		// only differ in their high bits
+		Common::FlatHashMap<uint, uint> container;
+		for (uint i = 0; i < 5000; i++)
+			container[i << 16] = i;
+		TS_ASSERT_EQUALS(container.size(), 5000u);
+
+		// Erase and add back elements many times, which leaves many
+		// deleted slots behind
+		for (uint round = 0; round < 20; round++) {
+			for (uint i = round % 7; i < 5000; i += 7)
+				container.erase(i << 16);
+			for (uint i = round % 7; i < 5000; i += 7)
+				container[i << 16] = i + round;
+		}
+		TS_ASSERT_EQUALS(container.size(), 5000u);
+
+		uint count = 0;
+		for (Common::FlatHashMap<uint, uint>::const_iterator i = container.begin(); i != container.end(); ++i) {
+			TS_ASSERT_EQUALS(i->_key & 0xffff, 0u);
+			count++;
+		}
+		TS_ASSERT_EQUALS(count, 5000u);
+
+		for (uint i = 0; i < 5000; i++) {
+			TS_ASSERT(container.contains(i << 16));
+			TS_ASSERT(!container.contains((i << 16) + 1));
+		}
+	}
+
+	void test_speed() {
+#if BENCHMARK_TIME
+		Common::install_null_g_system();
+
+#ifdef SLOW_TESTS
+		const uint numKeys = 100000, rounds = 50;
+#else
+		const uint numKeys = 10000, rounds = 5;
+#endif
+		// File names, as in the archive member maps
+		Common::Array<Common::String> keys, missingKeys;
+		for (uint i = 0; i < numKeys; i++) {
+			keys.push_back(Common::String::format("DATA%u/FILE%05u.BIN", i % 13, i));
+			missingKeys.push_back(Common::String::format("DATA%u/FILE%05u.DAT", i % 13, i));
+		}
+
+		debug("Time in milliseconds for %u keys, %u rounds:", numKeys, rounds);
+		debug("%-12s %8s %8s %8s %8s %8s", "", "insert", "find", "miss", "iterate", "erase");
+		benchmark<Common::HashMap<Common::String, uint, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> >("HashMap", keys, missingKeys, rounds);
+		benchmark<Common::FlatHashMap<Common::String, uint, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> >("FlatHashMap", keys, missingKeys, rounds);
+
+		Common::uninstall_null_g_system();
+#endif
+	}
+};
@@ -0,0 +1,106 @@
+#include <cxxtest/TestSuite.h>
+#include "test/instrset_detect.h"
+
+#include "graphics/pixelformat.h"
+
+#include "engines/director/director.h"
+
+/**
+ * Checks that the vectorized 32bpp ink kernels produce exactly the same
+ * pixels as the scalar ink code in graphics.cpp.
+ */
+class DirectorInkSIMDTestSuite : public CxxTest::TestSuite {
+	static const int kMaxWidth = 67;
+	static const int kRows = 64;
+
+	uint32 _seed;
+
+	uint32 nextRandom() {
+		_seed = _seed * 1103515245 + 12345;
+		return (_seed >> 16) | (_seed << 16);
+	}
+
+	// The scalar inks in graphics.cpp, with MacWindowManager::decomposeColor()
+	// and findBestColor() for 32bpp
+	static uint32 inkPixel(Director::InkType ink, int alpha, const Graphics::PixelFormat &format, uint32 dst, uint32 src) {
+		byte rSrc, gSrc, bSrc;
+		byte rDst, gDst, bDst;
+
+		format.colorToRGB(src, rSrc, gSrc, bSrc);
+		format.colorToRGB(dst, rDst, gDst, bDst);
+
+		return format.RGBToColor(Director::inkChannel(ink, alpha, rSrc, rDst), Director::inkChannel(ink, alpha, gSrc, gDst), Director::inkChannel(ink, alpha, bSrc, bDst));
+	}
+
+	void checkKernel(Director::InkSpanSIMDFunc func) {
+		static const Director::InkType inks[] = {
+			Director::kInkTypeAddPin, Director::kInkTypeAdd, Director::kInkTypeSubPin, Director::kInkTypeSub,
+			Director::kInkTypeLight, Director::kInkTypeDark
+		};
+		static const int blendAlphas[] = { 0, 1, 64, 127, 128, 200, 254, 255 };
+
+		// With and without an alpha channel, in different channel orders
+		const Graphics::PixelFormat formats[] = {
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0),
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 16, 8, 0, 24),
+			Graphics::PixelFormat(4, 8, 8, 8, 0, 16, 8, 0, 0),
+			Graphics::PixelFormat(4, 8, 8, 8, 0, 0, 8, 16, 0)
+		};
+
+		uint32 src[kMaxWidth], dst[kMaxWidth], orig[kMaxWidth], expected[kMaxWidth];
+		_seed = 12345;
+
+		for (int f = 0; f < ARRAYSIZE(formats); f++) {
+			uint32 rgbMask, alphaMask;
+			TS_ASSERT(Director::getInkSIMDMasks(formats[f], rgbMask, alphaMask));
+
+			for (int i = 0; i < ARRAYSIZE(inks) + ARRAYSIZE(blendAlphas); i++) {
+				Director::InkType ink = i < ARRAYSIZE(inks) ? inks[i] : Director::kInkTypeBlend;
+				int alpha = i < ARRAYSIZE(inks) ? 0 : blendAlphas[i - ARRAYSIZE(inks)];
+
+				for (int row = 0; row < kRows; row++) {
+					int width = 1 + nextRandom() % kMaxWidth;
+					for (int j = 0; j < width; j++) {
+						src[j] = nextRandom();
+						dst[j] = nextRandom();
+						// Also cover the extremes of each channel
+						if (row & 1)
+							src[j] = ((src[j] >> 7) & 0x01010101) * 0xff;
+						expected[j] = inkPixel(ink, alpha, formats[f], dst[j], src[j]);
+					}
+					for (int j = width; j < kMaxWidth; j++)
+						dst[j] = 0x5a5a5a5a;
+					memcpy(orig, dst, sizeof(dst));
+
+					// The pixels the kernel did not do are left for the scalar code
+					int done = func(ink, alpha, dst, src, width, rgbMask, alphaMask);
+					TS_ASSERT(done >= 0 && done <= width);
+					for (int j = done; j < kMaxWidth; j++)
+						expected[j] = orig[j];
+
+					for (int j = 0; j < kMaxWidth; j++) {
+						if (dst[j] != expected[j]) {
+							TS_FAIL(Common::String::format("ink %d, alpha %d, format %d: pixel %d is %08x, expected %08x",
+								ink, alpha, f, j, dst[j], expected[j]).c_str());
+							return;
+						}
+					}
+				}
+			}
+		}
+	}
+
+public:
+	void test_sse2_bit_exact() {
+#ifdef SCUMMVM_SSE2
+		if (instrset_detect() >= 2)
+			checkKernel(Director::inkBlitSpanSSE2);
+#endif
+	}
+
+	void test_neon_bit_exact() {
+#ifdef SCUMMVM_NEON
+		checkKernel(Director::inkBlitSpanNEON);
+#endif
+	}
+};
@@ -0,0 +1,91 @@
+#include <cxxtest/TestSuite.h>
+#include "test/instrset_detect.h"
+
+#include "engines/scumm/imuse_digi/dimuse_engine.h"
+#include "engines/scumm/imuse_digi/dimuse_internalmixer.h"
+
+/**
+ * Checks that the vectorized mix paths of the Digital iMUSE internal mixer
+ * produce exactly the same output as the regular, table based ones.
+ */
+class IMuseDigiInternalMixerTestSuite : public CxxTest::TestSuite {
+	typedef Scumm::IMuseDigiInternalMixer Mixer;
+
+	Mixer::MixBlockFunc getMixBlockFunc() {
+#ifdef SCUMMVM_NEON
+		return Mixer::mixBlockNEON;
+#endif
+#ifdef SCUMMVM_SSE2
+		if (instrset_detect() >= 2)
+			return Mixer::mixBlockSSE2;
+#endif
+		return nullptr;
+	}
+
+	void mixWith(Mixer::MixBlockFunc func, bool earlyDiMUSE, bool radioChatter, int outChannels,
+				 uint8 *src, int32 inFrameCount, int wordSize, int channelCount, int feedSize,
+				 int volume, int pan, bool ftIs11025Hz, uint16 *mixBuf, int mixBufSize) {
+		// The mix buffer starts with some garbage, to check that the mixers
+		// add to it and wrap around the same way
+		for (int i = 0; i < mixBufSize / 2; i++)
+			mixBuf[i] = i * 7919;
+
+		Mixer mixer(nullptr, 22050, false, true);
+		mixer.init(16, outChannels, (uint8 *)mixBuf, mixBufSize, 0, 5);
+		mixer._isEarlyDiMUSE = earlyDiMUSE;
+		mixer._mixBlockFunc = func;
+		if (radioChatter)
+			mixer.setRadioChatter();
+
+		mixer.mix(src, inFrameCount, wordSize, channelCount, feedSize, 0, volume, pan, ftIs11025Hz);
+	}
+
+public:
+	void test_mix_paths_bit_exact() {
+		Mixer::MixBlockFunc func = getMixBlockFunc();
+		if (!func)
+			return;
+
+		const int32 kFrames = 1037;
+		const int kMixBufSize = kFrames * 4 * 2 * 2 + 64;
+
+		uint8 *src = new uint8[kFrames * 4 + 8];
+		uint16 *expected = new uint16[kMixBufSize / 2];
+		uint16 *actual = new uint16[kMixBufSize / 2];
+
+		uint32 seed = 12345;
+		for (int i = 0; i < kFrames * 4 + 8; i++) {
+			seed = seed * 1103515245 + 12345;
+			src[i] = seed >> 16;
+		}
+
+		static const int wordSizes[] = { 8, 12, 16 };
+		static const int volumes[] = { 0, 1, 37, 64, 100, 127 };
+		static const int pans[] = { 0, 20, 64, 100, 127 };
+
+		for (int early = 0; early < 2; early++)
+		for (int radio = 0; radio < 2; radio++)
+		for (int outChannels = 1; outChannels <= 2; outChannels++)
+		for (int channels = 1; channels <= 2; channels++)
+		for (int w = 0; w < ARRAYSIZE(wordSizes); w++)
+		for (int rate = 0; rate < 3; rate++)
+		for (int v = 0; v < ARRAYSIZE(volumes); v++)
+		for (int p = 0; p < ARRAYSIZE(pans); p++) {
+			// Plain, doubled and halved sample rates
+			int32 inFrameCount = (rate == 2) ? kFrames - 1 : kFrames / 2 * 2;
+			int feedSize = (rate == 0) ? inFrameCount : (rate == 1 ? inFrameCount * 2 : inFrameCount / 2);
+			bool ftIs11025Hz = (rate == 1);
+
+			mixWith(nullptr, early, radio, outChannels, src, inFrameCount, wordSizes[w], channels, feedSize,
+					volumes[v], pans[p], ftIs11025Hz, expected, kMixBufSize);
+			mixWith(func, early, radio, outChannels, src, inFrameCount, wordSizes[w], channels, feedSize,
+					volumes[v], pans[p], ftIs11025Hz, actual, kMixBufSize);
+
+			TS_ASSERT_SAME_DATA(expected, actual, kMixBufSize);
+		}
+
+		delete[] src;
+		delete[] expected;
+		delete[] actual;
+	}
+};
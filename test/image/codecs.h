@@ -0,0 +1,714 @@
+#include <cxxtest/TestSuite.h>
+
+#if defined(HAVE_CONFIG_H)
+#include "config.h"
+#endif
+
+#include "common/array.h"
+#include "common/debug.h"
+#include "common/md5.h"
+#include "common/memstream.h"
+#include "common/str.h"
+#include "common/system.h"
+
+#include "graphics/pixelformat.h"
+#include "graphics/surface.h"
+
+#include "image/codecs/bmp_raw.h"
+#include "image/codecs/cinepak.h"
+#include "image/codecs/msrle.h"
+#include "image/codecs/msvideo1.h"
+#include "image/codecs/qtrle.h"
+#include "image/codecs/rpza.h"
+
+#include "video/flic_decoder.h"
+
+#include "../system/null_osystem.h"
+
+#if NULL_OSYSTEM_IS_AVAILABLE
+#define BENCHMARK_TIME 1
+#else
+#define BENCHMARK_TIME 0
+#endif
+
+/**
+ * Decodes synthetic streams through the Image::Codec and VideoDecoder
+ * interfaces. The streams are made of random but valid codes, built with
+ * the layout the decoders read, so that every code path of a codec is used.
+ * The hashes of the decoded frames catch changes in the output, and
+ * test_speed reports the throughput of each codec.
+ */
+class CodecTestSuite : public CxxTest::TestSuite {
+	typedef Common::Array<byte> Buffer;
+	typedef Common::Array<Buffer> Frames;
+
+	// The same numbers on every platform, unlike Common::RandomSource
+	class Random {
+	public:
+		Random(uint32 seed) : _state(seed) {}
+
+		uint32 next() {
+			_state = _state * 1103515245 + 12345;
+			return (_state >> 8) & 0xffffff;
+		}
+
+		uint getRandomNumber(uint max) { return next() % (max + 1); }
+		byte getByte() { return next() & 0xff; }
+
+	private:
+		uint32 _state;
+	};
+
+	static void writeByte(Buffer &buf, byte val) { buf.push_back(val); }
+	static void writeUint16BE(Buffer &buf, uint16 val) { buf.push_back(val >> 8); buf.push_back(val & 0xff); }
+	static void writeUint16LE(Buffer &buf, uint16 val) { buf.push_back(val & 0xff); buf.push_back(val >> 8); }
+	static void writeUint24BE(Buffer &buf, uint32 val) { buf.push_back((val >> 16) & 0xff); writeUint16BE(buf, val & 0xffff); }
+	static void writeUint32BE(Buffer &buf, uint32 val) { writeUint16BE(buf, val >> 16); writeUint16BE(buf, val & 0xffff); }
+	static void writeUint32LE(Buffer &buf, uint32 val) { writeUint16LE(buf, val & 0xffff); writeUint16LE(buf, val >> 16); }
+
+	static void setUint24BE(Buffer &buf, uint pos, uint32 val) {
+		buf[pos] = (val >> 16) & 0xff;
+		buf[pos + 1] = (val >> 8) & 0xff;
+		buf[pos + 2] = val & 0xff;
+	}
+
+	static void setUint32LE(Buffer &buf, uint pos, uint32 val) {
+		for (uint i = 0; i < 4; i++)
+			buf[pos + i] = (val >> (i * 8)) & 0xff;
+	}
+
+	/** Cinepak flags: 32-bit big endian words inserted in the data as they are needed */
+	class FlagWriter {
+	public:
+		FlagWriter(Buffer &buf) : _buf(buf), _pos(0), _bit(0) {}
+
+		void write(bool set) {
+			if (_bit == 0) {
+				_pos = _buf.size();
+				writeUint32BE(_buf, 0);
+				_bit = 32;
+			}
+			_bit--;
+			if (set)
+				_buf[_pos + 3 - _bit / 8] |= 1 << (_bit % 8);
+		}
+
+	private:
+		Buffer &_buf;
+		uint _pos;
+		uint _bit;
+	};
+
+	static void makeMSVideo1(Frames &frames, uint width, uint height, uint bitsPerPixel, uint count) {
+		Random rnd(1);
+		const uint totalBlocks = (width / 4) * (height / 4);
+
+		for (uint f = 0; f < count; f++) {
+			Buffer buf;
+			for (uint block = 0; block < totalBlocks; block++) {
+				uint type = rnd.getRandomNumber(f == 0 ? 2 : 3);
+				if (type == 3) {
+					// Skip, including the current block
+					uint skip = MIN<uint>(1 + rnd.getRandomNumber(7), totalBlocks - block);
+					writeByte(buf, skip);
+					writeByte(buf, 0x84);
+					block += skip - 1;
+				} else if (bitsPerPixel == 8) {
+					if (type == 0) {
+						// One color
+						writeByte(buf, rnd.getByte());
+						writeByte(buf, 0x80);
+					} else if (type == 1) {
+						// Two colors
+						writeUint16LE(buf, rnd.getRandomNumber(0x7fff));
+						writeByte(buf, rnd.getByte());
+						writeByte(buf, rnd.getByte());
+					} else {
+						// Eight colors
+						writeUint16LE(buf, 0x9000 + rnd.getRandomNumber(0x6fff));
+						for (uint i = 0; i < 8; i++)
+							writeByte(buf, rnd.getByte());
+					}
+				} else {
+					if (type == 0) {
+						writeByte(buf, rnd.getByte());
+						writeByte(buf, 0x88 + rnd.getRandomNumber(0x77));
+					} else if (type == 1) {
+						writeUint16LE(buf, rnd.getRandomNumber(0x7fff));
+						writeUint16LE(buf, rnd.getRandomNumber(0x7fff));
+						writeUint16LE(buf, rnd.getRandomNumber(0x7fff));
+					} else {
+						writeUint16LE(buf, rnd.getRandomNumber(0x7fff));
+						writeUint16LE(buf, 0x8000 | rnd.getRandomNumber(0x7fff));
+						for (uint i = 0; i < 7; i++)
+							writeUint16LE(buf, rnd.getRandomNumber(0x7fff));
+					}
+				}
+			}
+			writeUint16LE(buf, 0);
+			frames.push_back(buf);
+		}
+	}
+
+	static void makeMSRLE(Frames &frames, uint width, uint height, uint count) {
+		Random rnd(2);
+
+		for (uint f = 0; f < count; f++) {
+			Buffer buf;
+			for (uint y = 0; y < height; y++) {
+				uint x = 0;
+				while (x < width) {
+					uint left = width - x;
+					if (left >= 3 && rnd.getRandomNumber(1)) {
+						// Literal pixels, padded to a word
+						uint n = 3 + rnd.getRandomNumber(MIN<uint>(left, 64) - 3);
+						writeByte(buf, 0);
+						writeByte(buf, n);
+						for (uint i = 0; i < n; i++)
+							writeByte(buf, rnd.getByte());
+						if (n & 1)
+							writeByte(buf, 0);
+						x += n;
+					} else {
+						uint n = 1 + rnd.getRandomNumber(MIN<uint>(left, 64) - 1);
+						writeByte(buf, n);
+						writeByte(buf, rnd.getByte());
+						x += n;
+					}
+				}
+				// End of line, or end of image
+				writeByte(buf, 0);
+				writeByte(buf, y == height - 1 ? 1 : 0);
+			}
+			frames.push_back(buf);
+		}
+	}
+
+	static void writeQTRLEPixel(Buffer &buf, Random &rnd, uint bitsPerPixel) {
+		if (bitsPerPixel == 16)
+			writeUint16BE(buf, rnd.getRandomNumber(0x7fff));
+		else
+			for (uint i = 0; i < bitsPerPixel / 8; i++)
+				writeByte(buf, rnd.getByte());
+	}
+
+	static void makeQTRLE(Frames &frames, uint width, uint height, uint bitsPerPixel, uint count) {
+		Random rnd(3);
+
+		for (uint f = 0; f < count; f++) {
+			Buffer buf;
+			writeUint32BE(buf, 0);
+
+			// Later frames only update some of the lines
+			uint startLine = 0, lines = height;
+			if (f == 0) {
+				writeUint16BE(buf, 0);
+			} else {
+				startLine = rnd.getRandomNumber(height / 2);
+				lines = 1 + rnd.getRandomNumber(height - startLine - 1);
+				writeUint16BE(buf, 8);
+				writeUint16BE(buf, startLine);
+				writeUint16BE(buf, 0);
+				writeUint16BE(buf, lines);
+				writeUint16BE(buf, 0);
+			}
+
+			for (uint y = 0; y < lines; y++) {
+				uint x = 0;
+				writeByte(buf, 1);
+				while (x < width) {
+					uint left = width - x;
+					uint type = rnd.getRandomNumber(f == 0 ? 1 : 2);
+					if (type == 2) {
+						// Skip some pixels
+						uint n = rnd.getRandomNumber(MIN<uint>(left, 32));
+						writeByte(buf, 0);
+						writeByte(buf, n + 1);
+						x += n;
+					} else if (type == 1 && left >= 2) {
+						// Run of one pixel
+						uint n = 2 + rnd.getRandomNumber(MIN<uint>(left, 128) - 2);
+						writeByte(buf, (byte)-(int8)n);
+						writeQTRLEPixel(buf, rnd, bitsPerPixel);
+						x += n;
+					} else {
+						uint n = 1 + rnd.getRandomNumber(MIN<uint>(left, 32) - 1);
+						writeByte(buf, n);
+						for (uint i = 0; i < n; i++)
+							writeQTRLEPixel(buf, rnd, bitsPerPixel);
+						x += n;
+					}
+				}
+				writeByte(buf, 0xff);
+			}
+
+			buf[0] = buf.size() >> 24;
+			buf[1] = (buf.size() >> 16) & 0xff;
+			buf[2] = (buf.size() >> 8) & 0xff;
+			buf[3] = buf.size() & 0xff;
+			frames.push_back(buf);
+		}
+	}
+
+	static void makeRPZA(Frames &frames, uint width, uint height, uint count) {
+		Random rnd(4);
+		const uint totalBlocks = ((width + 3) / 4) * ((height + 3) / 4);
+
+		for (uint f = 0; f < count; f++) {
+			Buffer buf;
+			writeByte(buf, 0xe1);
+			writeUint24BE(buf, 0);
+
+			uint block = 0;
+			while (block < totalBlocks) {
+				uint n = 1 + rnd.getRandomNumber(MIN<uint>(totalBlocks - block, 32) - 1);
+				switch (rnd.getRandomNumber(f == 0 ? 3 : 4)) {
+				case 0:
+					// Fill with one color
+					writeByte(buf, 0xa0 | (n - 1));
+					writeUint16BE(buf, rnd.getRandomNumber(0x7fff));
+					break;
+				case 1:
+					// Four colors
+					writeByte(buf, 0xc0 | (n - 1));
+					writeUint16BE(buf, rnd.getRandomNumber(0x7fff));
+					writeUint16BE(buf, rnd.getRandomNumber(0x7fff));
+					for (uint i = 0; i < n * 4; i++)
+						writeByte(buf, rnd.getByte());
+					break;
+				case 2:
+					// Four colors, for a single block without opcode
+					n = 1;
+					writeUint16BE(buf, rnd.getRandomNumber(0x7fff));
+					writeUint16BE(buf, 0x8000 | rnd.getRandomNumber(0x7fff));
+					for (uint i = 0; i < 4; i++)
+						writeByte(buf, rnd.getByte());
+					break;
+				case 3:
+					// Sixteen colors
+					n = 1;
+					for (uint i = 0; i < 16; i++)
+						writeUint16BE(buf, rnd.getRandomNumber(0x7fff));
+					break;
+				default:
+					writeByte(buf, 0x80 | (n - 1));
+					break;
+				}
+				block += n;
+			}
+
+			setUint24BE(buf, 1, buf.size());
+			frames.push_back(buf);
+		}
+	}
+
+	static void makeCinepakCodebook(Buffer &buf, Random &rnd, byte chunkID) {
+		uint start = buf.size();
+		writeByte(buf, chunkID);
+		writeUint24BE(buf, 0);
+
+		FlagWriter flags(buf);
+		for (uint i = 0; i < 256; i++) {
+			if (chunkID & 1) {
+				bool update = rnd.getRandomNumber(3) == 0;
+				flags.write(update);
+				if (!update)
+					continue;
+			}
+			for (uint j = 0; j < ((chunkID & 4) ? 4U : 6U); j++)
+				writeByte(buf, rnd.getByte());
+		}
+
+		setUint24BE(buf, start + 1, buf.size() - start);
+	}
+
+	static void makeCinepak(Frames &frames, uint width, uint height, uint bitsPerPixel, uint count) {
+		Random rnd(5);
+		const uint strips = 2;
+
+		for (uint f = 0; f < count; f++) {
+			Buffer buf;
+			writeByte(buf, f == 0 ? 1 : 0);
+			writeUint24BE(buf, 0);
+			writeUint16BE(buf, width);
+			writeUint16BE(buf, height);
+			writeUint16BE(buf, strips);
+
+			for (uint s = 0; s < strips; s++) {
+				uint stripStart = buf.size();
+				uint stripHeight = height / strips;
+				writeUint16BE(buf, f == 0 ? 0x1000 : 0x1100);
+				writeUint16BE(buf, 0);
+				writeUint16BE(buf, 0);
+				writeUint16BE(buf, 0);
+				writeUint16BE(buf, stripHeight);
+				writeUint16BE(buf, width);
+
+				// Full codebooks first, then partial updates. Palettized
+				// codebooks have no chroma.
+				byte codebookID = (f == 0 ? 0x20 : 0x21) | (bitsPerPixel == 8 ? 0x04 : 0);
+				makeCinepakCodebook(buf, rnd, codebookID);
+				makeCinepakCodebook(buf, rnd, codebookID | 0x02);
+
+				// Intra vectors first, then inter vectors which may skip blocks
+				uint chunkStart = buf.size();
+				byte chunkID = f == 0 ? 0x30 : 0x31;
+				writeByte(buf, chunkID);
+				writeUint24BE(buf, 0);
+
+				FlagWriter flags(buf);
+				for (uint block = 0; block < (width / 4) * (stripHeight / 4); block++) {
+					if (chunkID & 1) {
+						bool coded = rnd.getRandomNumber(3) != 0;
+						flags.write(coded);
+						if (!coded)
+							continue;
+					}
+					bool v4 = rnd.getRandomNumber(1);
+					flags.write(v4);
+					for (uint i = 0; i < (v4 ? 4U : 1U); i++)
+						writeByte(buf, rnd.getByte());
+				}
+				setUint24BE(buf, chunkStart + 1, buf.size() - chunkStart);
+
+				buf[stripStart + 2] = (buf.size() - stripStart) >> 8;
+				buf[stripStart + 3] = (buf.size() - stripStart) & 0xff;
+			}
+
+			setUint24BE(buf, 1, buf.size());
+			frames.push_back(buf);
+		}
+	}
+
+	static void makeBitmapRaw(Frames &frames, uint width, uint height, uint bitsPerPixel, uint count) {
+		Random rnd(6);
+		const uint pitch = (width * bitsPerPixel / 8 + 3) & ~3;
+
+		for (uint f = 0; f < count; f++) {
+			Buffer buf;
+			for (uint i = 0; i < pitch * height; i++)
+				writeByte(buf, rnd.getByte());
+			frames.push_back(buf);
+		}
+	}
+
+	static void writeFlicChunk(Buffer &buf, uint16 type, const Buffer &data) {
+		writeUint32LE(buf, data.size() + 6);
+		writeUint16LE(buf, type);
+		buf.push_back(data);
+	}
+
+	/** A whole FLC file, as FlicDecoder reads files rather than frames */
+	static void makeFlic(Buffer &file, uint width, uint height, uint count) {
+		Random rnd(7);
+
+		writeUint32LE(file, 0);
+		writeUint16LE(file, 0xaf12);
+		writeUint16LE(file, count);
+		writeUint16LE(file, width);
+		writeUint16LE(file, height);
+		writeUint16LE(file, 8);
+		writeUint16LE(file, 0);
+		writeUint32LE(file, 70);
+		while (file.size() < 128)
+			writeByte(file, 0);
+
+		for (uint f = 0; f < count; f++) {
+			Buffer frame;
+			writeUint32LE(frame, 0);
+			writeUint16LE(frame, 0xf1fa);
+			writeUint16LE(frame, f == 0 ? 2 : 1);
+			for (uint i = 0; i < 4; i++)
+				writeUint16LE(frame, 0);
+
+			Buffer data;
+			if (f == 0) {
+				// The whole palette
+				writeUint16LE(data, 1);
+				writeUint16LE(data, 0);
+				for (uint i = 0; i < 256 * 3; i++)
+					writeByte(data, rnd.getByte());
+				writeFlicChunk(frame, 4, data);
+
+				// Byte runs for the whole picture
+				data.clear();
+				for (uint y = 0; y < height; y++) {
+					writeByte(data, 0);
+					uint x = 0;
+					while (x < width) {
+						uint n = 1 + rnd.getRandomNumber(MIN<uint>(width - x, 64) - 1);
+						if (rnd.getRandomNumber(1)) {
+							writeByte(data, n);
+							writeByte(data, rnd.getByte());
+						} else {
+							writeByte(data, (byte)-(int8)n);
+							for (uint i = 0; i < n; i++)
+								writeByte(data, rnd.getByte());
+						}
+						x += n;
+					}
+				}
+				writeFlicChunk(frame, 15, data);
+			} else {
+				// Word runs on some of the lines
+				uint lines = 0;
+				writeUint16LE(data, 0);
+				for (uint y = 0; y < height; y++) {
+					uint skip = 0;
+					while (y + skip + 1 < height && rnd.getRandomNumber(3) == 0)
+						skip++;
+					if (skip) {
+						writeUint16LE(data, (uint16)-(int16)skip);
+						y += skip;
+					}
+
+					Buffer packets;
+					uint packetCount = 0;
+					uint x = 0;
+					while (x + 2 <= width && rnd.getRandomNumber(7)) {
+						uint column = rnd.getRandomNumber(MIN<uint>(width - x - 2, 16));
+						x += column;
+						uint n = 1 + rnd.getRandomNumber(MIN<uint>((width - x) / 2, 32) - 1);
+						writeByte(packets, column);
+						if (rnd.getRandomNumber(1)) {
+							writeByte(packets, n);
+							for (uint i = 0; i < n * 2; i++)
+								writeByte(packets, rnd.getByte());
+						} else {
+							writeByte(packets, (byte)-(int8)n);
+							writeByte(packets, rnd.getByte());
+							writeByte(packets, rnd.getByte());
+						}
+						x += n * 2;
+						packetCount++;
+					}
+					writeUint16LE(data, packetCount);
+					data.push_back(packets);
+					lines++;
+				}
+				data[0] = lines & 0xff;
+				data[1] = lines >> 8;
+				writeFlicChunk(frame, 7, data);
+			}
+
+			setUint32LE(frame, 0, frame.size());
+			file.push_back(frame);
+		}
+
+		setUint32LE(file, 0, file.size());
+	}
+
+	/** Append the frame in a format independent of the platform */
+	static void appendSurface(Buffer &out, const Graphics::Surface &surface) {
+		for (int y = 0; y < surface.h; y++) {
+			for (int x = 0; x < surface.w; x++) {
+				uint32 pixel = surface.getPixel(x, y);
+				if (surface.format.isCLUT8()) {
+					out.push_back(pixel);
+				} else {
+					byte a, r, g, b;
+					surface.format.colorToARGB(pixel, a, r, g, b);
+					out.push_back(a);
+					out.push_back(r);
+					out.push_back(g);
+					out.push_back(b);
+				}
+			}
+		}
+	}
+
+	static Common::String hashBuffer(const Buffer &buf) {
+		Common::MemoryReadStream stream(buf.data(), buf.size());
+		return Common::computeStreamMD5AsString(stream);
+	}
+
+	static Common::String decodeFrames(Image::Codec &codec, const Frames &frames) {
+		Buffer out;
+		for (uint i = 0; i < frames.size(); i++) {
+			Common::MemoryReadStream stream(frames[i].data(), frames[i].size());
+			const Graphics::Surface *surface = codec.decodeFrame(stream);
+			TS_ASSERT(surface);
+			if (!surface)
+				return Common::String();
+			appendSurface(out, *surface);
+		}
+		return hashBuffer(out);
+	}
+
+	static Common::String decodeFlic(const Buffer &file) {
+		Video::FlicDecoder decoder;
+		if (!decoder.loadStream(new Common::MemoryReadStream(file.data(), file.size())))
+			return Common::String();
+
+		Buffer out;
+		while (!decoder.endOfVideo()) {
+			const Graphics::Surface *surface = decoder.decodeNextFrame();
+			if (!surface)
+				break;
+			appendSurface(out, *surface);
+		}
+		const byte *palette = decoder.getPalette();
+		for (uint i = 0; i < 256 * 3; i++)
+			out.push_back(palette[i]);
+		return hashBuffer(out);
+	}
+
+	enum {
+		kWidth = 64,
+		kHeight = 48,
+		kFrames = 4
+	};
+
+public:
+	void test_msvideo1() {
+		Frames frames8, frames16;
+		makeMSVideo1(frames8, kWidth, kHeight, 8, kFrames);
+		makeMSVideo1(frames16, kWidth, kHeight, 16, kFrames);
+
+		Image::MSVideo1Decoder codec8(kWidth, kHeight, 8);
+		TS_ASSERT_EQUALS(decodeFrames(codec8, frames8), "8e617d67c74560efa0855b6b40053b51");
+		Image::MSVideo1Decoder codec16(kWidth, kHeight, 16);
+		TS_ASSERT_EQUALS(decodeFrames(codec16, frames16), "6257d611d690297ab547bde35b2dd8cd");
+	}
+
+	void test_msrle() {
+		Frames frames;
+		makeMSRLE(frames, kWidth, kHeight, kFrames);
+
+		Image::MSRLEDecoder codec(kWidth, kHeight, 8);
+		TS_ASSERT_EQUALS(decodeFrames(codec, frames), "0ddc97bac20061e1d9223edd262b9301");
+	}
+
+	void test_qtrle() {
+		static const uint bitsPerPixel[3] = { 16, 24, 32 };
+		static const char *const hashes[3] = {
+			"723dec2fc77433f1d064bbc16ef22313",
+			"a6716222aba0ea2d52c53f1c50dded22",
+			"0746842cc7e78b88bc33c9f89c448964"
+		};
+
+		for (uint i = 0; i < 3; i++) {
+			Frames frames;
+			makeQTRLE(frames, kWidth, kHeight, bitsPerPixel[i], kFrames);
+
+			Image::QTRLEDecoder codec(kWidth, kHeight, bitsPerPixel[i]);
+			TS_ASSERT_EQUALS(decodeFrames(codec, frames), hashes[i]);
+		}
+	}
+
+	void test_rpza() {
+		Frames frames;
+		makeRPZA(frames, kWidth, kHeight, kFrames);
+
+		Image::RPZADecoder codec(kWidth, kHeight);
+		TS_ASSERT_EQUALS(decodeFrames(codec, frames), "2063f53c1df02775c5eb599226bda4dd");
+	}
+
+	void test_cinepak() {
+		// Only the palettized variant, the default output format of the
+		// others comes from the screen, which the test system does not have
+		Frames frames;
+		makeCinepak(frames, kWidth, kHeight, 8, kFrames);
+
+		Image::CinepakDecoder codec(8);
+		TS_ASSERT_EQUALS(decodeFrames(codec, frames), "5527bb3bd6b040932faf114c5ba529ca");
+	}
+
+	void test_bitmap_raw() {
+		Frames frames;
+		makeBitmapRaw(frames, kWidth - 2, kHeight, 24, kFrames);
+
+		Image::BitmapRawDecoder codec(kWidth - 2, kHeight, 24, false);
+		TS_ASSERT_EQUALS(decodeFrames(codec, frames), "7df8d4c41a86e64ec78ee98296dcfbf1");
+	}
+
+	void test_flic() {
+		Buffer file;
+		makeFlic(file, kWidth, kHeight, kFrames);
+		TS_ASSERT_EQUALS(decodeFlic(file), "cf4bd5448bb62a00cdd25e40ae08ff42");
+	}
+
+private:
+	struct Benchmark {
+		const char *name;
+		Image::Codec *codec;
+		Frames frames;
+	};
+
+	static void reportSpeed(const char *name, const Graphics::PixelFormat &format, uint frames, uint32 bytes, uint32 time) {
+		time = MAX<uint32>(time, 1);
+		debug("%-16s %-14s %8u frames/s %8u KB/s", name, format.toString().c_str(),
+		      (uint)((uint64)frames * 1000 / time), (uint)((uint64)bytes * 1000 / 1024 / time));
+	}
+
+public:
+	void test_speed() {
+#if BENCHMARK_TIME
+		Common::install_null_g_system();
+
+		const uint width = 640, height = 480;
+#ifdef SLOW_TESTS
+		const uint numFrames = 300;
+#else
+		const uint numFrames = 10;
+#endif
+
+		Common::Array<Benchmark> benchmarks;
+		benchmarks.resize(9);
+		benchmarks[0].name = "MSVideo1 8";
+		benchmarks[0].codec = new Image::MSVideo1Decoder(width, height, 8);
+		makeMSVideo1(benchmarks[0].frames, width, height, 8, numFrames);
+		benchmarks[1].name = "MSVideo1 16";
+		benchmarks[1].codec = new Image::MSVideo1Decoder(width, height, 16);
+		makeMSVideo1(benchmarks[1].frames, width, height, 16, numFrames);
+		benchmarks[2].name = "MSRLE";
+		benchmarks[2].codec = new Image::MSRLEDecoder(width, height, 8);
+		makeMSRLE(benchmarks[2].frames, width, height, numFrames);
+		benchmarks[3].name = "QTRLE 16";
+		benchmarks[3].codec = new Image::QTRLEDecoder(width, height, 16);
+		makeQTRLE(benchmarks[3].frames, width, height, 16, numFrames);
+		benchmarks[4].name = "QTRLE 32";
+		benchmarks[4].codec = new Image::QTRLEDecoder(width, height, 32);
+		makeQTRLE(benchmarks[4].frames, width, height, 32, numFrames);
+		benchmarks[5].name = "RPZA";
+		benchmarks[5].codec = new Image::RPZADecoder(width, height);
+		makeRPZA(benchmarks[5].frames, width, height, numFrames);
+		benchmarks[6].name = "Cinepak 8";
+		benchmarks[6].codec = new Image::CinepakDecoder(8);
+		makeCinepak(benchmarks[6].frames, width, height, 8, numFrames);
+		benchmarks[7].name = "Bitmap raw 24";
+		benchmarks[7].codec = new Image::BitmapRawDecoder(width, height, 24, false);
+		makeBitmapRaw(benchmarks[7].frames, width, height, 24, numFrames);
+		benchmarks[8].name = "Bitmap raw 32";
+		benchmarks[8].codec = new Image::BitmapRawDecoder(width, height, 32, false);
+		makeBitmapRaw(benchmarks[8].frames, width, height, 32, numFrames);
+
+		debug("Codecs, decoding %u frames of %ux%u:", numFrames, width, height);
+		for (uint i = 0; i < benchmarks.size(); i++) {
+			const Frames &frames = benchmarks[i].frames;
+			uint32 bytes = 0;
+			uint32 start = g_system->getMillis();
+			for (uint f = 0; f < frames.size(); f++) {
+				Common::MemoryReadStream stream(frames[f].data(), frames[f].size());
+				benchmarks[i].codec->decodeFrame(stream);
+				bytes += frames[f].size();
+			}
+			uint32 time = g_system->getMillis() - start;
+			reportSpeed(benchmarks[i].name, benchmarks[i].codec->getPixelFormat(), frames.size(), bytes, time);
+			delete benchmarks[i].codec;
+		}
+
+		Buffer file;
+		makeFlic(file, width, height, numFrames);
+		Video::FlicDecoder flic;
+		flic.loadStream(new Common::MemoryReadStream(file.data(), file.size()));
+		uint32 start = g_system->getMillis();
+		while (!flic.endOfVideo() && flic.decodeNextFrame()) {
+		}
+		reportSpeed("FLIC", flic.getPixelFormat(), numFrames, file.size(), g_system->getMillis() - start);
+		flic.close();
+
+		Common::uninstall_null_g_system();
+#endif
+	}
+};
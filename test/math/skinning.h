@@ -0,0 +1,101 @@
+#include <cxxtest/TestSuite.h>
+#include "test/instrset_detect.h"
+
+#include "math/quat.h"
+#include "math/skinning.h"
+
+class SkinningTestSuite : public CxxTest::TestSuite {
+	// Two vertices per corner of a quad, as along a texture seam
+	static const int kNumVertices = 8;
+
+	Math::Vector3d _positions[kNumVertices];
+	Math::Vector3d _normals[kNumVertices];
+	Math::Matrix4 _bones[2];
+
+	void setupMesh(Math::SkinnedMesh &mesh) {
+		for (int i = 0; i < kNumVertices; i++) {
+			_positions[i].set((i / 2) % 2, (i / 4), 0.5f);
+			_normals[i].set(0.0f, 0.0f, 1.0f);
+		}
+		mesh.setVertices(_positions[0].getData(), _normals[0].getData(), kNumVertices, sizeof(Math::Vector3d));
+		for (int i = 0; i < kNumVertices; i++) {
+			float weight = _positions[i].x() * 0.5f + 0.25f;
+			mesh.addInfluence(i, 0, weight);
+			mesh.addInfluence(i, 1, 1.0f - weight);
+		}
+		mesh.finalize();
+
+		_bones[0] = Math::Quaternion::zAxis(30).toMatrix();
+		_bones[0].setPosition(Math::Vector3d(1.0f, 2.0f, 3.0f));
+		_bones[1] = Math::Quaternion::xAxis(-45).toMatrix();
+		_bones[1].setPosition(Math::Vector3d(-1.0f, 0.0f, 0.5f));
+	}
+
+	void checkSkinned(const Math::Vector3d *positions, const Math::Vector3d *normals) {
+		for (int i = 0; i < kNumVertices; i++) {
+			float weight = _positions[i].x() * 0.5f + 0.25f;
+			Math::Vector3d p0 = _positions[i], p1 = _positions[i];
+			_bones[0].transform(&p0, true);
+			_bones[1].transform(&p1, true);
+			Math::Vector3d p = p0 * weight + p1 * (1.0f - weight);
+
+			Math::Vector3d n0 = _normals[i], n1 = _normals[i];
+			_bones[0].transform(&n0, false);
+			_bones[1].transform(&n1, false);
+			Math::Vector3d n = n0 * weight + n1 * (1.0f - weight);
+			n.normalize();
+
+			TS_ASSERT((positions[i] - p).getMagnitude() < 0.0001f);
+			TS_ASSERT((normals[i] - n).getMagnitude() < 0.0001f);
+		}
+	}
+
+public:
+	void test_merge() {
+		Math::SkinnedMesh mesh;
+		setupMesh(mesh);
+		TS_ASSERT_EQUALS(mesh.getVertexCount(), (uint)kNumVertices);
+		TS_ASSERT_EQUALS(mesh.getUniqueVertexCount(), (uint)kNumVertices / 2);
+	}
+
+	void test_skinGeneric() {
+		Math::SkinnedMesh mesh;
+		setupMesh(mesh);
+
+		Math::SkinnedMesh::skinFunc = Math::SkinnedMesh::skinGeneric;
+		Math::Vector3d positions[kNumVertices], normals[kNumVertices];
+		mesh.skin(_bones, 2, positions[0].getData(), normals[0].getData(), sizeof(Math::Vector3d));
+		checkSkinned(positions, normals);
+	}
+
+	void test_skinSIMD() {
+		Math::SkinnedMesh mesh;
+		setupMesh(mesh);
+
+		Math::SkinnedMesh::skinFunc = Math::SkinnedMesh::skinGeneric;
+#ifdef SCUMMVM_NEON
+		Math::SkinnedMesh::skinFunc = Math::SkinnedMesh::skinNEON;
+#endif
+#ifdef SCUMMVM_SSE2
+		if (instrset_detect() >= 2) {
+			Math::SkinnedMesh::skinFunc = Math::SkinnedMesh::skinSSE2;
+		}
+#endif
+		Math::Vector3d positions[kNumVertices], normals[kNumVertices];
+		mesh.skin(_bones, 2, positions[0].getData(), normals[0].getData(), sizeof(Math::Vector3d));
+		checkSkinned(positions, normals);
+	}
+
+	void test_skinRange() {
+		Math::SkinnedMesh mesh;
+		setupMesh(mesh);
+
+		Math::SkinnedMesh::skinFunc = Math::SkinnedMesh::skinGeneric;
+		Math::Vector3d positions[kNumVertices], normals[kNumVertices];
+		mesh.update(_bones, 2);
+		mesh.skinRange(2, mesh.getUniqueVertexCount());
+		mesh.skinRange(0, 2);
+		mesh.write(positions[0].getData(), normals[0].getData(), sizeof(Math::Vector3d));
+		checkSkinned(positions, normals);
+	}
+};